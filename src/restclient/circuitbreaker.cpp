@@ -0,0 +1,125 @@
+#include "circuitbreaker.h"
+#include "circuitbreaker_p.h"
+#include "restreply_p.h"
+
+#include <QtNetwork/QNetworkAccessManager>
+using namespace QtRestClient;
+using namespace std::chrono;
+
+Q_LOGGING_CATEGORY(QtRestClient::logCircuit, "qt.restclient.CircuitBreaker")
+
+// ------------- Private Implementation -------------
+
+CircuitBreaker::CircuitBreaker(CircuitBreakerSettings settings) :
+	_settings{std::move(settings)}
+{
+	_clock.start();
+}
+
+QString CircuitBreaker::circuit(const QNetworkRequest &request) const
+{
+	if (!request.attribute(RestReplyPrivate::RouteAttribute).isValid())
+		return {};
+	return RestReplyPrivate::routeKey(request, _settings.scope == CircuitBreakerSettings::Scope::Route);
+}
+
+bool CircuitBreaker::tryAcquire(const QString &circuit)
+{
+	QMutexLocker _{&_mutex};
+	auto &current = _circuits[circuit];
+	switch (current.state) {
+	case State::Closed:
+		return true;
+	case State::Open:
+		if (!current.openUntil.hasExpired())
+			return false;
+		qCDebug(logCircuit) << "Letting trial requests through circuit" << circuit;
+		current.state = State::HalfOpen;
+		current.trials = 0;
+		current.successes = 0;
+		Q_FALLTHROUGH();
+	case State::HalfOpen:
+		if (current.trials >= _settings.trialReplies) {
+			if (!current.trialsUntil.hasExpired())
+				return false;
+			current.trials = 0;
+		}
+		++current.trials;
+		current.trialsUntil.setRemainingTime(_settings.openDuration);
+		return true;
+	default:
+		Q_UNREACHABLE();
+	}
+}
+
+void CircuitBreaker::release(const QString &circuit, Outcome outcome, milliseconds latency)
+{
+	QMutexLocker _{&_mutex};
+	const auto it = _circuits.find(circuit);
+	if (it == _circuits.end())
+		return;
+
+	auto &current = *it;
+	const auto failed = outcome == Outcome::Failure;
+	const auto slow = outcome == Outcome::Success &&
+					  _settings.slowReplyThreshold.count() >= 0 &&
+					  latency >= _settings.slowReplyThreshold;
+	switch (current.state) {
+	case State::Closed: {
+		if (outcome == Outcome::Canceled)
+			break;
+		const auto now = _clock.elapsed();
+		current.samples.push_back({now, failed, slow});
+		current.failures += failed;
+		current.slowReplies += slow;
+		while (now - current.samples.front().time > _settings.window.count()) {
+			current.failures -= current.samples.front().failed;
+			current.slowReplies -= current.samples.front().slow;
+			current.samples.pop_front();
+		}
+
+		const auto count = static_cast<double>(current.samples.size());
+		if (count >= _settings.minimumReplies &&
+			(current.failures >= _settings.failureRatio * count ||
+			 (_settings.slowReplyThreshold.count() >= 0 && current.slowReplies >= _settings.slowReplyRatio * count)))
+			open(circuit, current);
+		break;
+	}
+	case State::HalfOpen:
+		if (current.trials > 0)
+			--current.trials;
+		if (outcome == Outcome::Canceled)
+			break;
+		if (failed || slow)
+			open(circuit, current);
+		else if (++current.successes >= _settings.trialReplies) {
+			qCInfo(logCircuit) << "Closing circuit" << circuit << "after successful trial requests";
+			current = Circuit{};
+		}
+		break;
+	case State::Open:
+		// replies that were sent before the circuit opened do not change it anymore
+		break;
+	default:
+		Q_UNREACHABLE();
+	}
+}
+
+void CircuitBreaker::open(const QString &key, Circuit &circuit)
+{
+	qCWarning(logCircuit) << "Opening circuit" << key
+						  << "for" << _settings.openDuration.count() << "milliseconds";
+	circuit = Circuit{};
+	circuit.state = State::Open;
+	circuit.openUntil.setRemainingTime(_settings.openDuration);
+}
+
+
+
+RejectedNetworkReply::RejectedNetworkReply(QNetworkAccessManager *nam, const QNetworkRequest &request, const QByteArray &verb, const QString &circuit) :
+	FailedNetworkReply{nam,
+					   request,
+					   verb,
+					   QNetworkReply::ServiceUnavailableError,
+					   QStringLiteral("The request was not sent, as the circuit %1 is open").arg(circuit)}
+{}
@@ -0,0 +1,42 @@
+#ifndef QTRESTCLIENT_CIRCUITBREAKER_H
+#define QTRESTCLIENT_CIRCUITBREAKER_H
+
+#include "QtRestClient/qtrestclient_global.h"
+
+#include <chrono>
+#include <optional>
+
+namespace QtRestClient {
+
+//! The settings of the circuit breaker of a RestClient
+struct Q_RESTCLIENT_EXPORT CircuitBreakerSettings
+{
+	//! Specifies which requests share a circuit
+	enum class Scope {
+		Host,  //!< All requests to the same host and port
+		Route  //!< All requests to the same host and port, that were created by the same RestClass
+	};
+
+	//! Specifies which requests share a circuit
+	Scope scope = Scope::Host;
+	//! How long a reply counts for the statistics of its circuit
+	std::chrono::milliseconds window {std::chrono::seconds{30}};
+	//! The number of replies within the window, before a circuit can open
+	int minimumReplies = 10;
+	//! The share of failed replies within the window that opens a circuit
+	double failureRatio = 0.5;
+	//! The latency from which on replies count as slow, negative to ignore the latency
+	std::chrono::milliseconds slowReplyThreshold {-1};
+	//! The share of slow replies within the window that opens a circuit
+	double slowReplyRatio = 0.8;
+	//! How long an open circuit rejects requests, before it lets trial requests through
+	std::chrono::milliseconds openDuration {std::chrono::seconds{30}};
+	//! The number of successful trial replies that close a half open circuit again
+	int trialReplies = 1;
+};
+
+}
+
+Q_DECLARE_METATYPE(std::optional<QtRestClient::CircuitBreakerSettings>)
+
+#endif // QTRESTCLIENT_CIRCUITBREAKER_H
@@ -0,0 +1,84 @@
+#ifndef QTRESTCLIENT_CIRCUITBREAKER_P_H
+#define QTRESTCLIENT_CIRCUITBREAKER_P_H
+
+#include "circuitbreaker.h"
+#include "endpointselector_p.h"
+#include "failednetworkreply_p.h"
+
+#include <deque>
+
+#include <QtCore/QDeadlineTimer>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QPointer>
+#include <QtCore/QLoggingCategory>
+
+#include <QtNetwork/QNetworkReply>
+
+namespace QtRestClient {
+
+// the circuits of a client, each with the statistics of its recent replies
+class Q_RESTCLIENT_EXPORT CircuitBreaker
+{
+	Q_DISABLE_COPY(CircuitBreaker)
+public:
+	using Outcome = EndpointPool::Outcome;
+
+	enum class State {
+		Closed,
+		Open,
+		HalfOpen
+	};
+
+	explicit CircuitBreaker(CircuitBreakerSettings settings);
+
+	// returns the circuit of a request, empty if the request is not guarded
+	QString circuit(const QNetworkRequest &request) const;
+	// checks whether a request may be sent and reserves a trial in half open circuits
+	bool tryAcquire(const QString &circuit);
+	void release(const QString &circuit, Outcome outcome, std::chrono::milliseconds latency);
+
+private:
+	struct Sample {
+		qint64 time;
+		bool failed;
+		bool slow;
+	};
+
+	struct Circuit {
+		State state = State::Closed;
+		std::deque<Sample> samples;
+		int failures = 0;
+		int slowReplies = 0;
+		QDeadlineTimer openUntil;
+		int trials = 0;
+		int successes = 0;
+		// trials that are never evaluated give their slot free after this
+		QDeadlineTimer trialsUntil;
+	};
+
+	const CircuitBreakerSettings _settings;
+	QElapsedTimer _clock;
+	mutable QMutex _mutex;
+	QHash<QString, Circuit> _circuits;
+
+	void open(const QString &key, Circuit &circuit);
+};
+
+// stands in for the network reply of a request that was rejected by an open circuit
+class Q_RESTCLIENT_EXPORT RejectedNetworkReply : public FailedNetworkReply
+{
+	Q_OBJECT
+public:
+	RejectedNetworkReply(QNetworkAccessManager *nam,
+						 const QNetworkRequest &request,
+						 const QByteArray &verb,
+						 const QString &circuit);
+};
+
+Q_DECLARE_LOGGING_CATEGORY(logCircuit)
+
+}
+
+#endif // QTRESTCLIENT_CIRCUITBREAKER_P_H
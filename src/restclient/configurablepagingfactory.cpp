@@ -0,0 +1,354 @@
+#include "configurablepagingfactory.h"
+#include "configurablepagingfactory_p.h"
+#include "qtrestclient_helpertypes.h"
+using namespace QtRestClient;
+
+#ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
+#include <QtJsonSerializer/SerializerBase>
+#include <QtJsonSerializer/Exception>
+using namespace QtJsonSerializer;
+#endif
+
+Q_LOGGING_CATEGORY(QtRestClient::logConfigurablePaging, "qt.restclient.ConfigurablePagingFactory")
+
+namespace {
+
+std::optional<qint64> toInteger(const QCborValue &value)
+{
+	if (value.isInteger())
+		return value.toInteger();
+	else if (value.isDouble())
+		return static_cast<qint64>(value.toDouble());
+	else if (value.isString()) {
+		auto ok = false;
+		const auto result = value.toString().toLongLong(&ok);
+		if (ok)
+			return result;
+	}
+	return std::nullopt;
+}
+
+std::optional<qint64> toInteger(const QJsonValue &value)
+{
+	if (value.isDouble())
+		return static_cast<qint64>(value.toDouble());
+	else if (value.isString()) {
+		auto ok = false;
+		const auto result = value.toString().toLongLong(&ok);
+		if (ok)
+			return result;
+	}
+	return std::nullopt;
+}
+
+std::optional<QUrl> toUrl(const QCborValue &value)
+{
+	if (value.isString()) {
+		QUrl url{value.toString()};
+		if (url.isValid())
+			return url;
+		else
+			return std::nullopt;
+	} else
+		return StandardPagingFactory::extractUrl(value);
+}
+
+std::optional<QUrl> toUrl(const QJsonValue &value)
+{
+	return StandardPagingFactory::extractUrl(value);
+}
+
+}
+
+ConfigurablePagingFactory::ConfigurablePagingFactory() :
+	  d{new ConfigurablePagingFactoryPrivate{}}
+{
+	setPath(Field::Items, QStringLiteral("/items"));
+	setPath(Field::Total, QStringLiteral("/total"));
+	setPath(Field::Offset, QStringLiteral("/offset"));
+	setPath(Field::Next, QStringLiteral("/next"));
+	setPath(Field::Previous, QStringLiteral("/previous"));
+	setPath(Field::Cursor, QStringLiteral("/cursor"));
+	setPath(Field::NextCursor, QStringLiteral("/nextCursor"));
+}
+
+ConfigurablePagingFactory::~ConfigurablePagingFactory() = default;
+
+QString ConfigurablePagingFactory::path(Field field) const
+{
+	return d->path(field).path;
+}
+
+ConfigurablePagingFactory &ConfigurablePagingFactory::setPath(Field field, const QString &jsonPointer)
+{
+	d->paths[static_cast<int>(field)] = ConfigurablePagingFactoryPrivate::compile(jsonPointer);
+	return *this;
+}
+
+bool ConfigurablePagingFactory::useLinkHeader() const
+{
+	return d->useLinkHeader;
+}
+
+ConfigurablePagingFactory &ConfigurablePagingFactory::setUseLinkHeader(bool useLinkHeader)
+{
+	d->useLinkHeader = useLinkHeader;
+	return *this;
+}
+
+#ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
+IPaging *ConfigurablePagingFactory::createPaging(SerializerBase *serializer, const std::variant<QCborValue, QJsonValue> &data) const
+{
+	return createPagingWithHeaders(serializer, data, {}, {});
+}
+
+IPaging *ConfigurablePagingFactory::createPagingWithHeaders(SerializerBase *, const std::variant<QCborValue, QJsonValue> &data, const HeaderHash &headers, const QUrl &requestUrl) const
+#else
+IPaging *ConfigurablePagingFactory::createPaging(const std::variant<QCborValue, QJsonValue> &data) const
+{
+	return createPagingWithHeaders(data, {}, {});
+}
+
+IPaging *ConfigurablePagingFactory::createPagingWithHeaders(const std::variant<QCborValue, QJsonValue> &data, const HeaderHash &headers, const QUrl &requestUrl) const
+#endif
+{
+	return std::visit(__private::overload {
+						  [&](const QCborValue &value) -> IPaging* {
+							  return d->create<ConfigurableCborPaging>(value, headers, requestUrl);
+						  },
+						  [&](const QJsonValue &value) -> IPaging* {
+							  return d->create<ConfigurableJsonPaging>(value, headers, requestUrl);
+						  }
+					  }, data);
+}
+
+QHash<QString, QUrl> ConfigurablePagingFactory::parseLinkHeader(const QByteArray &headerValue, const QUrl &baseUrl)
+{
+	const auto isSpace = [](char c) {
+		return c == ' ' || c == '\t';
+	};
+
+	QHash<QString, QUrl> links;
+	const auto size = headerValue.size();
+	auto pos = 0;
+	while (pos < size) {
+		// each link is "<uri-reference>; param=value; param="quoted value""
+		const auto uriBegin = headerValue.indexOf('<', pos);
+		if (uriBegin < 0)
+			break;
+		const auto uriEnd = headerValue.indexOf('>', uriBegin + 1);
+		if (uriEnd < 0)
+			break;
+		QUrl url{QString::fromUtf8(headerValue.mid(uriBegin + 1, uriEnd - uriBegin - 1).trimmed())};
+		if (url.isRelative() && baseUrl.isValid())
+			url = baseUrl.resolved(url);
+		pos = uriEnd + 1;
+
+		QStringList relations;
+		while (pos < size && headerValue[pos] != ',') {
+			if (headerValue[pos] == ';' || isSpace(headerValue[pos])) {
+				++pos;
+				continue;
+			}
+
+			auto nameEnd = pos;
+			while (nameEnd < size && headerValue[nameEnd] != '=' && headerValue[nameEnd] != ';' && headerValue[nameEnd] != ',')
+				++nameEnd;
+			const auto name = headerValue.mid(pos, nameEnd - pos).trimmed().toLower();
+			pos = nameEnd;
+
+			QByteArray value;
+			if (pos < size && headerValue[pos] == '=') {
+				++pos;
+				while (pos < size && isSpace(headerValue[pos]))
+					++pos;
+				if (pos < size && headerValue[pos] == '"') {
+					++pos;
+					while (pos < size && headerValue[pos] != '"') {
+						if (headerValue[pos] == '\\' && pos + 1 < size)
+							++pos;
+						value.append(headerValue[pos++]);
+					}
+					++pos;
+				} else {
+					auto valueEnd = pos;
+					while (valueEnd < size && headerValue[valueEnd] != ';' && headerValue[valueEnd] != ',')
+						++valueEnd;
+					value = headerValue.mid(pos, valueEnd - pos).trimmed();
+					pos = valueEnd;
+				}
+			}
+
+			// rel may contain multiple, space separated relation types
+			if (name == "rel") {
+				for (const auto &relation : QString::fromUtf8(value).toLower().split(QLatin1Char(' '))) {
+					if (!relation.isEmpty())
+						relations.append(relation);
+				}
+			}
+		}
+
+		for (const auto &relation : qAsConst(relations)) {
+			if (!links.contains(relation))
+				links.insert(relation, url);
+		}
+	}
+	return links;
+}
+
+// ------------- Private Implementation -------------
+
+ConfigurablePagingFactoryPrivate::CompiledPath ConfigurablePagingFactoryPrivate::compile(const QString &path)
+{
+	CompiledPath compiled;
+	compiled.path = path;
+	if (path.isNull())
+		return compiled;
+	compiled.enabled = true;
+	if (path.isEmpty())
+		return compiled;
+
+	// JSON pointers (RFC 6901) start with a slash, everything else is treated as dotted path
+	QStringList segments;
+	if (path.startsWith(QLatin1Char('/'))) {
+		segments = path.mid(1).split(QLatin1Char('/'));
+		for (auto &segment : segments) {
+			segment.replace(QStringLiteral("~1"), QStringLiteral("/"));
+			segment.replace(QStringLiteral("~0"), QStringLiteral("~"));
+		}
+	} else
+		segments = path.split(QLatin1Char('.'));
+
+	compiled.tokens.reserve(segments.size());
+	for (const auto &segment : qAsConst(segments)) {
+		PathToken token;
+		token.key = segment;
+		auto ok = false;
+		const auto index = segment.toLongLong(&ok);
+		if (ok && index >= 0)
+			token.index = index;
+		compiled.tokens.append(token);
+	}
+	return compiled;
+}
+
+QCborValue ConfigurablePagingFactoryPrivate::resolve(const CompiledPath &path, const QCborValue &root)
+{
+	if (!path.enabled)
+		return QCborValue{QCborValue::Undefined};
+
+	auto value = root;
+	for (const auto &token : path.tokens) {
+		if (value.isMap())
+			value = value.toMap().value(token.key);
+		else if (value.isArray() && token.index >= 0)
+			value = value.toArray().at(token.index);
+		else
+			return QCborValue{QCborValue::Undefined};
+	}
+	return value;
+}
+
+QJsonValue ConfigurablePagingFactoryPrivate::resolve(const CompiledPath &path, const QJsonValue &root)
+{
+	if (!path.enabled)
+		return QJsonValue{QJsonValue::Undefined};
+
+	auto value = root;
+	for (const auto &token : path.tokens) {
+		if (value.isObject())
+			value = value.toObject().value(token.key);
+		else if (value.isArray() && token.index >= 0)
+			value = value.toArray().at(static_cast<int>(token.index));
+		else
+			return QJsonValue{QJsonValue::Undefined};
+	}
+	return value;
+}
+
+const ConfigurablePagingFactoryPrivate::CompiledPath &ConfigurablePagingFactoryPrivate::path(Field field) const
+{
+	return paths[static_cast<int>(field)];
+}
+
+template <typename TPaging, typename TValue>
+TPaging *ConfigurablePagingFactoryPrivate::create(const TValue &value, const HeaderHash &headers, const QUrl &requestUrl) const
+{
+	QScopedPointer<TPaging> paging{new TPaging{}};
+	paging->_data = value;
+
+	if (const auto &itemsPath = path(Field::Items); itemsPath.enabled) {
+		const auto items = resolve(itemsPath, value);
+		if (!items.isArray()) {
+#ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
+			throw DeserializationException{"Paging items at " + itemsPath.path.toUtf8() + " are not an array"};
+#else
+			qCWarning(logConfigurablePaging) << "Paging items at" << itemsPath.path << "are not an array";
+#endif
+		}
+		paging->_items = items.toArray();
+	}
+
+	if (const auto total = toInteger(resolve(path(Field::Total), value)); total)
+		paging->_total = *total;
+	if (const auto offset = toInteger(resolve(path(Field::Offset), value)); offset)
+		paging->_offset = *offset;
+	if (const auto url = toUrl(resolve(path(Field::Next), value)); url)
+		paging->_next = *url;
+	if (const auto url = toUrl(resolve(path(Field::Previous), value)); url)
+		paging->_prev = *url;
+	paging->_cursor = StandardPagingFactory::extractCursor(resolve(path(Field::Cursor), value));
+	paging->_nextCursor = StandardPagingFactory::extractCursor(resolve(path(Field::NextCursor), value));
+
+	// links in the body take precedence over the ones from the headers
+	if (useLinkHeader) {
+		if (const auto linkHeader = headers.value("link"); !linkHeader.isEmpty()) {
+			// header links are relative to the request, not to the base URL of the client
+			const auto links = ConfigurablePagingFactory::parseLinkHeader(linkHeader, requestUrl);
+			if (!paging->_next.isValid())
+				paging->_next = links.value(QStringLiteral("next"));
+			if (!paging->_prev.isValid())
+				paging->_prev = links.value(QStringLiteral("prev"), links.value(QStringLiteral("previous")));
+		}
+	}
+
+	return paging.take();
+}
+
+// ------------- Paging Implementations -------------
+
+QVariantMap ConfigurableCborPaging::properties() const
+{
+	std::call_once(_propertiesFlag, [this]() {
+		_properties = _data.toVariant().toMap();
+	});
+	return _properties;
+}
+
+QCborArray ConfigurableCborPaging::cborItems() const
+{
+	return _items;
+}
+
+QCborValue ConfigurableCborPaging::originalCbor() const
+{
+	return _data;
+}
+
+QVariantMap ConfigurableJsonPaging::properties() const
+{
+	std::call_once(_propertiesFlag, [this]() {
+		_properties = _data.toVariant().toMap();
+	});
+	return _properties;
+}
+
+QJsonArray ConfigurableJsonPaging::jsonItems() const
+{
+	return _items;
+}
+
+QJsonValue ConfigurableJsonPaging::originalJson() const
+{
+	return _data;
+}
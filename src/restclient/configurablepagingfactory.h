@@ -0,0 +1,58 @@
+#ifndef QTRESTCLIENT_CONFIGURABLEPAGINGFACTORY_H
+#define QTRESTCLIENT_CONFIGURABLEPAGINGFACTORY_H
+
+#include "QtRestClient/qtrestclient_global.h"
+#include "QtRestClient/ipaging.h"
+
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qstringlist.h>
+
+namespace QtRestClient {
+
+class ConfigurablePagingFactoryPrivate;
+//! A paging factory that locates the paging fields via JSON pointers and Link headers
+class Q_RESTCLIENT_EXPORT ConfigurablePagingFactory : public IPagingFactory, public IPagingHeaderFactory
+{
+public:
+	//! The fields of a paging object that can be located in the envelope
+	enum class Field {
+		Items,  //!< The array of elements of the paging
+		Total,  //!< The total number of elements
+		Offset,  //!< The offset of the first element of the paging
+		Next,  //!< The link to the next paging
+		Previous,  //!< The link to the previous paging
+		Cursor,  //!< The cursor of the paging
+		NextCursor  //!< The cursor of the next paging
+	};
+
+	//! Constructs a factory that uses the same layout as the standard paging factory
+	ConfigurablePagingFactory();
+	~ConfigurablePagingFactory() override;
+
+	//! Returns the JSON pointer the given field is read from
+	QString path(Field field) const;
+	//! Sets the JSON pointer the given field is read from
+	ConfigurablePagingFactory &setPath(Field field, const QString &jsonPointer);
+	//! Returns true, if the Link header of a response is used to find next and previous links
+	bool useLinkHeader() const;
+	//! Sets whether the Link header of a response is used to find next and previous links
+	ConfigurablePagingFactory &setUseLinkHeader(bool useLinkHeader);
+
+#ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
+	IPaging *createPaging(QtJsonSerializer::SerializerBase *serializer, const std::variant<QCborValue, QJsonValue> &data) const override;
+	IPaging *createPagingWithHeaders(QtJsonSerializer::SerializerBase *serializer, const std::variant<QCborValue, QJsonValue> &data, const HeaderHash &headers, const QUrl &requestUrl) const override;
+#else
+	IPaging *createPaging(const std::variant<QCborValue, QJsonValue> &data) const override;
+	IPaging *createPagingWithHeaders(const std::variant<QCborValue, QJsonValue> &data, const HeaderHash &headers, const QUrl &requestUrl) const override;
+#endif
+
+	//! Parses the value of a RFC 5988 Link header into relation types and their URLs
+	static QHash<QString, QUrl> parseLinkHeader(const QByteArray &headerValue, const QUrl &baseUrl = {});
+
+private:
+	QScopedPointer<ConfigurablePagingFactoryPrivate> d;
+};
+
+}
+
+#endif // QTRESTCLIENT_CONFIGURABLEPAGINGFACTORY_H
@@ -0,0 +1,76 @@
+#ifndef QTRESTCLIENT_CONFIGURABLEPAGINGFACTORY_P_H
+#define QTRESTCLIENT_CONFIGURABLEPAGINGFACTORY_P_H
+
+#include "configurablepagingfactory.h"
+#include "standardpaging_p.h"
+
+#include <array>
+#include <mutex>
+
+#include <QtCore/QVector>
+
+namespace QtRestClient {
+
+class ConfigurableCborPaging : public StandardPagingBase<ICborPaging>
+{
+	friend class ConfigurablePagingFactoryPrivate;
+public:
+	QVariantMap properties() const override;
+	QCborArray cborItems() const override;
+	QCborValue originalCbor() const override;
+
+private:
+	QCborValue _data;
+	QCborArray _items;
+	mutable std::once_flag _propertiesFlag;
+	mutable QVariantMap _properties;
+};
+
+class ConfigurableJsonPaging : public StandardPagingBase<IJsonPaging>
+{
+	friend class ConfigurablePagingFactoryPrivate;
+public:
+	QVariantMap properties() const override;
+	QJsonArray jsonItems() const override;
+	QJsonValue originalJson() const override;
+
+private:
+	QJsonValue _data;
+	QJsonArray _items;
+	mutable std::once_flag _propertiesFlag;
+	mutable QVariantMap _properties;
+};
+
+class ConfigurablePagingFactoryPrivate
+{
+public:
+	using Field = ConfigurablePagingFactory::Field;
+
+	struct PathToken {
+		QString key;
+		qint64 index = -1;
+	};
+
+	struct CompiledPath {
+		QString path;
+		bool enabled = false;
+		QVector<PathToken> tokens;
+	};
+
+	std::array<CompiledPath, static_cast<int>(Field::NextCursor) + 1> paths;
+	bool useLinkHeader = true;
+
+	static CompiledPath compile(const QString &path);
+	static QCborValue resolve(const CompiledPath &path, const QCborValue &root);
+	static QJsonValue resolve(const CompiledPath &path, const QJsonValue &root);
+
+	const CompiledPath &path(Field field) const;
+	template <typename TPaging, typename TValue>
+	TPaging *create(const TValue &value, const HeaderHash &headers, const QUrl &requestUrl) const;
+};
+
+Q_DECLARE_LOGGING_CATEGORY(logConfigurablePaging)
+
+}
+
+#endif // QTRESTCLIENT_CONFIGURABLEPAGINGFACTORY_P_H
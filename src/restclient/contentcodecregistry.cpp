@@ -0,0 +1,318 @@
+#include "contentcodecregistry.h"
+#include "contentcodecregistry_p.h"
+#include "requestbuilder_p.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QtCore/QCborArray>
+#include <QtCore/QCborMap>
+#include <QtCore/QCborStreamReader>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QVector>
+using namespace QtRestClient;
+
+namespace {
+
+QCborValue toCbor(const IContentCodec::EncodeType &data)
+{
+	if (const auto jValue = std::get_if<QJsonValue>(&data); jValue)
+		return QCborValue::fromJsonValue(*jValue);
+	else
+		return std::get<QCborValue>(data);
+}
+
+QJsonValue toJson(const IContentCodec::EncodeType &data)
+{
+	if (const auto cValue = std::get_if<QCborValue>(&data); cValue)
+		return cValue->toJsonValue();
+	else
+		return std::get<QJsonValue>(data);
+}
+
+}
+
+IContentCodec::IContentCodec() = default;
+
+IContentCodec::~IContentCodec() = default;
+
+
+
+ContentCodecRegistry::ContentCodecRegistry()
+{
+	// all default registries share the same built in codecs until they are modified
+	static const auto defaultData = ContentCodecRegistryData::createDefault();
+	d = defaultData;
+}
+
+ContentCodecRegistry::ContentCodecRegistry(const ContentCodecRegistry &other) = default;
+
+ContentCodecRegistry::ContentCodecRegistry(ContentCodecRegistry &&other) noexcept = default;
+
+ContentCodecRegistry &ContentCodecRegistry::operator=(const ContentCodecRegistry &other) = default;
+
+ContentCodecRegistry &ContentCodecRegistry::operator=(ContentCodecRegistry &&other) noexcept = default;
+
+ContentCodecRegistry::~ContentCodecRegistry() = default;
+
+ContentCodecRegistry &ContentCodecRegistry::addParser(IReplyParser *parser, qreal quality)
+{
+	const QSharedPointer<IReplyParser> parserPtr{parser};
+	quality = std::round(qBound(0.0, quality, 1.0) * 1000.0) / 1000.0;
+	const auto types = parser->contentTypes();
+	for (const auto &contentType : types)
+		d->entries.insert(contentType, {parserPtr, quality});
+	return *this;
+}
+
+ContentCodecRegistry &ContentCodecRegistry::remove(const QByteArray &contentType)
+{
+	d->entries.remove(contentType);
+	return *this;
+}
+
+ContentCodecRegistry &ContentCodecRegistry::setQuality(const QByteArray &contentType, qreal quality)
+{
+	if (!d.constData()->entries.contains(contentType))
+		return *this;
+	// q-values have at most three decimals
+	d->entries[contentType].quality = std::round(qBound(0.0, quality, 1.0) * 1000.0) / 1000.0;
+	return *this;
+}
+
+QByteArrayList ContentCodecRegistry::contentTypes() const
+{
+	return d->entries.keys();
+}
+
+qreal ContentCodecRegistry::quality(const QByteArray &contentType) const
+{
+	return d->entries.value(contentType).quality;
+}
+
+IReplyParser *ContentCodecRegistry::parser(const QByteArray &contentType) const
+{
+	return d->entries.value(contentType).parser.data();
+}
+
+IContentCodec *ContentCodecRegistry::codec(const QByteArray &contentType) const
+{
+	return dynamic_cast<IContentCodec*>(parser(contentType));
+}
+
+QByteArray ContentCodecRegistry::acceptHeader(const QByteArray &preferredType) const
+{
+	QVector<std::pair<qreal, QByteArray>> alternatives;
+	for (auto it = d->entries.constBegin(), end = d->entries.constEnd(); it != end; ++it) {
+		if (it.key() != preferredType && it->quality > 0.0)
+			alternatives.append(std::make_pair(it->quality, it.key()));
+	}
+	// highest quality first, sorted by name otherwise to keep the header stable
+	std::sort(alternatives.begin(), alternatives.end(), [](const auto &lhs, const auto &rhs) {
+		return lhs.first != rhs.first ? lhs.first > rhs.first : lhs.second < rhs.second;
+	});
+
+	auto header = preferredType;
+	for (const auto &alternative : qAsConst(alternatives))
+		header += ", " + alternative.second + ";q=" + QByteArray::number(alternative.first, 'g', 3);
+	return header;
+}
+
+std::optional<QByteArray> ContentCodecRegistry::encode(const IContentCodec::EncodeType &data, const QByteArray &contentType) const
+{
+	if (const auto encoder = codec(contentType); encoder)
+		return encoder->encode(data, contentType);
+	else
+		return std::nullopt;
+}
+
+QByteArrayList ContentCodecRegistry::parseAcceptHeader(const QByteArray &header)
+{
+	QVector<std::pair<qreal, QByteArray>> mediaTypes;
+	const auto ranges = header.split(',');
+	for (const auto &range : ranges) {
+		const auto params = range.split(';');
+		const auto mediaType = params.first().trimmed();
+		if (mediaType.isEmpty())
+			continue;
+
+		auto quality = 1.0;
+		for (auto i = 1; i < params.size(); ++i) {
+			const auto param = params[i].trimmed();
+			if (param.startsWith("q=")) {
+				auto ok = false;
+				quality = param.mid(2).toDouble(&ok);
+				if (!ok)
+					quality = 0.0;
+				break;
+			}
+		}
+		if (quality > 0.0)
+			mediaTypes.append(std::make_pair(quality, mediaType));
+	}
+	std::stable_sort(mediaTypes.begin(), mediaTypes.end(), [](const auto &lhs, const auto &rhs) {
+		return lhs.first > rhs.first;
+	});
+
+	QByteArrayList result;
+	result.reserve(mediaTypes.size());
+	for (const auto &mediaType : qAsConst(mediaTypes))
+		result.append(mediaType.second);
+	return result;
+}
+
+// ------------- Private Implementation -------------
+
+QSharedDataPointer<ContentCodecRegistryData> ContentCodecRegistryData::createDefault()
+{
+	QSharedDataPointer<ContentCodecRegistryData> data{new ContentCodecRegistryData{}};
+	const QList<QSharedPointer<IReplyParser>> codecs {
+		QSharedPointer<JsonContentCodec>::create(),
+		QSharedPointer<CborContentCodec>::create(),
+		QSharedPointer<MessagePackContentCodec>::create(),
+		QSharedPointer<LengthDelimitedContentCodec>::create()
+	};
+	for (const auto &codec : codecs) {
+		const auto types = codec->contentTypes();
+		for (const auto &contentType : types)
+			data->entries.insert(contentType, {codec, 0.0});
+	}
+	return data;
+}
+
+
+
+QByteArrayList JsonContentCodec::contentTypes() const
+{
+	return {RequestBuilderPrivate::ContentTypeJson};
+}
+
+IReplyParser::Result JsonContentCodec::parse(QIODevice *device, const QByteArray &contentType) const
+{
+	Q_UNUSED(contentType)
+	const auto readData = device->readAll();
+	QJsonParseError error;
+	auto jDoc = QJsonDocument::fromJson(readData, &error);
+	if (error.error != QJsonParseError::NoError) {
+		if (error.error == QJsonParseError::IllegalValue) {
+			// try to read again as array, to get valid non obj/arr data
+			QJsonParseError wrappedError;
+			jDoc = QJsonDocument::fromJson("[" + readData + "]", &wrappedError);  // read wrapped as array
+			if (wrappedError.error == QJsonParseError::NoError)
+				return DataType{jDoc.array().first()};
+		}
+		return ParseError{error.error, error.errorString()};
+	} else if (jDoc.isObject())
+		return DataType{QJsonValue{jDoc.object()}};
+	else if (jDoc.isArray())
+		return DataType{QJsonValue{jDoc.array()}};
+	else if (jDoc.isNull())
+		return DataType{QJsonValue{QJsonValue::Null}};
+	else
+		Q_UNREACHABLE();
+}
+
+std::optional<QByteArray> JsonContentCodec::encode(const EncodeType &data, const QByteArray &contentType) const
+{
+	Q_UNUSED(contentType)
+	const auto value = toJson(data);
+	if (value.isObject())
+		return QJsonDocument{value.toObject()}.toJson(QJsonDocument::Compact);
+	else if (value.isArray())
+		return QJsonDocument{value.toArray()}.toJson(QJsonDocument::Compact);
+	else {
+		// documents can only hold objects and arrays, so write it wrapped and strip the brackets
+		const auto wrapped = QJsonDocument{QJsonArray{value}}.toJson(QJsonDocument::Compact);
+		return wrapped.mid(1, wrapped.size() - 2);
+	}
+}
+
+
+
+QByteArrayList CborContentCodec::contentTypes() const
+{
+	return {RequestBuilderPrivate::ContentTypeCbor};
+}
+
+IReplyParser::Result CborContentCodec::parse(QIODevice *device, const QByteArray &contentType) const
+{
+	Q_UNUSED(contentType)
+	QCborStreamReader reader{device};
+	auto value = QCborValue::fromCbor(reader);
+	if (const auto error = reader.lastError(); error.c != QCborError::NoError)
+		return ParseError{error.c, error.toString()};
+	else
+		return DataType{std::move(value)};
+}
+
+std::optional<QByteArray> CborContentCodec::encode(const EncodeType &data, const QByteArray &contentType) const
+{
+	Q_UNUSED(contentType)
+	return toCbor(data).toCbor();
+}
+
+
+
+const QByteArray LengthDelimitedContentCodec::ContentType = "application/x-protobuf-delimited";
+
+QByteArrayList LengthDelimitedContentCodec::contentTypes() const
+{
+	return {ContentType};
+}
+
+IReplyParser::Result LengthDelimitedContentCodec::parse(QIODevice *device, const QByteArray &contentType) const
+{
+	Q_UNUSED(contentType)
+	const auto readData = device->readAll();
+	QCborArray messages;
+	QByteArray::size_type pos = 0;
+	while (pos < readData.size()) {
+		// base 128 varint, least significant group first
+		quint64 length = 0;
+		for (auto shift = 0;; shift += 7) {
+			if (pos >= readData.size() || shift >= 64)
+				return ParseError{-1, QStringLiteral("Invalid length prefix at offset %1").arg(pos)};
+			const auto byte = static_cast<quint8>(readData[pos++]);
+			length |= static_cast<quint64>(byte & 0x7f) << shift;
+			if ((byte & 0x80) == 0)
+				break;
+		}
+		if (length > static_cast<quint64>(readData.size() - pos))
+			return ParseError{-1, QStringLiteral("Message at offset %1 exceeds the data").arg(pos)};
+		messages.append(readData.mid(pos, static_cast<QByteArray::size_type>(length)));
+		pos += static_cast<QByteArray::size_type>(length);
+	}
+	return DataType{QCborValue{messages}};
+}
+
+std::optional<QByteArray> LengthDelimitedContentCodec::encode(const EncodeType &data, const QByteArray &contentType) const
+{
+	Q_UNUSED(contentType)
+	const auto value = toCbor(data);
+	QCborArray messages;
+	if (value.isByteArray())
+		messages.append(value);
+	else if (value.isArray())
+		messages = value.toArray();
+	else
+		return std::nullopt;
+
+	QByteArray result;
+	for (const auto &message : qAsConst(messages)) {
+		if (!message.isByteArray())
+			return std::nullopt;
+		const auto bytes = message.toByteArray();
+		auto length = static_cast<quint64>(bytes.size());
+		do {
+			auto byte = static_cast<quint8>(length & 0x7f);
+			length >>= 7;
+			if (length != 0)
+				byte |= 0x80;
+			result.append(static_cast<char>(byte));
+		} while (length != 0);
+		result.append(bytes);
+	}
+	return result;
+}
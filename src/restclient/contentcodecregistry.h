@@ -0,0 +1,77 @@
+#ifndef QTRESTCLIENT_CONTENTCODECREGISTRY_H
+#define QTRESTCLIENT_CONTENTCODECREGISTRY_H
+
+#include "QtRestClient/qtrestclient_global.h"
+#include "QtRestClient/ireplyparser.h"
+
+#include <optional>
+#include <variant>
+
+#include <QtCore/qcborvalue.h>
+#include <QtCore/qjsonvalue.h>
+#include <QtCore/qshareddata.h>
+
+namespace QtRestClient {
+
+//! A reply parser that can also encode data into its content types
+class Q_RESTCLIENT_EXPORT IContentCodec : public IReplyParser
+{
+public:
+	//! The data that can be encoded, either CBOR or JSON
+	using EncodeType = std::variant<QCborValue, QJsonValue>;
+
+	IContentCodec();
+	~IContentCodec() override;
+
+	//! Encodes the data as one of the content types, or returns nothing if it cannot be represented
+	virtual std::optional<QByteArray> encode(const EncodeType &data, const QByteArray &contentType) const = 0;
+};
+
+class ContentCodecRegistryData;
+//! A collection of parsers and codecs for the content types of replies and requests
+class Q_RESTCLIENT_EXPORT ContentCodecRegistry
+{
+public:
+	//! Creates a registry with the built in JSON, CBOR, MessagePack and length delimited codecs
+	ContentCodecRegistry();
+	//! Copy constructor
+	ContentCodecRegistry(const ContentCodecRegistry &other);
+	//! Move constructor
+	ContentCodecRegistry(ContentCodecRegistry &&other) noexcept;
+	//! Copy assignment operator
+	ContentCodecRegistry &operator=(const ContentCodecRegistry &other);
+	//! Move assignment operator
+	ContentCodecRegistry &operator=(ContentCodecRegistry &&other) noexcept;
+	~ContentCodecRegistry();
+
+	//! Adds a parser or codec for all of its content types and takes ownership of it
+	ContentCodecRegistry &addParser(IReplyParser *parser, qreal quality = 0.0);
+	//! Removes the parser or codec of the given content type
+	ContentCodecRegistry &remove(const QByteArray &contentType);
+	//! Sets the quality the content type is advertised with in the `Accept` header
+	ContentCodecRegistry &setQuality(const QByteArray &contentType, qreal quality);
+
+	//! Returns all content types a parser is registered for
+	QByteArrayList contentTypes() const;
+	//! Returns the quality the content type is advertised with
+	qreal quality(const QByteArray &contentType) const;
+	//! Returns the parser for the given content type, if one was added
+	IReplyParser *parser(const QByteArray &contentType) const;
+	//! Returns the codec for the given content type, if the parser for it can encode data
+	IContentCodec *codec(const QByteArray &contentType) const;
+
+	//! Creates an `Accept` header with the preferred type and all types that have a quality
+	QByteArray acceptHeader(const QByteArray &preferredType) const;
+	//! Encodes the data with the codec of the given content type
+	std::optional<QByteArray> encode(const IContentCodec::EncodeType &data, const QByteArray &contentType) const;
+
+	//! Parses the media types of an `Accept` header, ordered by their quality
+	static QByteArrayList parseAcceptHeader(const QByteArray &header);
+
+private:
+	QSharedDataPointer<ContentCodecRegistryData> d;
+};
+
+}
+
+#endif // QTRESTCLIENT_CONTENTCODECREGISTRY_H
@@ -0,0 +1,64 @@
+#ifndef QTRESTCLIENT_CONTENTCODECREGISTRY_P_H
+#define QTRESTCLIENT_CONTENTCODECREGISTRY_P_H
+
+#include "contentcodecregistry.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QSharedPointer>
+
+namespace QtRestClient {
+
+class Q_RESTCLIENT_EXPORT ContentCodecRegistryData : public QSharedData
+{
+public:
+	struct Entry {
+		QSharedPointer<IReplyParser> parser;
+		qreal quality = 0.0;
+	};
+
+	QHash<QByteArray, Entry> entries;
+
+	static QSharedDataPointer<ContentCodecRegistryData> createDefault();
+};
+
+class Q_RESTCLIENT_EXPORT JsonContentCodec : public IContentCodec
+{
+public:
+	QByteArrayList contentTypes() const override;
+	Result parse(QIODevice *device, const QByteArray &contentType) const override;
+	std::optional<QByteArray> encode(const EncodeType &data, const QByteArray &contentType) const override;
+};
+
+class Q_RESTCLIENT_EXPORT CborContentCodec : public IContentCodec
+{
+public:
+	QByteArrayList contentTypes() const override;
+	Result parse(QIODevice *device, const QByteArray &contentType) const override;
+	std::optional<QByteArray> encode(const EncodeType &data, const QByteArray &contentType) const override;
+};
+
+// MessagePack, mapped onto CBOR values. Timestamps (extension -1) become date times
+class Q_RESTCLIENT_EXPORT MessagePackContentCodec : public IContentCodec
+{
+public:
+	static const QByteArray ContentType;
+
+	QByteArrayList contentTypes() const override;
+	Result parse(QIODevice *device, const QByteArray &contentType) const override;
+	std::optional<QByteArray> encode(const EncodeType &data, const QByteArray &contentType) const override;
+};
+
+// a stream of varint length prefixed messages, as written by protobufs writeDelimitedTo
+class Q_RESTCLIENT_EXPORT LengthDelimitedContentCodec : public IContentCodec
+{
+public:
+	static const QByteArray ContentType;
+
+	QByteArrayList contentTypes() const override;
+	Result parse(QIODevice *device, const QByteArray &contentType) const override;
+	std::optional<QByteArray> encode(const EncodeType &data, const QByteArray &contentType) const override;
+};
+
+}
+
+#endif // QTRESTCLIENT_CONTENTCODECREGISTRY_P_H
@@ -0,0 +1,262 @@
+#include "endpointselector.h"
+#include "endpointselector_p.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QtEndian>
+using namespace QtRestClient;
+using namespace std::chrono;
+
+Q_LOGGING_CATEGORY(QtRestClient::logEndpoints, "qt.restclient.Endpoints")
+
+IEndpointSelector::IEndpointSelector() = default;
+
+IEndpointSelector::~IEndpointSelector() = default;
+
+IEndpointSelector *IEndpointSelector::create(Strategy strategy)
+{
+	switch (strategy) {
+	case Strategy::RoundRobin:
+		return new RoundRobinSelector{};
+	case Strategy::LeastOutstanding:
+		return new LeastOutstandingSelector{};
+	case Strategy::LowestLatency:
+		return new LowestLatencySelector{};
+	case Strategy::ConsistentHash:
+		return new ConsistentHashSelector{};
+	default:
+		Q_UNREACHABLE();
+	}
+}
+
+// ------------- Private Implementation -------------
+
+int RoundRobinSelector::select(const QVector<EndpointInfo> &endpoints, const QUrl &url)
+{
+	Q_UNUSED(url)
+	return static_cast<int>(counter++ % static_cast<uint>(endpoints.size()));
+}
+
+
+
+int LeastOutstandingSelector::select(const QVector<EndpointInfo> &endpoints, const QUrl &url)
+{
+	Q_UNUSED(url)
+	const auto offset = static_cast<int>(counter++ % static_cast<uint>(endpoints.size()));
+	auto best = offset;
+	for (auto i = 1; i < endpoints.size(); ++i) {
+		const auto index = (offset + i) % endpoints.size();
+		if (endpoints[index].outstanding < endpoints[best].outstanding)
+			best = index;
+	}
+	return best;
+}
+
+
+
+int LowestLatencySelector::select(const QVector<EndpointInfo> &endpoints, const QUrl &url)
+{
+	Q_UNUSED(url)
+	auto best = 0;
+	auto bestCost = std::numeric_limits<qint64>::max();
+	for (auto i = 0; i < endpoints.size(); ++i) {
+		// endpoints without any measurement are tried first to learn their latency
+		if (!endpoints[i].latency)
+			return i;
+		// pending replies will add to the latency of the next one, even for instant endpoints
+		const auto cost = (endpoints[i].latency->count() + 1) * (endpoints[i].outstanding + 1);
+		if (cost < bestCost) {
+			best = i;
+			bestCost = cost;
+		}
+	}
+	return best;
+}
+
+
+
+int ConsistentHashSelector::select(const QVector<EndpointInfo> &endpoints, const QUrl &url)
+{
+	const auto path = url.path(QUrl::FullyEncoded).toUtf8();
+	auto best = 0;
+	quint64 bestWeight = 0;
+	for (auto i = 0; i < endpoints.size(); ++i) {
+		QCryptographicHash hash{QCryptographicHash::Md5};
+		hash.addData(endpoints[i].url.toEncoded());
+		hash.addData(path);
+		const auto weight = qFromLittleEndian<quint64>(hash.result().constData());
+		if (i == 0 || weight > bestWeight) {
+			best = i;
+			bestWeight = weight;
+		}
+	}
+	return best;
+}
+
+
+
+EndpointPool::EndpointPool(QUrl baseUrl, const QList<QUrl> &urls, QSharedPointer<IEndpointSelector> selector) :
+	_baseUrl{std::move(baseUrl)},
+	_basePath{normalizedPath(_baseUrl)},
+	_selector{std::move(selector)}
+{
+	_endpoints.reserve(urls.size());
+	for (const auto &url : urls) {
+		Endpoint endpoint;
+		endpoint.url = url;
+		endpoint.path = normalizedPath(url);
+		_endpoints.append(std::move(endpoint));
+	}
+}
+
+QUrl EndpointPool::resolve(const QUrl &url, int exclude) const
+{
+	QVector<EndpointInfo> candidates;
+	QVector<int> indexes;
+	QString fromPath;
+	{
+		QMutexLocker _{&_mutex};
+		if (isBelow(url, _baseUrl, _basePath))
+			fromPath = _basePath;
+		else if (const auto current = indexOf(url); current != -1)
+			fromPath = _endpoints[current].path;
+		else
+			return url;
+
+		candidates.reserve(_endpoints.size());
+		indexes.reserve(_endpoints.size());
+		// ejected endpoints are only used if no healthy one is left
+		for (auto healthyOnly : {true, false}) {
+			for (auto i = 0; i < _endpoints.size(); ++i) {
+				const auto &endpoint = _endpoints[i];
+				if (i == exclude || (healthyOnly && !endpoint.ejectedUntil.hasExpired()))
+					continue;
+				EndpointInfo info;
+				info.url = endpoint.url;
+				info.outstanding = endpoint.outstanding;
+				if (endpoint.latency)
+					info.latency = milliseconds{static_cast<qint64>(std::ceil(*endpoint.latency))};
+				candidates.append(std::move(info));
+				indexes.append(i);
+			}
+			if (!candidates.isEmpty())
+				break;
+		}
+		if (candidates.isEmpty())
+			return url;
+	}
+
+	// called without the lock, so slow selectors do not block the accounting of other replies
+	const auto selected = _selector->select(candidates, url);
+	Q_ASSERT_X(selected >= 0 && selected < candidates.size(), Q_FUNC_INFO, "IEndpointSelector::select returned an invalid index");
+	return mapUrl(url, fromPath, _endpoints[indexes[selected]]);
+}
+
+int EndpointPool::indexOf(const QUrl &url) const
+{
+	for (auto i = 0; i < _endpoints.size(); ++i) {
+		if (isBelow(url, _endpoints[i].url, _endpoints[i].path))
+			return i;
+	}
+	return -1;
+}
+
+bool EndpointPool::isHealthy(int endpoint) const
+{
+	QMutexLocker _{&_mutex};
+	return endpoint >= 0 &&
+		   endpoint < _endpoints.size() &&
+		   _endpoints[endpoint].ejectedUntil.hasExpired();
+}
+
+std::optional<milliseconds> EndpointPool::latencyPercentile(int endpoint, double percentile) const
+{
+	QVector<qint64> samples;
+	{
+		QMutexLocker _{&_mutex};
+		samples = _endpoints[endpoint].samples;
+	}
+	if (samples.size() < MinPercentileSamples)
+		return std::nullopt;
+
+	const auto nth = samples.begin() + qBound(0, static_cast<int>(std::ceil(percentile * samples.size())) - 1, samples.size() - 1);
+	std::nth_element(samples.begin(), nth, samples.end());
+	return milliseconds{*nth};
+}
+
+void EndpointPool::begin(int endpoint)
+{
+	QMutexLocker _{&_mutex};
+	++_endpoints[endpoint].outstanding;
+}
+
+void EndpointPool::end(int endpoint, Outcome outcome, milliseconds latency)
+{
+	QMutexLocker _{&_mutex};
+	auto &state = _endpoints[endpoint];
+	--state.outstanding;
+	switch (outcome) {
+	case Outcome::Success:
+		state.latency = state.latency ?
+							LatencyWeight * latency.count() + (1.0 - LatencyWeight) * *state.latency :
+							latency.count();
+		if (state.samples.size() < LatencySamples)
+			state.samples.append(latency.count());
+		else
+			state.samples[state.nextSample] = latency.count();
+		state.nextSample = (state.nextSample + 1) % LatencySamples;
+		state.failures = 0;
+		state.ejections = 0;
+		break;
+	case Outcome::Failure:
+		// an endpoint that fails again right after being reinserted is ejected for longer
+		if (++state.failures >= EjectFailures && state.ejectedUntil.hasExpired()) {
+			const auto ejectTime = std::min<seconds>(EjectTime * (1 << std::min(state.ejections, 5)), MaxEjectTime);
+			state.ejectedUntil.setRemainingTime(ejectTime);
+			++state.ejections;
+			state.failures = 0;
+			qCWarning(logEndpoints) << "Ejecting endpoint" << state.url.toString(QUrl::RemoveUserInfo)
+									<< "for" << ejectTime.count() << "seconds after repeated failures";
+		}
+		break;
+	case Outcome::Canceled:
+		break;
+	default:
+		Q_UNREACHABLE();
+	}
+}
+
+QString EndpointPool::normalizedPath(const QUrl &url)
+{
+	auto path = url.path(QUrl::FullyEncoded);
+	while (path.endsWith(QLatin1Char('/')))
+		path.chop(1);
+	return path;
+}
+
+bool EndpointPool::isBelow(const QUrl &url, const QUrl &base, const QString &basePath)
+{
+	const auto defaultPort = url.scheme() == QStringLiteral("https") ? 443 : 80;
+	if (url.scheme() != base.scheme() ||
+		url.host() != base.host() ||
+		url.port(defaultPort) != base.port(defaultPort))
+		return false;
+	const auto path = url.path(QUrl::FullyEncoded);
+	return path.startsWith(basePath) &&
+		   (path.size() == basePath.size() || path[basePath.size()] == QLatin1Char('/'));
+}
+
+QUrl EndpointPool::mapUrl(const QUrl &url, const QString &fromPath, const Endpoint &to) const
+{
+	auto result = url;
+	result.setScheme(to.url.scheme());
+	result.setHost(to.url.host());
+	result.setPort(to.url.port());
+	if (!to.url.userInfo().isEmpty())
+		result.setUserInfo(to.url.userInfo());
+	result.setPath(to.path + url.path(QUrl::FullyEncoded).mid(fromPath.size()), QUrl::StrictMode);
+	return result;
+}
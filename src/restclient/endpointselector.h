@@ -0,0 +1,50 @@
+#ifndef QTRESTCLIENT_ENDPOINTSELECTOR_H
+#define QTRESTCLIENT_ENDPOINTSELECTOR_H
+
+#include "QtRestClient/qtrestclient_global.h"
+
+#include <chrono>
+#include <optional>
+
+#include <QtCore/qurl.h>
+#include <QtCore/qvector.h>
+
+namespace QtRestClient {
+
+//! The current state of one endpoint of a RestClient, as seen by an IEndpointSelector
+struct Q_RESTCLIENT_EXPORT EndpointInfo
+{
+	//! The base URL of the endpoint
+	QUrl url;
+	//! The number of replies that are currently waiting for the endpoint
+	int outstanding = 0;
+	//! The exponentially weighted moving average of the reply latency, empty if unknown yet
+	std::optional<std::chrono::milliseconds> latency;
+};
+
+//! Chooses the endpoint of a RestClient that a request is sent to
+class Q_RESTCLIENT_EXPORT IEndpointSelector
+{
+	Q_DISABLE_COPY(IEndpointSelector)
+public:
+	//! The built in selection strategies
+	enum class Strategy {
+		RoundRobin,  //!< Use all endpoints in turn
+		LeastOutstanding,  //!< Use the endpoint with the fewest pending replies
+		LowestLatency,  //!< Use the endpoint with the lowest latency, weighted by its pending replies
+		ConsistentHash  //!< Always use the same endpoint for the same path, as long as it is healthy
+	};
+
+	IEndpointSelector();
+	virtual ~IEndpointSelector();
+
+	//! Returns the index of the endpoint to send a request for the given URL to
+	virtual int select(const QVector<EndpointInfo> &endpoints, const QUrl &url) = 0;
+
+	//! Creates a selector for one of the built in strategies
+	static IEndpointSelector *create(Strategy strategy);
+};
+
+}
+
+#endif // QTRESTCLIENT_ENDPOINTSELECTOR_H
@@ -0,0 +1,106 @@
+#ifndef QTRESTCLIENT_ENDPOINTSELECTOR_P_H
+#define QTRESTCLIENT_ENDPOINTSELECTOR_P_H
+
+#include "endpointselector.h"
+
+#include <atomic>
+#include <optional>
+
+#include <QtCore/QDeadlineTimer>
+#include <QtCore/QMutex>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QLoggingCategory>
+
+namespace QtRestClient {
+
+class Q_RESTCLIENT_EXPORT RoundRobinSelector : public IEndpointSelector
+{
+public:
+	int select(const QVector<EndpointInfo> &endpoints, const QUrl &url) override;
+
+private:
+	std::atomic_uint counter {0};
+};
+
+class Q_RESTCLIENT_EXPORT LeastOutstandingSelector : public IEndpointSelector
+{
+public:
+	int select(const QVector<EndpointInfo> &endpoints, const QUrl &url) override;
+
+private:
+	// rotates the first candidate, so idle endpoints are used evenly
+	std::atomic_uint counter {0};
+};
+
+class Q_RESTCLIENT_EXPORT LowestLatencySelector : public IEndpointSelector
+{
+public:
+	int select(const QVector<EndpointInfo> &endpoints, const QUrl &url) override;
+};
+
+// rendezvous hashing, so only the paths of an ejected endpoint move to others
+class Q_RESTCLIENT_EXPORT ConsistentHashSelector : public IEndpointSelector
+{
+public:
+	int select(const QVector<EndpointInfo> &endpoints, const QUrl &url) override;
+};
+
+// the endpoints of a client, with the health and load of each of them
+class Q_RESTCLIENT_EXPORT EndpointPool
+{
+	Q_DISABLE_COPY(EndpointPool)
+public:
+	enum class Outcome {
+		Success,
+		Failure,
+		Canceled
+	};
+
+	static constexpr int EjectFailures = 3;
+	static constexpr std::chrono::seconds EjectTime {10};
+	static constexpr std::chrono::seconds MaxEjectTime {300};
+	static constexpr double LatencyWeight = 0.3;
+	static constexpr int LatencySamples = 100;
+	static constexpr int MinPercentileSamples = 10;
+
+	EndpointPool(QUrl baseUrl, const QList<QUrl> &urls, QSharedPointer<IEndpointSelector> selector);
+
+	// maps a URL below the base URL onto a healthy endpoint, leaving other URLs untouched
+	QUrl resolve(const QUrl &url, int exclude = -1) const;
+	int indexOf(const QUrl &url) const;
+	bool isHealthy(int endpoint) const;
+	std::optional<std::chrono::milliseconds> latencyPercentile(int endpoint, double percentile) const;
+
+	void begin(int endpoint);
+	void end(int endpoint, Outcome outcome, std::chrono::milliseconds latency);
+
+private:
+	struct Endpoint {
+		QUrl url;
+		QString path;
+		int outstanding = 0;
+		std::optional<double> latency;
+		// ring buffer of the most recent latencies, for percentiles
+		QVector<qint64> samples;
+		int nextSample = 0;
+		int failures = 0;
+		int ejections = 0;
+		QDeadlineTimer ejectedUntil;
+	};
+
+	const QUrl _baseUrl;
+	const QString _basePath;
+	const QSharedPointer<IEndpointSelector> _selector;
+	mutable QMutex _mutex;
+	QVector<Endpoint> _endpoints;
+
+	static QString normalizedPath(const QUrl &url);
+	static bool isBelow(const QUrl &url, const QUrl &base, const QString &basePath);
+	QUrl mapUrl(const QUrl &url, const QString &fromPath, const Endpoint &to) const;
+};
+
+Q_DECLARE_LOGGING_CATEGORY(logEndpoints)
+
+}
+
+#endif // QTRESTCLIENT_ENDPOINTSELECTOR_P_H
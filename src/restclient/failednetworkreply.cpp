@@ -0,0 +1,42 @@
+#include "failednetworkreply_p.h"
+using namespace QtRestClient;
+
+FailedNetworkReply::FailedNetworkReply(QNetworkAccessManager *nam, const QNetworkRequest &request, const QByteArray &verb, NetworkError error, const QString &errorString) :
+	QNetworkReply{nam},
+	_nam{nam}
+{
+	// like the replies of QNetworkAccessManager::sendCustomRequest, so the request can be sent again
+	auto vRequest = request;
+	vRequest.setAttribute(QNetworkRequest::CustomVerbAttribute, verb);
+	setRequest(vRequest);
+	setUrl(vRequest.url());
+	setOperation(QNetworkAccessManager::CustomOperation);
+	setError(error, errorString);
+	open(QIODevice::ReadOnly);
+	setFinished(true);
+
+	// like the failed replies of QNetworkAccessManager, the signals are emitted once the caller had
+	// a chance to connect to them
+	QMetaObject::invokeMethod(this, [this, error]() {
+#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
+		Q_EMIT this->error(error);
+#else
+		Q_EMIT errorOccurred(error);
+#endif
+		Q_EMIT finished();
+	}, Qt::QueuedConnection);
+}
+
+QNetworkAccessManager *FailedNetworkReply::nam() const
+{
+	return _nam;
+}
+
+void FailedNetworkReply::abort() {}
+
+qint64 FailedNetworkReply::readData(char *data, qint64 maxSize)
+{
+	Q_UNUSED(data)
+	Q_UNUSED(maxSize)
+	return -1;
+}
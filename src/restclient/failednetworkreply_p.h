@@ -0,0 +1,37 @@
+#ifndef QTRESTCLIENT_FAILEDNETWORKREPLY_P_H
+#define QTRESTCLIENT_FAILEDNETWORKREPLY_P_H
+
+#include "qtrestclient_global.h"
+
+#include <QtCore/QPointer>
+
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
+
+namespace QtRestClient {
+
+// stands in for the network reply of a request that was never sent
+class Q_RESTCLIENT_EXPORT FailedNetworkReply : public QNetworkReply
+{
+	Q_OBJECT
+public:
+	FailedNetworkReply(QNetworkAccessManager *nam,
+					   const QNetworkRequest &request,
+					   const QByteArray &verb,
+					   NetworkError error,
+					   const QString &errorString);
+
+	QNetworkAccessManager *nam() const;
+
+	void abort() override;
+
+protected:
+	qint64 readData(char *data, qint64 maxSize) override;
+
+private:
+	QPointer<QNetworkAccessManager> _nam;
+};
+
+}
+
+#endif // QTRESTCLIENT_FAILEDNETWORKREPLY_P_H
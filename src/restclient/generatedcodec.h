@@ -0,0 +1,354 @@
+#ifndef QTRESTCLIENT_GENERATEDCODEC_H
+#define QTRESTCLIENT_GENERATEDCODEC_H
+
+#include "QtRestClient/qtrestclient_global.h"
+
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <variant>
+
+#include <QtCore/qcborvalue.h>
+#include <QtCore/qcbormap.h>
+#include <QtCore/qcborstreamreader.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qjsonvalue.h>
+#include <QtCore/qjsonobject.h>
+
+#include <QtJsonSerializer/serializerbase.h>
+#include <QtJsonSerializer/jsonserializer.h>
+
+namespace QtRestClient {
+
+//! Helpers for the non reflective (de)serializers generated by the qrestbuilder
+namespace GeneratedCodec {
+
+//! Type trait to check if a type (or the class a pointer points to) has generated (de)serializers
+template <typename T, typename = void>
+struct HasCodec : public std::false_type {};
+
+template <typename T>
+struct HasCodec<T, std::void_t<decltype(std::remove_pointer_t<T>::fromCbor(std::declval<QCborValue>(), nullptr, nullptr)),
+							   decltype(std::remove_pointer_t<T>::fromJson(std::declval<QJsonValue>(), nullptr, nullptr))>> :
+	public std::true_type {};
+
+//! Type trait to check if a type (or a list of such types) can be read directly from a CBOR stream
+template <typename T, typename = void>
+struct HasStreamCodec : public std::false_type {};
+
+template <typename T>
+struct HasStreamCodec<T, std::void_t<decltype(std::remove_pointer_t<T>::fromCborStream(std::declval<QCborStreamReader&>(), nullptr, nullptr))>> :
+	public std::true_type {};
+
+template <typename T>
+struct HasStreamCodec<QList<T>, std::enable_if_t<HasStreamCodec<T>::value>> :
+	public std::true_type {};
+
+//! Checks if the given serializer can be bypassed when reading generated types
+inline bool canRead(const QtJsonSerializer::SerializerBase *serializer) {
+	// any validation (i.e. required properties) is only done by the serializer
+	return !serializer->validationFlags();
+}
+
+//! Checks if the given serializer can be bypassed when reading generated objects
+inline bool canReadObject(const QtJsonSerializer::SerializerBase *serializer) {
+	return canRead(serializer) &&
+		   serializer->polymorphing() != QtJsonSerializer::SerializerBase::Polymorphing::Forced;
+}
+
+//! Checks if the given serializer can be bypassed when writing generated objects
+inline bool canWriteObject(const QtJsonSerializer::SerializerBase *serializer) {
+	return !serializer->keepObjectName() &&
+		   serializer->polymorphing() != QtJsonSerializer::SerializerBase::Polymorphing::Forced;
+}
+
+//! Reads a value using only the serializer
+template <typename T, typename TValue>
+inline T readGeneric(const TValue &value, QtJsonSerializer::SerializerBase *serializer, QObject *parent = nullptr) {
+	return serializer->deserializeGeneric(value, qMetaTypeId<T>(), parent).template value<T>();
+}
+
+//! Writes a value to CBOR using only the serializer
+template <typename T>
+QCborValue writeGenericCbor(const T &value, QtJsonSerializer::SerializerBase *serializer);
+//! Writes a value to JSON using only the serializer
+template <typename T>
+QJsonValue writeGenericJson(const T &value, QtJsonSerializer::SerializerBase *serializer);
+
+//! Reads a value from CBOR, using the fast path for basic and generated types
+template <typename T>
+T read(const QCborValue &value, QtJsonSerializer::SerializerBase *serializer, QObject *parent = nullptr);
+//! Reads a value from JSON, using the fast path for basic and generated types
+template <typename T>
+T read(const QJsonValue &value, QtJsonSerializer::SerializerBase *serializer, QObject *parent = nullptr);
+//! Reads a value directly from a CBOR stream, or returns std::nullopt if only the serializer can read the data
+template <typename T>
+std::optional<T> readStream(QCborStreamReader &reader, QtJsonSerializer::SerializerBase *serializer, QObject *parent = nullptr);
+//! Reads the next map key from a CBOR stream. Keys that are not strings are skipped and returned as null string
+QString readStreamKey(QCborStreamReader &reader);
+//! Deletes all objects of a value that was read, but will not be used
+template <typename T>
+void discard(const T &value);
+//! Writes a value to CBOR, using the fast path for basic and generated types
+template <typename T>
+QCborValue writeCbor(const T &value, QtJsonSerializer::SerializerBase *serializer);
+//! Writes a value to JSON, using the fast path for basic and generated types
+template <typename T>
+QJsonValue writeJson(const T &value, QtJsonSerializer::SerializerBase *serializer);
+
+//! Deserializes reply data, preferring the generated deserializers over the serializer
+template <typename T>
+T deserialize(const std::variant<QCborValue, QJsonValue> &data, QtJsonSerializer::SerializerBase *serializer, QObject *parent = nullptr);
+//! Serializes a request body in the format of the serializer, preferring the generated serializers
+template <typename T>
+std::variant<QCborValue, QJsonValue> serialize(const T &value, QtJsonSerializer::SerializerBase *serializer);
+
+// ------------- Generic Implementation -------------
+
+namespace __private {
+
+template <typename T>
+inline bool inRange(qint64 value) {
+	if constexpr (sizeof(T) < sizeof(qint64) || std::is_signed_v<T>) {
+		return value >= static_cast<qint64>(std::numeric_limits<T>::min()) &&
+			   value <= static_cast<qint64>(std::numeric_limits<T>::max());
+	} else
+		return value >= 0;
+}
+
+template <typename T>
+constexpr bool isNativeInteger = std::is_integral_v<T> &&
+								 !std::is_same_v<T, bool> &&
+								 (sizeof(T) < sizeof(qint64) || std::is_signed_v<T>);
+
+template <typename T>
+struct IsList : public std::false_type {};
+
+template <typename T>
+struct IsList<QList<T>> : public std::true_type {
+	using Item = T;
+};
+
+inline std::optional<qint64> readStreamInteger(const QCborStreamReader &reader) {
+	// integers outside of the qint64 range become doubles in a QCborValue, so they are left to it
+	constexpr auto maxValue = static_cast<quint64>(std::numeric_limits<qint64>::max());
+	if (reader.isUnsignedInteger() && reader.toUnsignedInteger() <= maxValue)
+		return static_cast<qint64>(reader.toUnsignedInteger());
+	else if (reader.isNegativeInteger() && static_cast<quint64>(reader.toNegativeInteger()) <= maxValue + 1)
+		return reader.toInteger();
+	else
+		return std::nullopt;
+}
+
+inline QString readStreamString(QCborStreamReader &reader) {
+	QString result{QLatin1String{""}};
+	auto chunk = reader.readString();
+	while (chunk.status == QCborStreamReader::Ok) {
+		result.append(chunk.data);
+		chunk = reader.readString();
+	}
+	return result;
+}
+
+}
+
+template <typename T>
+QCborValue writeGenericCbor(const T &value, QtJsonSerializer::SerializerBase *serializer)
+{
+	const auto data = serializer->serializeGeneric(QVariant::fromValue(value));
+	if (const auto cValue = std::get_if<QCborValue>(&data); cValue)
+		return *cValue;
+	else
+		return QCborValue::fromJsonValue(std::get<QJsonValue>(data));
+}
+
+template <typename T>
+QJsonValue writeGenericJson(const T &value, QtJsonSerializer::SerializerBase *serializer)
+{
+	const auto data = serializer->serializeGeneric(QVariant::fromValue(value));
+	if (const auto jValue = std::get_if<QJsonValue>(&data); jValue)
+		return *jValue;
+	else
+		return std::get<QCborValue>(data).toJsonValue();
+}
+
+template <typename T>
+T read(const QCborValue &value, QtJsonSerializer::SerializerBase *serializer, QObject *parent)
+{
+	if constexpr (std::is_same_v<T, bool>) {
+		if (value.isBool())
+			return value.toBool();
+	} else if constexpr (__private::isNativeInteger<T>) {
+		if (value.isInteger() && __private::inRange<T>(value.toInteger()))
+			return static_cast<T>(value.toInteger());
+	} else if constexpr (std::is_floating_point_v<T>) {
+		if (value.isDouble() || value.isInteger())
+			return static_cast<T>(value.toDouble());
+	} else if constexpr (std::is_same_v<T, QString>) {
+		if (value.isString())
+			return value.toString();
+	} else if constexpr (HasCodec<T>::value) {
+		return std::remove_pointer_t<T>::fromCbor(value, serializer, parent);
+	}
+	return readGeneric<T>(value, serializer, parent);
+}
+
+template <typename T>
+T read(const QJsonValue &value, QtJsonSerializer::SerializerBase *serializer, QObject *parent)
+{
+	if constexpr (std::is_same_v<T, bool>) {
+		if (value.isBool())
+			return value.toBool();
+	} else if constexpr (__private::isNativeInteger<T>) {
+		if (value.isDouble()) {
+			const auto dValue = value.toDouble();
+			if (std::trunc(dValue) == dValue &&
+				dValue >= static_cast<double>(std::numeric_limits<qint64>::min()) &&
+				dValue < static_cast<double>(std::numeric_limits<qint64>::max()) &&
+				__private::inRange<T>(static_cast<qint64>(dValue)))
+				return static_cast<T>(dValue);
+		}
+	} else if constexpr (std::is_floating_point_v<T>) {
+		if (value.isDouble())
+			return static_cast<T>(value.toDouble());
+	} else if constexpr (std::is_same_v<T, QString>) {
+		if (value.isString())
+			return value.toString();
+	} else if constexpr (HasCodec<T>::value) {
+		return std::remove_pointer_t<T>::fromJson(value, serializer, parent);
+	}
+	return readGeneric<T>(value, serializer, parent);
+}
+
+template <typename T>
+std::optional<T> readStream(QCborStreamReader &reader, QtJsonSerializer::SerializerBase *serializer, QObject *parent)
+{
+	if constexpr (std::is_same_v<T, bool>) {
+		if (reader.isBool()) {
+			const auto value = reader.toBool();
+			reader.next();
+			return value;
+		}
+	} else if constexpr (__private::isNativeInteger<T>) {
+		if (const auto value = __private::readStreamInteger(reader); value && __private::inRange<T>(*value)) {
+			reader.next();
+			return static_cast<T>(*value);
+		}
+	} else if constexpr (std::is_floating_point_v<T>) {
+		std::optional<double> value;
+		if (reader.isDouble())
+			value = reader.toDouble();
+		else if (reader.isFloat())
+			value = static_cast<double>(reader.toFloat());
+		else if (const auto iValue = __private::readStreamInteger(reader); iValue)
+			value = static_cast<double>(*iValue);
+		if (value) {
+			reader.next();
+			return static_cast<T>(*value);
+		}
+	} else if constexpr (std::is_same_v<T, QString>) {
+		if (reader.isString())
+			return __private::readStreamString(reader);
+	} else if constexpr (__private::IsList<T>::value && HasStreamCodec<T>::value) {
+		if (reader.isArray()) {
+			T list;
+			reader.enterContainer();
+			while (reader.lastError() == QCborError::NoError && reader.hasNext()) {
+				auto item = readStream<typename __private::IsList<T>::Item>(reader, serializer, parent);
+				if (!item) {
+					discard(list);
+					return std::nullopt;
+				}
+				list.append(std::move(*item));
+			}
+			if (reader.lastError() == QCborError::NoError)
+				reader.leaveContainer();
+			return list;
+		}
+	} else if constexpr (HasStreamCodec<T>::value) {
+		return std::remove_pointer_t<T>::fromCborStream(reader, serializer, parent);
+	}
+	// anything else is read as value first, which only builds the document of this single element
+	return read<T>(QCborValue::fromCbor(reader), serializer, parent);
+}
+
+inline QString readStreamKey(QCborStreamReader &reader)
+{
+	if (reader.isString())
+		return __private::readStreamString(reader);
+	reader.next();
+	return QString{};
+}
+
+template <typename T>
+void discard(const T &value)
+{
+	if constexpr (std::is_pointer_v<T>)
+		delete value;
+	else if constexpr (__private::IsList<T>::value) {
+		for (const auto &item : value)
+			discard(item);
+	}
+}
+
+template <typename T>
+QCborValue writeCbor(const T &value, QtJsonSerializer::SerializerBase *serializer)
+{
+	if constexpr (std::is_same_v<T, bool> || std::is_floating_point_v<T> || std::is_same_v<T, QString>)
+		return QCborValue{value};
+	else if constexpr (__private::isNativeInteger<T>)
+		return QCborValue{static_cast<qint64>(value)};
+	else if constexpr (HasCodec<T>::value) {
+		if constexpr (std::is_pointer_v<T>)
+			return value ? value->toCbor(serializer) : QCborValue{QCborValue::Null};
+		else
+			return value.toCbor(serializer);
+	} else
+		return writeGenericCbor(value, serializer);
+}
+
+template <typename T>
+QJsonValue writeJson(const T &value, QtJsonSerializer::SerializerBase *serializer)
+{
+	if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, QString>)
+		return QJsonValue{value};
+	else if constexpr (std::is_floating_point_v<T> || __private::isNativeInteger<T>)
+		return QJsonValue{static_cast<double>(value)};
+	else if constexpr (HasCodec<T>::value) {
+		if constexpr (std::is_pointer_v<T>)
+			return value ? value->toJson(serializer) : QJsonValue{QJsonValue::Null};
+		else
+			return value.toJson(serializer);
+	} else
+		return writeGenericJson(value, serializer);
+}
+
+template <typename T>
+T deserialize(const std::variant<QCborValue, QJsonValue> &data, QtJsonSerializer::SerializerBase *serializer, QObject *parent)
+{
+	if constexpr (HasCodec<T>::value) {
+		return std::visit([&](const auto &value) {
+			return read<T>(value, serializer, parent);
+		}, data);
+	} else
+		return readGeneric<T>(data, serializer, parent);
+}
+
+template <typename T>
+std::variant<QCborValue, QJsonValue> serialize(const T &value, QtJsonSerializer::SerializerBase *serializer)
+{
+	if constexpr (HasCodec<T>::value) {
+		if (qobject_cast<QtJsonSerializer::JsonSerializer*>(serializer))
+			return writeJson<T>(value, serializer);
+		else
+			return writeCbor<T>(value, serializer);
+	} else
+		return serializer->serializeGeneric(QtJsonSerializer::__private::variant_helper<T>::toVariant(value));
+}
+
+}
+
+}
+
+#endif // QTRESTCLIENT_GENERATEDCODEC_H
@@ -6,7 +6,9 @@
 #include "QtRestClient/restreply.h"
 #include "QtRestClient/paging_fwd.h"
 #include "QtRestClient/metacomponent.h"
+#include "QtRestClient/generatedcodec.h"
 
+#include <optional>
 #include <type_traits>
 
 #include <QtJsonSerializer/serializerbase.h>
@@ -59,6 +61,10 @@ public:
 
 	//! @copybrief QtRestClient::RestReply::awaitable
 	GenericRestReplyAwaitable<DataClassType, ErrorClassType> awaitable();
+#ifdef QT_RESTCLIENT_USE_COROUTINES
+	//! Makes the reply awaitable in C++20 coroutines
+	GenericRestReplyAwaitable<DataClassType, ErrorClassType> operator co_await();
+#endif
 
 protected:
 	//! @private
@@ -93,11 +99,20 @@ public:
 					 RestClient *client,
 					 QObject *parent = nullptr);
 #endif
+	~GenericRestReply() override;
 
 	//! @copybrief RestReply::onSucceeded(TFn&&)
-	GenericRestReply<DataClassType, ErrorClassType> *onSucceeded(std::function<void(int, DataClassType)> handler);
-	//! @copybrief GenericRestReply::onSucceeded(std::function<void(int, DataClassType)>)
-	GenericRestReply<DataClassType, ErrorClassType> *onSucceeded(QObject *scope, std::function<void(int, DataClassType)> handler);
+	template <typename TFn>
+	GenericRestReply<DataClassType, ErrorClassType> *onSucceeded(TFn &&handler);
+	//! @copybrief GenericRestReply::onSucceeded(TFn&&)
+	template <typename TFn>
+	GenericRestReply<DataClassType, ErrorClassType> *onSucceeded(QObject *scope, TFn &&handler);
+
+private:
+	int _successHandlers = 0;
+	std::optional<DataClassType> _streamedData;
+
+	bool decodeStream(QCborStreamReader &reader);
 };
 
 //! @note This class is a simple specialization for replies withput a result. It behaves the same as a normal GenericRestReply, however,
@@ -118,10 +133,12 @@ public:
 					 QObject *parent = nullptr);
 #endif
 
-	//! @copydoc GenericRestReply::onSucceeded(std::function<void(int, DataClassType)>)
-	GenericRestReply<void, ErrorClassType> *onSucceeded(std::function<void(int)> handler);
-	//! @copydoc GenericRestReply::onSucceeded(QObject*, std::function<void(int, DataClassType)>)
-	GenericRestReply<void, ErrorClassType> *onSucceeded(QObject *scope, std::function<void(int)> handler);
+	//! @copydoc GenericRestReply::onSucceeded(TFn&&)
+	template <typename TFn>
+	GenericRestReply<void, ErrorClassType> *onSucceeded(TFn &&handler);
+	//! @copydoc GenericRestReply::onSucceeded(QObject*, TFn&&)
+	template <typename TFn>
+	GenericRestReply<void, ErrorClassType> *onSucceeded(QObject *scope, TFn &&handler);
 };
 
 //! @note This class is a simple specialization for paging types. It behaves the same as a normal GenericRestReply, however,
@@ -144,10 +161,12 @@ public:
 					 QObject *parent = nullptr);
 #endif
 
-	//! @copydoc GenericRestReply::onSucceeded(std::function<void(int, DataClassType)>)
-	GenericRestReply<Paging<DataClassType>, ErrorClassType> *onSucceeded(std::function<void(int, Paging<DataClassType>)> handler);
-	//! @copydoc GenericRestReply::onSucceeded(QObject*, std::function<void(int, DataClassType)>)
-	GenericRestReply<Paging<DataClassType>, ErrorClassType> *onSucceeded(QObject *scope, std::function<void(int, Paging<DataClassType>)> handler);
+	//! @copydoc GenericRestReply::onSucceeded(TFn&&)
+	template <typename TFn>
+	GenericRestReply<Paging<DataClassType>, ErrorClassType> *onSucceeded(TFn &&handler);
+	//! @copydoc GenericRestReply::onSucceeded(QObject*, TFn&&)
+	template <typename TFn>
+	GenericRestReply<Paging<DataClassType>, ErrorClassType> *onSucceeded(QObject *scope, TFn &&handler);
 
 	//! shortcut to iterate over all elements via paging objects
 	GenericRestReply<Paging<DataClassType>, ErrorClassType> *iterate(std::function<bool(DataClassType, qint64)> iterator,
@@ -194,7 +213,7 @@ typename GenericRestReplyBase<DataClassType, ErrorClassType>::TInstance *Generic
 					   },
 					   [&](auto data) {
 						   try {
-							   xHandler(code, _client->serializer()->deserializeGeneric(data, qMetaTypeId<ErrorClassType>()).template value<ErrorClassType>());
+							   xHandler(code, GeneratedCodec::deserialize<ErrorClassType>(data, _client->serializer()));
 						   } catch (QtJsonSerializer::DeserializationException &e) {
 							   if (_exceptionHandler)
 								   _exceptionHandler(e);
@@ -283,19 +302,25 @@ template <typename DataClassType, typename ErrorClassType>
 GenericRestReplyBase<DataClassType, ErrorClassType>::GenericRestReplyBase(QNetworkReply *networkReply, RestClient *client, QObject *parent) :
 	RestReply{networkReply, client->asyncPool(), parent},
 	_client{client}
-{}
+{
+	this->setupClient(client);
+}
 
 template<typename DataClassType, typename ErrorClassType>
 GenericRestReplyBase<DataClassType, ErrorClassType>::GenericRestReplyBase(const QFuture<QNetworkReply*> &networkReplyFuture, RestClient *client, QObject *parent) :
 	RestReply{networkReplyFuture, client->asyncPool(), parent},
 	_client{client}
-{}
+{
+	this->setupClient(client);
+}
 #else
 template <typename DataClassType, typename ErrorClassType>
 GenericRestReplyBase<DataClassType, ErrorClassType>::GenericRestReplyBase(QNetworkReply *networkReply, RestClient *client, QObject *parent) :
 	RestReply{networkReply, parent},
 	_client{client}
-{}
+{
+	this->setupClient(client);
+}
 #endif
 
 // ------------- Implementation Single Element -------------
@@ -313,22 +338,50 @@ GenericRestReply<DataClassType, ErrorClassType>::GenericRestReply(const QFuture<
 #endif
 
 template<typename DataClassType, typename ErrorClassType>
-GenericRestReply<DataClassType, ErrorClassType> *GenericRestReply<DataClassType, ErrorClassType>::onSucceeded(std::function<void (int, DataClassType)> handler)
+GenericRestReply<DataClassType, ErrorClassType>::~GenericRestReply()
+{
+	// only set if the handler was disconnected before the data could be passed to it
+	if (_streamedData)
+		GeneratedCodec::discard(*_streamedData);
+}
+
+template<typename DataClassType, typename ErrorClassType>
+template<typename TFn>
+GenericRestReply<DataClassType, ErrorClassType> *GenericRestReply<DataClassType, ErrorClassType>::onSucceeded(TFn &&handler)
 {
-	return onSucceeded(this, std::move(handler));
+	return onSucceeded(this, std::forward<TFn>(handler));
 }
 
 template<typename DataClassType, typename ErrorClassType>
-GenericRestReply<DataClassType, ErrorClassType> *GenericRestReply<DataClassType, ErrorClassType>::onSucceeded(QObject *scope, std::function<void (int, DataClassType)> handler)
+template<typename TFn>
+GenericRestReply<DataClassType, ErrorClassType> *GenericRestReply<DataClassType, ErrorClassType>::onSucceeded(QObject *scope, TFn &&handler)
 {
-	RestReply::onSucceeded(scope, [this, xFn = std::move(handler)](int code, const RestReply::DataType &value){
+	// typed CBOR data can be read straight from the stream, but only once, i.e. for a single handler
+	if constexpr (GeneratedCodec::HasStreamCodec<DataClassType>::value) {
+		if (++_successHandlers == 1) {
+			this->setCborDecoder([this](QCborStreamReader &reader) {
+				return decodeStream(reader);
+			});
+		} else
+			this->setCborDecoder({});
+	}
+
+	// the handler is stored as is in the slot object and receives the deserialized data as rvalue
+	RestReply::onSucceeded(scope, [this, xFn = std::forward<TFn>(handler)](int code, const RestReply::DataType &value) mutable {
+		if (_streamedData) {
+			auto data = std::move(*_streamedData);
+			_streamedData.reset();
+			xFn(code, std::move(data));
+			return;
+		}
+
 		try {
 			std::visit(__private::overload {
 						   [&](std::nullopt_t) {
 							   xFn(code, DataClassType{});
 						   },
 						   [&](const auto &data) {
-							   xFn(code, this->_client->serializer()->deserializeGeneric(data, qMetaTypeId<DataClassType>()).template value<DataClassType>());
+							   xFn(code, GeneratedCodec::deserialize<DataClassType>(data, this->_client->serializer()));
 						   }
 					   }, value);
 		} catch (QtJsonSerializer::DeserializationException &e) {
@@ -339,6 +392,22 @@ GenericRestReply<DataClassType, ErrorClassType> *GenericRestReply<DataClassType,
 	return this;
 }
 
+template<typename DataClassType, typename ErrorClassType>
+bool GenericRestReply<DataClassType, ErrorClassType>::decodeStream(QCborStreamReader &reader)
+{
+	try {
+		auto data = GeneratedCodec::readStream<DataClassType>(reader, this->_client->serializer());
+		if (data && reader.lastError() == QCborError::NoError) {
+			_streamedData = std::move(data);
+			return true;
+		} else if (data)
+			GeneratedCodec::discard(*data);
+	} catch (QtJsonSerializer::DeserializationException &) {
+		// reported by the handler, which deserializes the document the reply falls back to
+	}
+	return false;
+}
+
 // ------------- Implementation void -------------
 
 template<typename ErrorClassType>
@@ -358,15 +427,19 @@ GenericRestReply<void, ErrorClassType>::GenericRestReply(const QFuture<QNetworkR
 #endif
 
 template<typename ErrorClassType>
-GenericRestReply<void, ErrorClassType> *GenericRestReply<void, ErrorClassType>::onSucceeded(std::function<void (int)> handler)
+template<typename TFn>
+GenericRestReply<void, ErrorClassType> *GenericRestReply<void, ErrorClassType>::onSucceeded(TFn &&handler)
 {
-	return onSucceeded(this, std::move(handler));
+	return onSucceeded(this, std::forward<TFn>(handler));
 }
 
 template<typename ErrorClassType>
-GenericRestReply<void, ErrorClassType> *GenericRestReply<void, ErrorClassType>::onSucceeded(QObject *scope, std::function<void (int)> handler)
+template<typename TFn>
+GenericRestReply<void, ErrorClassType> *GenericRestReply<void, ErrorClassType>::onSucceeded(QObject *scope, TFn &&handler)
 {
-	RestReply::onSucceeded(scope, std::move(handler));
+	RestReply::onSucceeded(scope, [xFn = std::forward<TFn>(handler)](int code, const RestReply::DataType &) mutable {
+		xFn(code);
+	});
 	return this;
 }
 
@@ -385,33 +458,36 @@ GenericRestReply<Paging<DataClassType>, ErrorClassType>::GenericRestReply(const
 #endif
 
 template<typename DataClassType, typename ErrorClassType>
-GenericRestReply<Paging<DataClassType>, ErrorClassType> *GenericRestReply<Paging<DataClassType>, ErrorClassType>::onSucceeded(std::function<void (int, Paging<DataClassType>)> handler)
+template<typename TFn>
+GenericRestReply<Paging<DataClassType>, ErrorClassType> *GenericRestReply<Paging<DataClassType>, ErrorClassType>::onSucceeded(TFn &&handler)
 {
-	return onSucceeded(this, handler);
+	return onSucceeded(this, std::forward<TFn>(handler));
 }
 
 template<typename DataClassType, typename ErrorClassType>
-GenericRestReply<Paging<DataClassType>, ErrorClassType> *GenericRestReply<Paging<DataClassType>, ErrorClassType>::onSucceeded(QObject *scope, std::function<void (int, Paging<DataClassType>)> handler)
+template<typename TFn>
+GenericRestReply<Paging<DataClassType>, ErrorClassType> *GenericRestReply<Paging<DataClassType>, ErrorClassType>::onSucceeded(QObject *scope, TFn &&handler)
 {
-	RestReply::onSucceeded(scope, [this, xFn = std::move(handler)](int code, const RestReply::DataType &value){
+	RestReply::onSucceeded(scope, [this, xFn = std::forward<TFn>(handler)](int code, const RestReply::DataType &value) mutable {
 		try {
 			std::visit(__private::overload {
 						   [&](std::nullopt_t) {
 							   xFn(code, Paging<DataClassType>{});
 						   },
 						   [&](const auto &data) {
-							   auto iPaging = this->_client->pagingFactory()->createPaging(this->_client->serializer(), data);
-							   auto pData = this->_client->serializer()->deserializeGeneric(std::visit(__private::overload {
-																										   [](const QCborArray &innerData) -> std::variant<QCborValue, QJsonValue> {
-																											   return QCborValue{innerData};
-																										   },
-																										   [](const QJsonArray &innerData) -> std::variant<QCborValue, QJsonValue> {
-																											   return QJsonValue{innerData};
-																										   }
-																									   }, iPaging->items()),
-																							qMetaTypeId<QList<DataClassType>>())
-												.template value<QList<DataClassType>>();
-							   xFn(code, Paging<DataClassType>(iPaging, std::move(pData), this->_client));
+							   const auto nReply = this->networkReply();
+							   const auto requestUrl = nReply ? nReply->url() : QUrl{};
+							   auto iPaging = this->_client->pagingFactory()->createPagingFromReply(this->_client->serializer(), data, this->responseHeaders(), requestUrl);
+							   // deserialize straight from the items of the paging, without an intermediate list conversion
+							   QList<DataClassType> pData;
+							   std::visit([&](const auto &items) {
+								   using TItem = typename std::decay_t<decltype(items)>::value_type;
+								   pData.reserve(items.size());
+								   for (const auto &item : items) {
+									   pData.append(GeneratedCodec::deserialize<DataClassType>(TItem{item}, this->_client->serializer()));
+								   }
+							   }, iPaging->items());
+							   xFn(code, Paging<DataClassType>(iPaging, std::move(pData), this->_client, requestUrl));
 						   }
 					   }, value);
 		} catch (QtJsonSerializer::DeserializationException &e) {
@@ -1,5 +1,6 @@
 #include "ipaging.h"
 #include <limits>
+#include <QtCore/QUrlQuery>
 using namespace QtRestClient;
 
 IPaging::IPaging() = default;
@@ -26,10 +27,62 @@ QUrl IPaging::previous() const
 	return QUrl();
 }
 
+QUrl IPaging::nextUrl(const QUrl &requestUrl) const
+{
+	if (const auto url = next(); url.isValid())
+		return url;
+
+	const auto pagingCursor = dynamic_cast<const IPagingCursor*>(this);
+	if (!pagingCursor)
+		return QUrl();
+	const auto cursor = pagingCursor->nextCursor();
+	if (!cursor.isValid())
+		return QUrl();
+
+	const auto parameter = pagingCursor->cursorParameter();
+	auto url = requestUrl;
+	QUrlQuery query{url};
+	query.removeAllQueryItems(parameter);
+	query.addQueryItem(parameter, cursor.toString());
+	url.setQuery(query);
+	return url;
+}
+
+IPagingCursor::IPagingCursor() = default;
+
+IPagingCursor::~IPagingCursor() = default;
+
+QString IPagingCursor::cursorParameter() const
+{
+	return QStringLiteral("cursor");
+}
+
 IPagingFactory::IPagingFactory() = default;
 
 IPagingFactory::~IPagingFactory() = default;
 
+#ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
+IPaging *IPagingFactory::createPagingFromReply(QtJsonSerializer::SerializerBase *serializer, const std::variant<QCborValue, QJsonValue> &data, const HeaderHash &headers, const QUrl &requestUrl) const
+{
+	if (const auto headerFactory = dynamic_cast<const IPagingHeaderFactory*>(this); headerFactory)
+		return headerFactory->createPagingWithHeaders(serializer, data, headers, requestUrl);
+	else
+		return createPaging(serializer, data);
+}
+#else
+IPaging *IPagingFactory::createPagingFromReply(const std::variant<QCborValue, QJsonValue> &data, const HeaderHash &headers, const QUrl &requestUrl) const
+{
+	if (const auto headerFactory = dynamic_cast<const IPagingHeaderFactory*>(this); headerFactory)
+		return headerFactory->createPagingWithHeaders(data, headers, requestUrl);
+	else
+		return createPaging(data);
+}
+#endif
+
+IPagingHeaderFactory::IPagingHeaderFactory() = default;
+
+IPagingHeaderFactory::~IPagingHeaderFactory() = default;
+
 std::variant<QCborArray, QJsonArray> ICborPaging::items() const
 {
 	return cborItems();
@@ -45,6 +45,25 @@ public:
 	virtual QVariantMap properties() const = 0;
 	//! Returns the original JSON element parsed
 	virtual std::variant<QCborValue, QJsonValue> originalData() const = 0;
+
+	//! Returns the link to the next paging object, resolving cursors against the request
+	QUrl nextUrl(const QUrl &requestUrl) const;
+};
+
+//! Optional interface for paging objects that link to the next paging via an opaque cursor
+class Q_RESTCLIENT_EXPORT IPagingCursor
+{
+	Q_DISABLE_COPY(IPagingCursor)
+public:
+	IPagingCursor();
+	virtual ~IPagingCursor();
+
+	//! Returns the opaque cursor this paging object starts at
+	virtual QVariant cursor() const = 0;
+	//! Returns the opaque cursor of the next paging object
+	virtual QVariant nextCursor() const = 0;
+	//! Returns the name of the query parameter used to pass a cursor to the server
+	virtual QString cursorParameter() const;
 };
 
 //! Interface to parse generic CBOR paging objects and operate on them
@@ -88,6 +107,29 @@ public:
 #else
 	virtual IPaging *createPaging(const std::variant<QCborValue, QJsonValue> &data) const = 0;
 #endif
+
+	//! Creates a new paging object of the given data and the reply it was received with
+#ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
+	IPaging *createPagingFromReply(QtJsonSerializer::SerializerBase *serializer, const std::variant<QCborValue, QJsonValue> &data, const HeaderHash &headers, const QUrl &requestUrl) const;
+#else
+	IPaging *createPagingFromReply(const std::variant<QCborValue, QJsonValue> &data, const HeaderHash &headers, const QUrl &requestUrl) const;
+#endif
+};
+
+//! Optional interface for paging factories that read the headers of the reply as well
+class Q_RESTCLIENT_EXPORT IPagingHeaderFactory
+{
+	Q_DISABLE_COPY(IPagingHeaderFactory)
+public:
+	IPagingHeaderFactory();
+	virtual ~IPagingHeaderFactory();
+
+	//! Creates a new paging object of the given data and the reply it was received with
+#ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
+	virtual IPaging *createPagingWithHeaders(QtJsonSerializer::SerializerBase *serializer, const std::variant<QCborValue, QJsonValue> &data, const HeaderHash &headers, const QUrl &requestUrl) const = 0;
+#else
+	virtual IPaging *createPagingWithHeaders(const std::variant<QCborValue, QJsonValue> &data, const HeaderHash &headers, const QUrl &requestUrl) const = 0;
+#endif
 };
 
 }
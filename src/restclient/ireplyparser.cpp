@@ -0,0 +1,6 @@
+#include "ireplyparser.h"
+using namespace QtRestClient;
+
+IReplyParser::IReplyParser() = default;
+
+IReplyParser::~IReplyParser() = default;
@@ -0,0 +1,43 @@
+#ifndef QTRESTCLIENT_IREPLYPARSER_H
+#define QTRESTCLIENT_IREPLYPARSER_H
+
+#include "QtRestClient/qtrestclient_global.h"
+#include "QtRestClient/restreply.h"
+
+#include <variant>
+
+#include <QtCore/qbytearraylist.h>
+#include <QtCore/qiodevice.h>
+
+namespace QtRestClient {
+
+//! Interface to parse the bodies of replies with a certain content type
+class Q_RESTCLIENT_EXPORT IReplyParser
+{
+	Q_DISABLE_COPY(IReplyParser)
+public:
+	//! Describes why the body of a reply could not be parsed
+	struct ParseError {
+		//! The error code, passed to the RestReply::error signal
+		int code = -1;
+		//! A description of the error
+		QString errorString;
+	};
+
+	//! The data the parser returns, the same as the data of a RestReply
+	using DataType = RestReply::DataType;
+	//! The result of parsing a reply, either the parsed data or an error
+	using Result = std::variant<DataType, ParseError>;
+
+	IReplyParser();
+	virtual ~IReplyParser();
+
+	//! Returns the content types the parser can read, without any parameters
+	virtual QByteArrayList contentTypes() const = 0;
+	//! Parses the complete body of a reply with one of the content types
+	virtual Result parse(QIODevice *device, const QByteArray &contentType) const = 0;
+};
+
+}
+
+#endif // QTRESTCLIENT_IREPLYPARSER_H
@@ -0,0 +1,523 @@
+#include "contentcodecregistry_p.h"
+
+#include <cstring>
+#include <limits>
+
+#include <QtCore/QCborArray>
+#include <QtCore/QCborMap>
+#include <QtCore/QDateTime>
+#include <QtCore/QtEndian>
+using namespace QtRestClient;
+
+namespace {
+
+constexpr auto MaxDepth = 512;
+constexpr qint8 TimestampExtension = -1;
+constexpr qint64 NanosecondsPerSecond = 1000000000;
+
+class MessagePackReader
+{
+public:
+	explicit MessagePackReader(const QByteArray &data);
+
+	std::optional<QCborValue> read(int depth = 0);
+	bool atEnd() const;
+	QString errorString() const;
+
+private:
+	const QByteArray &_data;
+	QByteArray::size_type _pos = 0;
+	QString _errorString;
+
+	std::nullopt_t fail(const QString &error);
+	bool ensure(quint64 size);
+	template <typename T>
+	std::optional<T> readBig();
+	std::optional<quint32> readLength(int sizeClass);
+
+	std::optional<QCborValue> readString(std::optional<quint32> size);
+	std::optional<QCborValue> readBinary(std::optional<quint32> size);
+	std::optional<QCborValue> readArray(std::optional<quint32> size, int depth);
+	std::optional<QCborValue> readMap(std::optional<quint32> size, int depth);
+	std::optional<QCborValue> readExtension(std::optional<quint32> size);
+};
+
+class MessagePackWriter
+{
+public:
+	QByteArray data;
+
+	bool write(const QCborValue &value, int depth = 0);
+
+private:
+	template <typename T>
+	void appendBig(T value);
+	template <typename T>
+	void writeBig(quint8 marker, T value);
+	void writeInteger(qint64 value);
+	void writeLength(quint32 size, quint8 fixMarker, quint32 fixMax, quint8 marker8, quint8 marker16, quint8 marker32);
+	void writeTimestamp(const QDateTime &dateTime);
+};
+
+}
+
+const QByteArray MessagePackContentCodec::ContentType = "application/msgpack";
+
+QByteArrayList MessagePackContentCodec::contentTypes() const
+{
+	return {
+		ContentType,
+		"application/x-msgpack",
+		"application/vnd.msgpack"
+	};
+}
+
+IReplyParser::Result MessagePackContentCodec::parse(QIODevice *device, const QByteArray &contentType) const
+{
+	Q_UNUSED(contentType)
+	const auto readData = device->readAll();
+	MessagePackReader reader{readData};
+	auto value = reader.read();
+	if (!value)
+		return ParseError{-1, reader.errorString()};
+	else if (!reader.atEnd())
+		return ParseError{-1, QStringLiteral("Unexpected data after the MessagePack value")};
+	else
+		return DataType{std::move(*value)};
+}
+
+std::optional<QByteArray> MessagePackContentCodec::encode(const EncodeType &data, const QByteArray &contentType) const
+{
+	Q_UNUSED(contentType)
+	const auto value = std::holds_alternative<QJsonValue>(data) ?
+		QCborValue::fromJsonValue(std::get<QJsonValue>(data)) :
+		std::get<QCborValue>(data);
+	MessagePackWriter writer;
+	if (writer.write(value))
+		return writer.data;
+	else
+		return std::nullopt;
+}
+
+// ------------- Reader Implementation -------------
+
+namespace {
+
+MessagePackReader::MessagePackReader(const QByteArray &data) :
+	_data{data}
+{}
+
+std::optional<QCborValue> MessagePackReader::read(int depth)
+{
+	if (depth > MaxDepth)
+		return fail(QStringLiteral("Maximum nesting depth exceeded"));
+
+	const auto marker = readBig<quint8>();
+	if (!marker)
+		return std::nullopt;
+
+	const auto m = *marker;
+	if (m <= 0x7f)  // positive fixint
+		return QCborValue{static_cast<qint64>(m)};
+	else if (m >= 0xe0)  // negative fixint
+		return QCborValue{static_cast<qint64>(static_cast<qint8>(m))};
+	else if ((m & 0xf0) == 0x80)
+		return readMap(m & 0x0f, depth);
+	else if ((m & 0xf0) == 0x90)
+		return readArray(m & 0x0f, depth);
+	else if ((m & 0xe0) == 0xa0)
+		return readString(m & 0x1f);
+
+	switch (m) {
+	case 0xc0:
+		return QCborValue{QCborValue::Null};
+	case 0xc2:
+		return QCborValue{false};
+	case 0xc3:
+		return QCborValue{true};
+	case 0xc4:
+	case 0xc5:
+	case 0xc6:
+		return readBinary(readLength(m - 0xc4));
+	case 0xc7:
+	case 0xc8:
+	case 0xc9:
+		return readExtension(readLength(m - 0xc7));
+	case 0xca: {
+		const auto bits = readBig<quint32>();
+		if (!bits)
+			return std::nullopt;
+		float value;
+		std::memcpy(&value, &*bits, sizeof(value));
+		return QCborValue{static_cast<double>(value)};
+	}
+	case 0xcb: {
+		const auto bits = readBig<quint64>();
+		if (!bits)
+			return std::nullopt;
+		double value;
+		std::memcpy(&value, &*bits, sizeof(value));
+		return QCborValue{value};
+	}
+	case 0xcc: {
+		const auto value = readBig<quint8>();
+		return value ? std::make_optional(QCborValue{static_cast<qint64>(*value)}) : std::nullopt;
+	}
+	case 0xcd: {
+		const auto value = readBig<quint16>();
+		return value ? std::make_optional(QCborValue{static_cast<qint64>(*value)}) : std::nullopt;
+	}
+	case 0xce: {
+		const auto value = readBig<quint32>();
+		return value ? std::make_optional(QCborValue{static_cast<qint64>(*value)}) : std::nullopt;
+	}
+	case 0xcf: {
+		const auto value = readBig<quint64>();
+		if (!value)
+			return std::nullopt;
+		else if (*value > static_cast<quint64>(std::numeric_limits<qint64>::max()))
+			return fail(QStringLiteral("Unsigned integer %1 is out of range").arg(*value));
+		else
+			return QCborValue{static_cast<qint64>(*value)};
+	}
+	case 0xd0: {
+		const auto value = readBig<qint8>();
+		return value ? std::make_optional(QCborValue{static_cast<qint64>(*value)}) : std::nullopt;
+	}
+	case 0xd1: {
+		const auto value = readBig<qint16>();
+		return value ? std::make_optional(QCborValue{static_cast<qint64>(*value)}) : std::nullopt;
+	}
+	case 0xd2: {
+		const auto value = readBig<qint32>();
+		return value ? std::make_optional(QCborValue{static_cast<qint64>(*value)}) : std::nullopt;
+	}
+	case 0xd3: {
+		const auto value = readBig<qint64>();
+		return value ? std::make_optional(QCborValue{*value}) : std::nullopt;
+	}
+	case 0xd4:
+	case 0xd5:
+	case 0xd6:
+	case 0xd7:
+	case 0xd8:
+		return readExtension(1u << (m - 0xd4));
+	case 0xd9:
+	case 0xda:
+	case 0xdb:
+		return readString(readLength(m - 0xd9));
+	case 0xdc:
+	case 0xdd:
+		return readArray(readLength(m - 0xdc + 1), depth);
+	case 0xde:
+	case 0xdf:
+		return readMap(readLength(m - 0xde + 1), depth);
+	default:
+		return fail(QStringLiteral("Invalid marker 0x%1 at offset %2")
+						.arg(static_cast<int>(m), 2, 16, QLatin1Char('0'))
+						.arg(_pos - 1));
+	}
+}
+
+bool MessagePackReader::atEnd() const
+{
+	return _pos == _data.size();
+}
+
+QString MessagePackReader::errorString() const
+{
+	return _errorString;
+}
+
+std::nullopt_t MessagePackReader::fail(const QString &error)
+{
+	if (_errorString.isEmpty())
+		_errorString = error;
+	return std::nullopt;
+}
+
+bool MessagePackReader::ensure(quint64 size)
+{
+	if (static_cast<quint64>(_data.size() - _pos) >= size)
+		return true;
+	fail(QStringLiteral("Unexpected end of data at offset %1").arg(_pos));
+	return false;
+}
+
+template <typename T>
+std::optional<T> MessagePackReader::readBig()
+{
+	if (!ensure(sizeof(T)))
+		return std::nullopt;
+	T value;
+	if constexpr (sizeof(T) == 1)
+		value = static_cast<T>(_data[_pos]);
+	else
+		value = qFromBigEndian<T>(_data.constData() + _pos);
+	_pos += sizeof(T);
+	return value;
+}
+
+std::optional<quint32> MessagePackReader::readLength(int sizeClass)
+{
+	// 0: 8 bit, 1: 16 bit, 2: 32 bit
+	switch (sizeClass) {
+	case 0:
+		if (const auto size = readBig<quint8>(); size)
+			return *size;
+		break;
+	case 1:
+		if (const auto size = readBig<quint16>(); size)
+			return *size;
+		break;
+	case 2:
+		return readBig<quint32>();
+	default:
+		Q_UNREACHABLE();
+	}
+	return std::nullopt;
+}
+
+std::optional<QCborValue> MessagePackReader::readString(std::optional<quint32> size)
+{
+	if (!size || !ensure(*size))
+		return std::nullopt;
+	const auto value = QString::fromUtf8(_data.constData() + _pos, static_cast<QByteArray::size_type>(*size));
+	_pos += *size;
+	return QCborValue{value};
+}
+
+std::optional<QCborValue> MessagePackReader::readBinary(std::optional<quint32> size)
+{
+	if (!size || !ensure(*size))
+		return std::nullopt;
+	const auto value = _data.mid(_pos, static_cast<QByteArray::size_type>(*size));
+	_pos += *size;
+	return QCborValue{value};
+}
+
+std::optional<QCborValue> MessagePackReader::readArray(std::optional<quint32> size, int depth)
+{
+	// every element needs at least one byte, which rejects bogus sizes before reading anything
+	if (!size || !ensure(*size))
+		return std::nullopt;
+	QCborArray array;
+	for (quint32 i = 0; i < *size; ++i) {
+		auto element = read(depth + 1);
+		if (!element)
+			return std::nullopt;
+		array.append(std::move(*element));
+	}
+	return QCborValue{array};
+}
+
+std::optional<QCborValue> MessagePackReader::readMap(std::optional<quint32> size, int depth)
+{
+	if (!size || !ensure(static_cast<quint64>(*size) * 2))
+		return std::nullopt;
+	QCborMap map;
+	for (quint32 i = 0; i < *size; ++i) {
+		auto key = read(depth + 1);
+		if (!key)
+			return std::nullopt;
+		auto value = read(depth + 1);
+		if (!value)
+			return std::nullopt;
+		map.insert(std::move(*key), std::move(*value));
+	}
+	return QCborValue{map};
+}
+
+std::optional<QCborValue> MessagePackReader::readExtension(std::optional<quint32> size)
+{
+	if (!size)
+		return std::nullopt;
+	const auto type = readBig<qint8>();
+	if (!type || !ensure(*size))
+		return std::nullopt;
+	if (*type != TimestampExtension)
+		return fail(QStringLiteral("Unsupported extension type %1").arg(static_cast<int>(*type)));
+
+	qint64 seconds = 0;
+	qint64 nanoseconds = 0;
+	switch (*size) {
+	case 4:
+		seconds = *readBig<quint32>();
+		break;
+	case 8: {
+		const auto value = *readBig<quint64>();
+		nanoseconds = static_cast<qint64>(value >> 34);
+		seconds = static_cast<qint64>(value & 0x3ffffffffull);
+		break;
+	}
+	case 12:
+		nanoseconds = *readBig<quint32>();
+		seconds = *readBig<qint64>();
+		break;
+	default:
+		return fail(QStringLiteral("Invalid timestamp of size %1").arg(*size));
+	}
+
+	constexpr auto maxSeconds = std::numeric_limits<qint64>::max() / 1000 - 1;
+	if (nanoseconds >= NanosecondsPerSecond || seconds > maxSeconds || seconds < -maxSeconds)
+		return fail(QStringLiteral("Timestamp is out of range"));
+	return QCborValue{QDateTime::fromMSecsSinceEpoch(seconds * 1000 + nanoseconds / 1000000, Qt::UTC)};
+}
+
+// ------------- Writer Implementation -------------
+
+bool MessagePackWriter::write(const QCborValue &value, int depth)
+{
+	if (depth > MaxDepth)
+		return false;
+
+	switch (value.type()) {
+	case QCborValue::Integer:
+		writeInteger(value.toInteger());
+		return true;
+	case QCborValue::Double: {
+		const auto number = value.toDouble();
+		quint64 bits;
+		std::memcpy(&bits, &number, sizeof(bits));
+		writeBig<quint64>(0xcb, bits);
+		return true;
+	}
+	case QCborValue::False:
+		data.append(static_cast<char>(0xc2));
+		return true;
+	case QCborValue::True:
+		data.append(static_cast<char>(0xc3));
+		return true;
+	case QCborValue::Null:
+	case QCborValue::Undefined:
+		data.append(static_cast<char>(0xc0));
+		return true;
+	case QCborValue::ByteArray: {
+		const auto bytes = value.toByteArray();
+		writeLength(static_cast<quint32>(bytes.size()), 0, 0, 0xc4, 0xc5, 0xc6);
+		data.append(bytes);
+		return true;
+	}
+	case QCborValue::String: {
+		const auto utf8 = value.toString().toUtf8();
+		writeLength(static_cast<quint32>(utf8.size()), 0xa0, 31, 0xd9, 0xda, 0xdb);
+		data.append(utf8);
+		return true;
+	}
+	case QCborValue::Array: {
+		const auto array = value.toArray();
+		writeLength(static_cast<quint32>(array.size()), 0x90, 15, 0, 0xdc, 0xdd);
+		for (const auto &element : array) {
+			if (!write(element, depth + 1))
+				return false;
+		}
+		return true;
+	}
+	case QCborValue::Map: {
+		const auto map = value.toMap();
+		writeLength(static_cast<quint32>(map.size()), 0x80, 15, 0, 0xde, 0xdf);
+		for (auto it = map.constBegin(), end = map.constEnd(); it != end; ++it) {
+			if (!write(it.key(), depth + 1) || !write(it.value(), depth + 1))
+				return false;
+		}
+		return true;
+	}
+	case QCborValue::DateTime:
+		writeTimestamp(value.toDateTime());
+		return true;
+	default:
+		// urls, uuids and other tags are written as their plain value
+		if (value.isTag())
+			return write(value.taggedValue(), depth + 1);
+		else
+			return false;
+	}
+}
+
+template <typename T>
+void MessagePackWriter::appendBig(T value)
+{
+	if constexpr (sizeof(T) == 1)
+		data.append(static_cast<char>(value));
+	else {
+		char buffer[sizeof(T)];
+		qToBigEndian(value, buffer);
+		data.append(buffer, sizeof(T));
+	}
+}
+
+template <typename T>
+void MessagePackWriter::writeBig(quint8 marker, T value)
+{
+	data.append(static_cast<char>(marker));
+	appendBig<T>(value);
+}
+
+void MessagePackWriter::writeInteger(qint64 value)
+{
+	if (value >= 0) {
+		if (value <= 0x7f)
+			data.append(static_cast<char>(value));
+		else if (value <= std::numeric_limits<quint8>::max())
+			writeBig<quint8>(0xcc, static_cast<quint8>(value));
+		else if (value <= std::numeric_limits<quint16>::max())
+			writeBig<quint16>(0xcd, static_cast<quint16>(value));
+		else if (value <= std::numeric_limits<quint32>::max())
+			writeBig<quint32>(0xce, static_cast<quint32>(value));
+		else
+			writeBig<quint64>(0xcf, static_cast<quint64>(value));
+	} else {
+		if (value >= -32)
+			data.append(static_cast<char>(value));
+		else if (value >= std::numeric_limits<qint8>::min())
+			writeBig<qint8>(0xd0, static_cast<qint8>(value));
+		else if (value >= std::numeric_limits<qint16>::min())
+			writeBig<qint16>(0xd1, static_cast<qint16>(value));
+		else if (value >= std::numeric_limits<qint32>::min())
+			writeBig<qint32>(0xd2, static_cast<qint32>(value));
+		else
+			writeBig<qint64>(0xd3, value);
+	}
+}
+
+void MessagePackWriter::writeLength(quint32 size, quint8 fixMarker, quint32 fixMax, quint8 marker8, quint8 marker16, quint8 marker32)
+{
+	if (fixMarker != 0 && size <= fixMax)
+		data.append(static_cast<char>(fixMarker | size));
+	else if (marker8 != 0 && size <= std::numeric_limits<quint8>::max())
+		writeBig<quint8>(marker8, static_cast<quint8>(size));
+	else if (size <= std::numeric_limits<quint16>::max())
+		writeBig<quint16>(marker16, static_cast<quint16>(size));
+	else
+		writeBig<quint32>(marker32, size);
+}
+
+void MessagePackWriter::writeTimestamp(const QDateTime &dateTime)
+{
+	const auto msecs = dateTime.toMSecsSinceEpoch();
+	auto seconds = msecs / 1000;
+	auto nanoseconds = (msecs % 1000) * 1000000;
+	if (nanoseconds < 0) {
+		--seconds;
+		nanoseconds += NanosecondsPerSecond;
+	}
+
+	// use the smallest of the three timestamp formats that can hold the value
+	if (nanoseconds == 0 && seconds >= 0 && seconds <= std::numeric_limits<quint32>::max()) {
+		data.append(static_cast<char>(0xd6));
+		data.append(static_cast<char>(TimestampExtension));
+		appendBig<quint32>(static_cast<quint32>(seconds));
+	} else if (seconds >= 0 && seconds <= 0x3ffffffffll) {
+		data.append(static_cast<char>(0xd7));
+		data.append(static_cast<char>(TimestampExtension));
+		appendBig<quint64>((static_cast<quint64>(nanoseconds) << 34) | static_cast<quint64>(seconds));
+	} else {
+		data.append(static_cast<char>(0xc7));
+		data.append(static_cast<char>(12));
+		data.append(static_cast<char>(TimestampExtension));
+		appendBig<quint32>(static_cast<quint32>(nanoseconds));
+		appendBig<qint64>(seconds);
+	}
+}
+
+}
@@ -8,6 +8,8 @@
 #include <QtCore/qsharedpointer.h>
 #include <QtCore/qpointer.h>
 
+#include <atomic>
+
 // ------------- Generic Implementation -------------
 
 namespace QtRestClient {
@@ -24,6 +26,13 @@ public:
 	QSharedPointer<IPaging> iPaging;
 	QList<T> data;
 	QPointer<RestClient> client;
+	QUrl requestUrl;
+};
+
+struct ShardState
+{
+	std::atomic_bool canceled {false};
+	std::atomic<qint64> index {0};
 };
 
 }
@@ -46,12 +55,13 @@ template<typename T>
 Paging<T> &Paging<T>::operator=(Paging<T> &&other) noexcept = default;
 
 template<typename T>
-Paging<T>::Paging(IPaging *iPaging, const QList<T> &data, RestClient *client) :
+Paging<T>::Paging(IPaging *iPaging, const QList<T> &data, RestClient *client, const QUrl &requestUrl) :
 	d{new __private::PagingData<T>{}}
 {
 	d->iPaging.reset(iPaging);
 	d->data = data;
 	d->client = client;
+	d->requestUrl = requestUrl;
 }
 
 template<typename T>
@@ -95,7 +105,7 @@ template<typename EO>
 GenericRestReply<Paging<T>, EO> *Paging<T>::next() const
 {
 	if (d->iPaging->hasNext())
-		return d->client->rootClass()->template get<Paging<T>, EO>(d->iPaging->next());
+		return d->client->rootClass()->template get<Paging<T>, EO>(nextUrl());
 	else
 		return nullptr;
 }
@@ -103,7 +113,21 @@ GenericRestReply<Paging<T>, EO> *Paging<T>::next() const
 template<typename T>
 QUrl Paging<T>::nextUrl() const
 {
-	return d->iPaging->next();
+	return d->iPaging->nextUrl(d->requestUrl);
+}
+
+template<typename T>
+QVariant Paging<T>::cursor() const
+{
+	const auto pagingCursor = dynamic_cast<const IPagingCursor*>(d->iPaging.data());
+	return pagingCursor ? pagingCursor->cursor() : QVariant{};
+}
+
+template<typename T>
+QVariant Paging<T>::nextCursor() const
+{
+	const auto pagingCursor = dynamic_cast<const IPagingCursor*>(d->iPaging.data());
+	return pagingCursor ? pagingCursor->nextCursor() : QVariant{};
 }
 
 template<typename T>
@@ -141,7 +165,7 @@ void Paging<T>::iterate(const std::function<bool (T, qint64)> &iterator, qint64
 	auto max = calcMax(to);
 	if (index < max && d->iPaging->hasNext()) {
 		qCDebug(logPaging, "Requesting next paging object with offset %s as %s", QString::number(index), 
-				d->iPaging->next().toString(QUrl::PrettyDecoded | QUrl::RemoveUserInfo));
+				nextUrl().toString(QUrl::PrettyDecoded | QUrl::RemoveUserInfo));
 		next()->onSucceeded([iterator, to, index](int, const Paging<T> &paging) {
 			if (paging.isValid())
 				paging.iterate(iterator, to, index);
@@ -162,7 +186,7 @@ void Paging<T>::iterate(QObject *scope, const std::function<bool (T, qint64)> &i
 	auto max = calcMax(to);
 	if (index < max && d->iPaging->hasNext()) {
 		qCDebug(logPaging, "Requesting next paging object with offset %s as %s", QString::number(index),
-						   d->iPaging->next().toString(QUrl::PrettyDecoded | QUrl::RemoveUserInfo));
+						   nextUrl().toString(QUrl::PrettyDecoded | QUrl::RemoveUserInfo));
 		next()->onSucceeded(scope, [scope, iterator, to, index](int, const Paging<T> &paging) {
 			if (paging.isValid())
 				paging.iterate(scope, iterator, to, index);
@@ -184,7 +208,7 @@ void Paging<T>::iterate(const std::function<bool(T, qint64)> &iterator, const st
 	auto max = calcMax(to);
 	if (index < max && d->iPaging->hasNext()) {
 		qCDebug(logPaging, "Requesting next paging object with offset %s as %s", QString::number(index),
-						   d->iPaging->next().toString(QUrl::PrettyDecoded | QUrl::RemoveUserInfo));
+						   nextUrl().toString(QUrl::PrettyDecoded | QUrl::RemoveUserInfo));
 		next<EO>()->onSucceeded([iterator, errorHandler, failureTransformer, to, index](int, const Paging<T> &paging) {
 					  if (paging.isValid())
 						  paging.iterate(iterator, errorHandler, failureTransformer, to, index);
@@ -207,7 +231,7 @@ void Paging<T>::iterate(QObject *scope, const std::function<bool(T, qint64)> &it
 	auto max = calcMax(to);
 	if (index < max && d->iPaging->hasNext()) {
 		qCDebug(logPaging, "Requesting next paging object with offset %s as %s", QString::number(index),
-						   d->iPaging->next().toString(QUrl::PrettyDecoded | QUrl::RemoveUserInfo));
+						   nextUrl().toString(QUrl::PrettyDecoded | QUrl::RemoveUserInfo));
 		next<EO>()->onSucceeded(scope, [scope, iterator, errorHandler, failureTransformer, to, index](int, const Paging<T> &paging) {
 					  if (paging.isValid())
 						  paging.iterate(scope, iterator, errorHandler, failureTransformer, to, index);
@@ -230,7 +254,7 @@ void Paging<T>::iterate(const std::function<bool(T, qint64)> &iterator, const st
 	auto max = calcMax(to);
 	if (index < max && d->iPaging->hasNext()) {
 		qCDebug(logPaging, "Requesting next paging object with offset %s as %s", QString::number(index),
-						   d->iPaging->next().toString(QUrl::PrettyDecoded | QUrl::RemoveUserInfo));
+						   nextUrl().toString(QUrl::PrettyDecoded | QUrl::RemoveUserInfo));
 		next<EO>()->onSucceeded([iterator, failureHandler, errorHandler, exceptionHandler, to, index](int, const Paging<T> &paging) {
 					  if (paging.isValid())
 						  paging.iterate(iterator, failureHandler, errorHandler, exceptionHandler, to, index);
@@ -255,7 +279,7 @@ void Paging<T>::iterate(QObject *scope, const std::function<bool(T, qint64)> &it
 	auto max = calcMax(to);
 	if(index < max && d->iPaging->hasNext()) {
 		qCDebug(logPaging, "Requesting next paging object with offset %s as %s", QString::number(index),
-						   d->iPaging->next().toString(QUrl::PrettyDecoded | QUrl::RemoveUserInfo));
+						   nextUrl().toString(QUrl::PrettyDecoded | QUrl::RemoveUserInfo));
 		next<EO>()->onSucceeded(scope, [scope, iterator, failureHandler, errorHandler, exceptionHandler, to, index](int, const Paging<T> &paging) {
 					  if (paging.isValid())
 						  paging.iterate(scope, iterator, failureHandler, errorHandler, exceptionHandler, to, index);
@@ -266,6 +290,33 @@ void Paging<T>::iterate(QObject *scope, const std::function<bool(T, qint64)> &it
 	}
 }
 
+template<typename T>
+template<typename EO>
+void Paging<T>::iterateShards(RestClass *restClass, const QUrl &relativeUrl, int shards, const std::function<bool(T, qint64)> &iterator, const std::function<void(QString, int, RestReply::Error)> &errorHandler, const std::function<QString(EO, int)> &failureTransformer, const QString &shardParameter, const QString &shardCountParameter)
+{
+	iterateShards<EO>(restClass, restClass, relativeUrl, shards, iterator, errorHandler, failureTransformer, shardParameter, shardCountParameter);
+}
+
+template<typename T>
+template<typename EO>
+void Paging<T>::iterateShards(QObject *scope, RestClass *restClass, const QUrl &relativeUrl, int shards, const std::function<bool(T, qint64)> &iterator, const std::function<void(QString, int, RestReply::Error)> &errorHandler, const std::function<QString(EO, int)> &failureTransformer, const QString &shardParameter, const QString &shardCountParameter)
+{
+	Q_ASSERT(shards > 0);
+
+	// all shards share one iterator, so a cancel in one of them stops all others as well
+	const auto xIterator = shardIterator(iterator);
+	for (auto shard = 0; shard < shards; ++shard) {
+		qCDebug(logPaging, "Requesting shard %d of %d", shard, shards);
+		auto reply = restClass->template get<Paging<T>, EO>(relativeUrl, QVariantHash {
+																{shardParameter, shard},
+																{shardCountParameter, shards}
+															});
+		if (errorHandler)
+			reply->onAllErrors(scope, errorHandler, failureTransformer);
+		reply->iterate(scope, xIterator);
+	}
+}
+
 template<typename T>
 QVariantMap Paging<T>::properties() const
 {
@@ -326,6 +377,21 @@ qint64 Paging<T>::internalIterate(const std::function<bool (T, qint64)> &iterato
 		return 0;
 }
 
+template<typename T>
+std::function<bool(T, qint64)> Paging<T>::shardIterator(const std::function<bool(T, qint64)> &iterator)
+{
+	return [iterator, state = QSharedPointer<__private::ShardState>::create()](T item, qint64) {
+		if (state->canceled)
+			return false;
+		if (!iterator(item, state->index++)) {
+			qCDebug(logPaging, "Iterator stopped sharded iteration");
+			state->canceled = true;
+			return false;
+		}
+		return true;
+	};
+}
+
 template<typename T>
 qint64 Paging<T>::calcMax(qint64 to) const
 {
@@ -19,6 +19,7 @@ namespace QtRestClient {
 
 template<typename DO, typename EO>
 class GenericRestReply;
+class RestClass;
 
 namespace __private {
 template<typename T>
@@ -41,7 +42,7 @@ public:
 	//! Move assignment operator
 	Paging<T> &operator=(Paging<T> &&other) noexcept;
 	//! Constructs a paging from the interface, the data and a client
-	Paging(IPaging *iPaging, const QList<T> &data, RestClient *client);
+	Paging(IPaging *iPaging, const QList<T> &data, RestClient *client, const QUrl &requestUrl = {});
 
 	//! Returns true, if the current paging object is a valid one
 	bool isValid() const;
@@ -63,6 +64,10 @@ public:
 	GenericRestReply<Paging<T>, EO> *next() const;
 	//! @copybrief IPaging::next
 	QUrl nextUrl() const;
+	//! @copybrief IPagingCursor::cursor
+	QVariant cursor() const;
+	//! @copybrief IPagingCursor::nextCursor
+	QVariant nextCursor() const;
 
 	//! @copybrief IPaging::hasPrevious
 	bool hasPrevious() const;
@@ -114,6 +119,28 @@ public:
 				 qint64 to = -1,
 				 qint64 from = 0) const;
 
+	//! Iterates over all shards of a partitioned collection in parallel
+	template<typename EO = QObject*>
+	static void iterateShards(RestClass *restClass,
+							  const QUrl &relativeUrl,
+							  int shards,
+							  const std::function<bool(T, qint64)> &iterator,
+							  const std::function<void(QString, int, RestReply::Error)> &errorHandler = {},
+							  const std::function<QString(EO, int)> &failureTransformer = {},
+							  const QString &shardParameter = QStringLiteral("shard"),
+							  const QString &shardCountParameter = QStringLiteral("shards"));
+	//! @copybrief Paging::iterateShards(RestClass *, const QUrl &, int, const std::function<bool(T, qint64)> &, const std::function<void(QString, int, RestReply::Error)> &, const std::function<QString(EO, int)> &, const QString &, const QString &)
+	template<typename EO = QObject*>
+	static void iterateShards(QObject *scope,
+							  RestClass *restClass,
+							  const QUrl &relativeUrl,
+							  int shards,
+							  const std::function<bool(T, qint64)> &iterator,
+							  const std::function<void(QString, int, RestReply::Error)> &errorHandler = {},
+							  const std::function<QString(EO, int)> &failureTransformer = {},
+							  const QString &shardParameter = QStringLiteral("shard"),
+							  const QString &shardCountParameter = QStringLiteral("shards"));
+
 	//! @copybrief IPaging::properties
 	QVariantMap properties() const;
 
@@ -124,6 +151,7 @@ private:
 	QSharedDataPointer<__private::PagingData<T>> d;
 
 	qint64 internalIterate(const std::function<bool(T, qint64)> &iterator, qint64 to, qint64 from) const;
+	static std::function<bool(T, qint64)> shardIterator(const std::function<bool(T, qint64)> &iterator);
 	qint64 calcMax(qint64 to) const;
 };
 
@@ -1,5 +1,7 @@
 #include "pagingmodel.h"
 #include "pagingmodel_p.h"
+#include "configurablepagingfactory.h"
+#include <algorithm>
 #include <QtCore/QMetaProperty>
 #include <QtCore/QDebug>
 using namespace QtRestClient;
@@ -16,6 +18,14 @@ PagingModel::PagingModel(QObject *parent) :
 	  PagingModel{*new PagingModelPrivate{}, parent}
 {}
 
+PagingModel::~PagingModel()
+{
+	Q_D(PagingModel);
+	// pages decoded from now on are dropped instead of being posted
+	QMutexLocker _{&d->guard->mutex};
+	d->guard->model = nullptr;
+}
+
 void PagingModel::initialize(const QUrl &initialUrl, IPagingModelFetcher *fetcher, int typeId)
 {
 	Q_D(PagingModel);
@@ -25,6 +35,8 @@ void PagingModel::initialize(const QUrl &initialUrl, IPagingModelFetcher *fetche
 	d->nextUrl = initialUrl;
 	d->clearData();
 	d->generateRoleNames();
+	if (d->headerDiscovery == HeaderDiscovery::HeadRequest)
+		d->requestHead(initialUrl);
 	endResetModel();  // automatically calls fetchMore
 }
 
@@ -42,14 +54,7 @@ void PagingModel::initialize(RestReply *reply, IPagingModelFetcher *fetcher, int
 	d->clearData();
 	d->generateRoleNames();
 	endResetModel();
-	reply->onSucceeded(this, [this](int code, const RestReply::DataType &replyData) {
-		Q_D(PagingModel);
-		d->processReply(code, replyData);
-	});
-	reply->onAllErrors(this, [this](const QString &message, int code, RestReply::Error errorType) {
-		Q_D(PagingModel);
-		d->processError(message, code, errorType);
-	});
+	d->watchReply(reply, d->requestSequence++, {});
 }
 
 void PagingModel::initialize(RestReply *reply, RestClass *restClass, int typeId)
@@ -80,6 +85,12 @@ int PagingModel::typeId() const
 	return d->typeId;
 }
 
+PagingModel::HeaderDiscovery PagingModel::headerDiscovery() const
+{
+	Q_D(const PagingModel);
+	return d->headerDiscovery;
+}
+
 QVariant PagingModel::headerData(int section, Qt::Orientation orientation, int role) const
 {
 	Q_D(const PagingModel);
@@ -109,7 +120,7 @@ int PagingModel::rowCount(const QModelIndex &parent) const
 	if (parent.isValid())
 		return 0;
 	else
-		return d->data.size();
+		return d->data.size() + d->placeholderRows;
 }
 
 int PagingModel::columnCount(const QModelIndex &parent) const
@@ -129,7 +140,7 @@ bool PagingModel::canFetchMore(const QModelIndex &parent) const
 	if (parent.isValid())
 		return false;
 	else
-		return d->nextUrl.has_value();
+		return d->nextUrl.has_value() && !d->headPending;
 }
 
 void PagingModel::fetchMore(const QModelIndex &parent)
@@ -145,6 +156,10 @@ QVariant PagingModel::data(const QModelIndex &index, int role) const
 	Q_D(const PagingModel);
 	Q_ASSERT(checkIndex(index, CheckIndexOption::ParentIsInvalid | CheckIndexOption::IndexIsValid));
 
+	// placeholder rows have no data yet
+	if (index.row() >= d->data.size())
+		return {};
+
 	// handle model data
 	if (role == ModelDataRole)
 		return d->data.at(index.row());
@@ -217,7 +232,7 @@ QVariant PagingModel::object(const QModelIndex &index) const
 {
 	Q_D(const PagingModel);
 	Q_ASSERT(checkIndex(index, CheckIndexOption::ParentIsInvalid | CheckIndexOption::IndexIsValid));
-	return d->data.at(index.row());
+	return d->data.value(index.row());
 }
 
 Qt::ItemFlags PagingModel::flags(const QModelIndex &index) const
@@ -276,9 +291,21 @@ void PagingModel::clearColumns()
 		Q_EMIT dataChanged(this->index(0, 0), this->index(d->data.size() - 1, 0));
 }
 
+void PagingModel::setHeaderDiscovery(HeaderDiscovery headerDiscovery)
+{
+	Q_D(PagingModel);
+	if (d->headerDiscovery == headerDiscovery)
+		return;
+
+	d->headerDiscovery = headerDiscovery;
+	Q_EMIT headerDiscoveryChanged(d->headerDiscovery, {});
+}
+
 PagingModel::PagingModel(PagingModelPrivate &dd, QObject *parent) :
 	  QAbstractTableModel{dd, parent}
-{}
+{
+	dd.guard->model = this;
+}
 
 
 
@@ -288,6 +315,12 @@ IPagingModelFetcher::~IPagingModelFetcher() = default;
 
 
 
+IPagingModelHeadFetcher::IPagingModelHeadFetcher() = default;
+
+IPagingModelHeadFetcher::~IPagingModelHeadFetcher() = default;
+
+
+
 RestClassFetcher::RestClassFetcher(RestClass *restClass) :
 	_restClass{restClass}
 {}
@@ -302,20 +335,207 @@ RestReply *RestClassFetcher::fetch(const QUrl &url) const
 	return _restClass ? _restClass->callRaw(RestClass::GetVerb, url) : nullptr;
 }
 
+RestReply *RestClassFetcher::fetchHead(const QUrl &url) const
+{
+	return _restClass ? _restClass->callRaw(RestClass::HeadVerb, url) : nullptr;
+}
+
 // ------------- Private Implementation -------------
 
-void PagingModelPrivate::clearData()
+PagingModelPrivate::PageDecoder::PageDecoder(QSharedPointer<ModelGuard> guard, DecodeContext context, RestReply::DataType data) :
+	_guard{std::move(guard)},
+	_context{std::move(context)},
+	_data{std::move(data)}
+{}
+
+void PagingModelPrivate::PageDecoder::run()
 {
-	const auto tFlags = QMetaType(typeId).flags();
-	if (tFlags.testFlag(QMetaType::PointerToQObject) ||
-		tFlags.testFlag(QMetaType::TrackingPointerToQObject)) {
-		for (const auto &value : qAsConst(data)) {
-			const auto obj = value.value<QObject*>();
-			if (obj)
-				obj->deleteLater();
+	postPage(_guard, _context.typeId, decodeReply(_context, _data));
+}
+
+PagingModelPrivate::PageBatch PagingModelPrivate::decodeReply(const DecodeContext &context, const RestReply::DataType &data)
+{
+	PageBatch page;
+	page.generation = context.generation;
+	page.sequence = context.sequence;
+	page.aborted = true;
+	// the client cannot be destroyed and does not delete its serializer while the guard is held
+	QReadLocker _{context.clientGuard ? &context.clientGuard->lock : nullptr};
+	if (!context.pagingFactory || !context.clientGuard || !context.clientGuard->client) {
+		page.failed = true;
+		return page;
+	}
+
+	QScopedPointer<IPaging> paging;
+#ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
+	try {
+		paging.reset(std::visit(__private::overload {
+									[](std::nullopt_t) -> IPaging* {
+										return nullptr;
+									},
+									[&](const auto &vData) -> IPaging* {
+										return context.pagingFactory->createPagingFromReply(context.serializer, vData, context.headers, context.requestUrl);
+									}
+								}, data));
+	} catch (DeserializationException &e) {
+		qCCritical(logPagingModel) << "Failed to parse received paging object with error:"
+								   << e.what();
+		page.failed = true;
+		return page;
+	}
+#else
+	paging.reset(std::visit(__private::overload {
+								[](std::nullopt_t) -> IPaging* {
+									return nullptr;
+								},
+								[&](const auto &vData) -> IPaging* {
+									return context.pagingFactory->createPagingFromReply(vData, context.headers, context.requestUrl);
+								}
+							}, data));
+#endif
+
+	if (!paging)
+		return page;
+	return decodePaging(context, paging.data());
+}
+
+PagingModelPrivate::PageBatch PagingModelPrivate::decodePaging(const DecodeContext &context, IPaging *paging)
+{
+	// the caller holds the client guard
+	PageBatch page;
+	page.generation = context.generation;
+	page.sequence = context.sequence;
+	page.offset = paging->offset();
+	page.total = paging->total();
+	if (paging->hasNext())
+		page.next = paging->nextUrl(context.requestUrl);
+	if (paging->hasPrevious())
+		page.previous = paging->previous();
+
+	std::visit([&](const auto &items){
+		page.items.reserve(items.size());
+#ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
+		const auto serializer = context.serializer;
+		if (!serializer) {
+			qCCritical(logPagingModel) << "Unable to deserialize paging elements without a serializer";
+			page.failed = true;
+			return;
 		}
+
+		const auto isObject = holdsObjects(context.typeId);
+		for (const auto &item : items) {
+			try {
+				// objects are created without parent and adopted by the model once inserted
+				auto value = serializer->deserializeGeneric(item, context.typeId, nullptr);
+				if (isObject) {
+					if (const auto obj = value.template value<QObject*>(); obj)
+						obj->moveToThread(context.targetThread);
+				}
+				page.items.append(value);
+			} catch (DeserializationException &e) {
+				qCCritical(logPagingModel) << "Failed to deserialize paging element with error:"
+										   << e.what();
+				page.items.append(QVariant{});
+				page.failed = true;
+			}
+		}
+#else
+		for (const auto &item : items)
+			page.items.append(item.toVariant());
+#endif
+	}, paging->items());
+
+	return page;
+}
+
+void PagingModelPrivate::postPage(PagingModel *model, PageBatch &&page)
+{
+	if (!model)
+		return;
+
+	if (QThread::currentThread() == model->thread())
+		model->d_func()->enqueuePage(std::move(page));
+	else {
+		QMetaObject::invokeMethod(model, [model, xPage = std::move(page)]() mutable {
+			model->d_func()->enqueuePage(std::move(xPage));
+		}, Qt::QueuedConnection);
+	}
+}
+
+void PagingModelPrivate::postPage(const QSharedPointer<ModelGuard> &guard, int typeId, PageBatch &&page)
+{
+	// the model cannot be destroyed while the lock is held, and drops the queued page if it is destroyed later
+	QMutexLocker _{&guard->mutex};
+	if (guard->model)
+		postPage(guard->model, std::move(page));
+	else
+		discardItems(typeId, page.items);
+}
+
+void PagingModelPrivate::discardItems(int typeId, const QVariantList &items)
+{
+	if (!holdsObjects(typeId))
+		return;
+
+	for (const auto &value : items) {
+		const auto obj = value.value<QObject*>();
+		if (obj)
+			obj->deleteLater();
+	}
+}
+
+bool PagingModelPrivate::holdsObjects(int typeId)
+{
+	const auto tFlags = QMetaType(typeId).flags();
+	return tFlags.testFlag(QMetaType::PointerToQObject) ||
+		   tFlags.testFlag(QMetaType::TrackingPointerToQObject);
+}
+
+QUrl PagingModelPrivate::prefetchKey(const QUrl &url)
+{
+	// links from headers are often absolute, while the ones in the body are relative
+	auto key = url.adjusted(QUrl::RemoveScheme | QUrl::RemoveAuthority | QUrl::NormalizePathSegments);
+	if (key.path().startsWith(QLatin1Char('/')))
+		key.setPath(key.path().mid(1));
+	return key;
+}
+
+PagingModelPrivate::DecodeContext PagingModelPrivate::decodeContext(quint64 sequence, const QUrl &requestUrl, const HeaderHash &headers) const
+{
+	Q_Q(const PagingModel);
+	DecodeContext context;
+	// the factory is shared, so replacing it does not affect running decoders
+	if (const auto client = fetcher ? fetcher->client() : nullptr; client) {
+		const auto clientD = static_cast<RestClientPrivate*>(QObjectPrivate::get(client));
+		QReadLocker _{clientD->threadLock};
+		context.pagingFactory = clientD->pagingFactory;
+		context.clientGuard = clientD->guard;
+#ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
+		context.serializer = clientD->serializer;
+#endif
 	}
+	context.typeId = typeId;
+	context.generation = generation;
+	context.sequence = sequence;
+	context.targetThread = q->thread();
+	context.requestUrl = requestUrl;
+	context.headers = headers;
+	return context;
+}
+
+void PagingModelPrivate::clearData()
+{
+	discardItems(typeId, data);
 	data.clear();
+	for (const auto &page : qAsConst(pendingPages))
+		discardItems(typeId, page.items);
+	pendingPages.clear();
+	placeholderRows = 0;
+	headPending = false;
+	prefetchedUrls.clear();
+	requestSequence = 0;
+	commitSequence = 0;
+	++generation;
 }
 
 void PagingModelPrivate::generateRoleNames()
@@ -338,110 +558,273 @@ void PagingModelPrivate::requestNext()
 	Q_Q(PagingModel);
 	Q_ASSERT(nextUrl);
 	auto reply = fetcher->fetch(*nextUrl);
-	if (reply) {
-		nextUrl = std::nullopt;
-		reply->onSucceeded(q, [this](int code, const RestReply::DataType &replyData) {
-			processReply(code, replyData);
-		});
-		reply->onAllErrors(q, [this](const QString &message, int code, RestReply::Error errorType) {
-			processError(message, code, errorType);
-		});
-	} else
+	if (reply)
+		watchReply(reply, requestSequence++, *std::exchange(nextUrl, std::nullopt));
+	else
 		Q_EMIT q->fetchError({});
 }
 
-void PagingModelPrivate::processReply(int, const RestReply::DataType &data)
+void PagingModelPrivate::requestHead(const QUrl &url)
 {
-#ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
 	Q_Q(PagingModel);
-	IPaging *paging;
-	try {
-		paging = std::visit(__private::overload {
-								[](std::nullopt_t) -> IPaging* {
-									return nullptr;
-								},
-								[&](const auto &vData) {
-									return fetcher->client()->pagingFactory()->createPaging(fetcher->client()->serializer(), vData);
-								}
-							}, data);
-	} catch (DeserializationException &e) {
-		qCCritical(logPagingModel) << "Failed to parse received paging object with error:"
-								   << e.what();
-		Q_EMIT q->fetchError({});
+	const auto headFetcher = dynamic_cast<IPagingModelHeadFetcher*>(fetcher.data());
+	auto reply = headFetcher ? headFetcher->fetchHead(url) : nullptr;
+	if (!reply)
 		return;
+
+	// the first page is only requested once the size of the model is known
+	headPending = true;
+	const auto replyGeneration = generation;
+	const auto headDone = [this, q, replyGeneration]() {
+		if (replyGeneration != generation || !std::exchange(headPending, false))
+			return;
+		if (q->canFetchMore({}))
+			q->fetchMore({});
+	};
+	QObject::connect(reply, &RestReply::metaDataChanged, q, [this, reply, url, replyGeneration, headDone]() {
+		if (replyGeneration == generation)
+			processHeaders(reply->responseHeaders(), std::nullopt, url);
+		headDone();
+	});
+	// a failed HEAD request only delays the first page
+	QObject::connect(reply, &QObject::destroyed, q, headDone);
+
+	// the reply only serves for its headers, so it is released as soon as it ended in any way
+	reply->setAllowEmptyReplies(true);
+	reply->disableAutoDelete();
+	QObject::connect(reply, &RestReply::succeeded, reply, &QObject::deleteLater);
+	QObject::connect(reply, &RestReply::failed, reply, &QObject::deleteLater);
+	QObject::connect(reply, &RestReply::error, reply, &QObject::deleteLater);
+}
+
+void PagingModelPrivate::watchReply(RestReply *reply, quint64 sequence, const QUrl &requestUrl)
+{
+	Q_Q(PagingModel);
+	const auto replyGeneration = generation;
+	// for replies with an async pool, the handler runs on a worker thread, so it must not touch the
+	// model. Stale pages are dropped when they are flushed instead
+	reply->onSucceeded(q, [this, reply, xGuard = guard, context = decodeContext(sequence, requestUrl)](int, const RestReply::DataType &replyData) {
+		auto replyContext = context;
+		if (const auto nReply = reply->networkReply(); replyContext.requestUrl.isEmpty() && nReply)
+			replyContext.requestUrl = nReply->url();
+		replyContext.headers = reply->responseHeaders();
+		if (QThread::currentThread() != context.targetThread)
+			PageDecoder{xGuard, std::move(replyContext), replyData}.run();
+		else if (context.generation == generation)
+			processReply(std::move(replyContext), replyData);
+	});
+	reply->onAllErrors(q, [xGuard = guard, sequence, replyGeneration](const QString &message, int code, RestReply::Error errorType) {
+		processError(xGuard, message, code, errorType, replyGeneration, sequence);
+	});
+	if (headerDiscovery != HeaderDiscovery::Disabled) {
+		QObject::connect(reply, &RestReply::metaDataChanged, q, [this, reply, sequence, requestUrl, replyGeneration]() {
+			if (replyGeneration != generation)
+				return;
+			auto url = requestUrl;
+			if (const auto nReply = reply->networkReply(); url.isEmpty() && nReply)
+				url = nReply->url();
+			processHeaders(reply->responseHeaders(), sequence, url);
+		});
 	}
-#else
-	auto paging = std::visit(__private::overload {
-								 [](std::nullopt_t) -> IPaging* {
-									 return nullptr;
-								 },
-								 [this](auto vData) -> IPaging* {
-									 return fetcher->client()->pagingFactory()->createPaging(vData);
-								 }
-							 }, data);
-#endif
+}
 
-	if (paging) {
-		processPaging(paging);
-		delete paging;
+void PagingModelPrivate::processHeaders(const HeaderHash &headers, std::optional<quint64> sequence, const QUrl &requestUrl)
+{
+	if (const auto totalHeader = headers.value("x-total-count"); !totalHeader.isEmpty()) {
+		auto ok = false;
+		const auto total = totalHeader.trimmed().toLongLong(&ok);
+		if (ok)
+			reserveRows(total);
+	}
+
+	// only the most recent request may chain the next one, and only up to a limited depth
+	if (!sequence ||
+		*sequence + 1 != requestSequence ||
+		requestSequence - commitSequence >= MaxPrefetches)
+		return;
+
+	if (const auto linkHeader = headers.value("link"); !linkHeader.isEmpty()) {
+		const auto next = ConfigurablePagingFactory::parseLinkHeader(linkHeader, requestUrl).value(QStringLiteral("next"));
+		if (next.isValid() && !prefetchedUrls.contains(prefetchKey(next))) {
+			qCDebug(logPagingModel) << "Prefetching next paging from link header";
+			prefetchedUrls.insert(prefetchKey(next));
+			nextUrl = next;
+			requestNext();
+		}
 	}
 }
 
-void PagingModelPrivate::processPaging(IPaging *paging)
+void PagingModelPrivate::processReply(DecodeContext context, const RestReply::DataType &data)
 {
 	Q_Q(PagingModel);
-	if (paging->offset() < data.size()) {
-		qCWarning(logPagingModel) << "Pagings out of sync - dropping duplicate data";
-		data = data.mid(0, static_cast<int>(paging->offset()));
-	} else if (paging->offset() > data.size()) {
-		if (paging->hasPrevious()) {
-			qCWarning(logPagingModel) << "Pagings out of sync - trying for previous data";
-			nextUrl = paging->previous();
-			requestNext();
+#ifdef QT_RESTCLIENT_USE_ASYNC
+	// decode on the clients pool
+	if (const auto client = fetcher ? fetcher->client() : nullptr; client) {
+		if (const auto pool = client->asyncPool(); pool) {
+			pool->start(new PageDecoder{guard, std::move(context), data});
 			return;
-		} else {
-			qCWarning(logPagingModel) << "Pagings out of sync - skipping" << paging->offset() - data.size()
-									  << "unobtainable elements";
 		}
 	}
+#endif
+	postPage(q, decodeReply(context, data));
+}
 
-	std::visit([&](const auto &items){
-		q->beginInsertRows({}, data.size(), static_cast<int>(data.size() + items.size() - 1));
-#ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
-		const auto serializer = fetcher->client()->serializer();
-		auto fetchFailed = false;
-		for (const auto &item : items) {
-			try {
-				data.append(serializer->deserializeGeneric(item, typeId, q));
-			} catch (DeserializationException &e) {
-				qCCritical(logPagingModel) << "Failed to deserialize paging element with error:"
-										   << e.what();
-				data.append(QVariant{});
-				fetchFailed = true;
+void PagingModelPrivate::processPaging(IPaging *paging)
+{
+	const auto context = decodeContext(requestSequence++);
+	{
+		QReadLocker _{context.clientGuard ? &context.clientGuard->lock : nullptr};
+		enqueuePage(decodePaging(context, paging));
+	}
+	flushPages();
+}
+
+void PagingModelPrivate::processError(const QSharedPointer<ModelGuard> &guard, const QString &message, int code, RestReply::Error errorType, quint64 generation, quint64 sequence)
+{
+	qCCritical(logPagingModel) << "Network request failed with error of type" << errorType
+							   << "and code" << code << "- error message is:" << qUtf8Printable(message);
+	// pass the failure through the queue, so pages requested after this one are not blocked
+	PageBatch page;
+	page.generation = generation;
+	page.sequence = sequence;
+	page.failed = true;
+	page.aborted = true;
+	postPage(guard, QMetaType::UnknownType, std::move(page));
+}
+
+void PagingModelPrivate::enqueuePage(PageBatch &&page)
+{
+	Q_Q(PagingModel);
+	pendingPages.append(std::move(page));
+	// pages that arrive before the flush are merged into a single insertion
+	if (!flushQueued) {
+		flushQueued = true;
+		QMetaObject::invokeMethod(q, [this]() {
+			flushPages();
+		}, Qt::QueuedConnection);
+	}
+}
+
+void PagingModelPrivate::flushPages()
+{
+	Q_Q(PagingModel);
+	flushQueued = false;
+	// pages are committed in the order they were requested in, no matter when they arrived
+	std::stable_sort(pendingPages.begin(), pendingPages.end(), [](const PageBatch &lhs, const PageBatch &rhs) {
+		return lhs.sequence < rhs.sequence;
+	});
+
+	QVariantList rows;
+	auto fetchFailed = false;
+	while (!pendingPages.isEmpty()) {
+		if (pendingPages.first().generation != generation ||
+			pendingPages.first().sequence < commitSequence) {
+			discardItems(typeId, pendingPages.takeFirst().items);
+			continue;
+		} else if (pendingPages.first().sequence != commitSequence)
+			break;  // wait for the pages requested before this one
+
+		auto page = pendingPages.takeFirst();
+		++commitSequence;
+		if (page.aborted) {
+			fetchFailed = fetchFailed || page.failed;
+			continue;
+		}
+
+		const auto end = data.size() + rows.size();
+		if (page.offset >= 0 && page.offset < end) {
+			qCWarning(logPagingModel) << "Pagings out of sync - dropping duplicate data";
+			commitRows(rows);
+			const auto first = static_cast<int>(page.offset);
+			q->beginRemoveRows({}, first, data.size() - 1);
+			discardItems(typeId, data.mid(first));
+			data.erase(data.begin() + first, data.end());
+			q->endRemoveRows();
+		} else if (page.offset > end) {
+			if (page.previous) {
+				qCWarning(logPagingModel) << "Pagings out of sync - trying for previous data";
+				commitRows(rows);
+				discardItems(typeId, page.items);
+				// skip everything that is still on it's way
+				commitSequence = requestSequence;
+				nextUrl = page.previous;
+				requestNext();
+				if (fetchFailed)
+					Q_EMIT q->fetchError({});
+				return;
+			} else {
+				qCWarning(logPagingModel) << "Pagings out of sync - skipping" << page.offset - end
+										  << "unobtainable elements";
 			}
 		}
-#else
-		for (const auto &item : items)
-			data.append(item.toVariant());
-#endif
 
-		if (data.size() < paging->total() && paging->hasNext())
-			nextUrl = paging->next();
-		else
+		rows.append(page.items);
+		fetchFailed = fetchFailed || page.failed;
+		if (data.size() + rows.size() < page.total && page.next) {
+			if (prefetchedUrls.remove(prefetchKey(*page.next)))
+				nextUrl = std::nullopt;  // already requested via the headers
+			else
+				nextUrl = page.next;
+		} else
 			nextUrl = std::nullopt;
+	}
+	commitRows(rows);
+
+	if (!nextUrl && commitSequence == requestSequence)
+		dropPlaceholders();
+	if (fetchFailed)
+		Q_EMIT q->fetchError({});
+}
+
+void PagingModelPrivate::commitRows(QVariantList &rows)
+{
+	Q_Q(PagingModel);
+	if (rows.isEmpty())
+		return;
+
+	if (holdsObjects(typeId)) {
+		for (const auto &value : qAsConst(rows)) {
+			const auto obj = value.value<QObject*>();
+			if (obj)
+				obj->setParent(q);
+		}
+	}
+
+	// rows reserved from the headers are filled first, only the rest is inserted
+	const auto first = data.size();
+	const auto filled = std::min(static_cast<int>(rows.size()), placeholderRows);
+	const auto inserted = rows.size() - filled;
+	if (inserted > 0)
+		q->beginInsertRows({}, first + filled, first + rows.size() - 1);
+	data.append(rows);
+	placeholderRows -= filled;
+	rows.clear();
+	if (inserted > 0)
 		q->endInsertRows();
+	if (filled > 0)
+		Q_EMIT q->dataChanged(q->index(first, 0), q->index(first + filled - 1, q->columnCount() - 1));
+}
 
-#ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
-		if (fetchFailed)
-			Q_EMIT q->fetchError({});
-#endif
-	}, paging->items());
+void PagingModelPrivate::reserveRows(qint64 total)
+{
+	Q_Q(PagingModel);
+	const auto rowCount = data.size() + placeholderRows;
+	const auto reserved = static_cast<int>(std::min<qint64>(total, std::numeric_limits<int>::max()));
+	if (reserved <= rowCount)
+		return;
+
+	q->beginInsertRows({}, rowCount, reserved - 1);
+	placeholderRows += reserved - rowCount;
+	q->endInsertRows();
 }
 
-void PagingModelPrivate::processError(const QString &message, int code, RestReply::Error errorType)
+void PagingModelPrivate::dropPlaceholders()
 {
 	Q_Q(PagingModel);
-	qCCritical(logPagingModel) << "Network request failed with error of type" << errorType
-							   << "and code" << code << "- error message is:" << qUtf8Printable(message);
-	Q_EMIT q->fetchError({});
+	if (placeholderRows == 0)
+		return;
+
+	q->beginRemoveRows({}, data.size(), data.size() + placeholderRows - 1);
+	placeholderRows = 0;
+	q->endRemoveRows();
 }
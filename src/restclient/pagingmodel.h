@@ -30,6 +30,17 @@ public:
 	virtual RestReply *fetch(const QUrl &url) const = 0;
 };
 
+//! Optional interface for fetchers that can obtain the headers of the data without the data
+class Q_RESTCLIENT_EXPORT IPagingModelHeadFetcher
+{
+	Q_DISABLE_COPY(IPagingModelHeadFetcher)
+public:
+	IPagingModelHeadFetcher();
+	virtual ~IPagingModelHeadFetcher();
+	//! Send a HTTP HEAD request to the given URL to obtain the headers of the data
+	virtual RestReply *fetchHead(const QUrl &url) const = 0;
+};
+
 class PagingModelPrivate;
 //! A Qt item model that fills itself from a Paging object obtained via the network
 class Q_RESTCLIENT_EXPORT PagingModel : public QAbstractTableModel
@@ -38,13 +49,24 @@ class Q_RESTCLIENT_EXPORT PagingModel : public QAbstractTableModel
 
 	//! Holds the type the model fetches data for
 	Q_PROPERTY(int typeId READ typeId NOTIFY typeIdChanged)
+	//! Specifies whether response headers are used to size the model before the data arrived
+	Q_PROPERTY(HeaderDiscovery headerDiscovery READ headerDiscovery WRITE setHeaderDiscovery NOTIFY headerDiscoveryChanged)
 
 public:
 	//! The Qt item role of the full REST-Object as was used to populate the model
 	static constexpr int ModelDataRole = Qt::UserRole;
 
+	//! The different sources the model can use to learn about the data before it arrived
+	enum class HeaderDiscovery {
+		Disabled,  //!< Only the paging objects of the reply bodies are used
+		ResponseHeaders,  //!< The X-Total-Count and Link headers are evaluated as soon as they arrive
+		HeadRequest  //!< Like ResponseHeaders, but sends an additional HEAD request when initialized from an URL
+	};
+	Q_ENUM(HeaderDiscovery)
+
 	//! Default constructor
 	explicit PagingModel(QObject *parent = nullptr);
+	~PagingModel() override;
 
 	//! @copybrief PagingModel::initialize(const QUrl &, IPagingModelFetcher *)
 	Q_INVOKABLE void initialize(const QUrl &initialUrl, QtRestClient::IPagingModelFetcher *fetcher, int typeId = QMetaType::UnknownType);
@@ -81,6 +103,8 @@ public:
 
 	//! @readAcFn{PagingModel::typeId}
 	int typeId() const;
+	//! @readAcFn{PagingModel::headerDiscovery}
+	HeaderDiscovery headerDiscovery() const;
 
 	//! @inherit{QAbstractTableModel::headerData}
 	QVariant headerData(int section, Qt::Orientation orientation = Qt::Horizontal, int role = Qt::DisplayRole) const override;
@@ -119,12 +143,18 @@ public:
 	//! Removes all customly added columns and roles
 	void clearColumns();
 
+public Q_SLOTS:
+	//! @writeAcFn{PagingModel::headerDiscovery}
+	void setHeaderDiscovery(HeaderDiscovery headerDiscovery);
+
 Q_SIGNALS:
 	//! Gets emitted if the model fails to obtain data via the network
 	void fetchError(QPrivateSignal);
 
 	//! @notifyAcFn{PagingModel::typeId}
 	void typeIdChanged(int typeId, QPrivateSignal);
+	//! @notifyAcFn{PagingModel::headerDiscovery}
+	void headerDiscoveryChanged(HeaderDiscovery headerDiscovery, QPrivateSignal);
 
 protected:
 	//! @private
@@ -135,13 +165,14 @@ private:
 };
 
 //! A default implementation for a IPagingModelFetcher, using a RestClass to send the requests
-class Q_RESTCLIENT_EXPORT RestClassFetcher : public IPagingModelFetcher
+class Q_RESTCLIENT_EXPORT RestClassFetcher : public IPagingModelFetcher, public IPagingModelHeadFetcher
 {
 public:
 	//! Default constructor
 	RestClassFetcher(RestClass *restClass);
 	RestClient *client() const override;
 	RestReply *fetch(const QUrl &url) const override;
+	RestReply *fetchHead(const QUrl &url) const override;
 
 private:
 	QPointer<RestClass> _restClass;
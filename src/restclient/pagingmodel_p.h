@@ -2,11 +2,19 @@
 #define QTRESTCLIENT_PAGINGMODEL_P_H
 
 #include "pagingmodel.h"
+#include "restclient_p.h"
 
 #include <optional>
+#include <limits>
 
 #include <QtCore/QHash>
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
+#include <QtCore/QPointer>
+#include <QtCore/QRunnable>
+#include <QtCore/QSet>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QThread>
 
 #include <QtCore/private/qabstractitemmodel_p.h>
 
@@ -16,6 +24,58 @@ class Q_RESTCLIENT_EXPORT PagingModelPrivate : public QAbstractItemModelPrivate
 {
 	Q_DECLARE_PUBLIC(PagingModel)
 public:
+	using HeaderDiscovery = PagingModel::HeaderDiscovery;
+
+	static constexpr int MaxPrefetches = 4;
+
+	struct PageBatch {
+		quint64 generation = 0;
+		quint64 sequence = 0;
+		qint64 offset = -1;
+		qint64 total = std::numeric_limits<qint64>::max();
+		std::optional<QUrl> next;
+		std::optional<QUrl> previous;
+		QVariantList items;
+		bool failed = false;
+		bool aborted = false;  // no paging was received, the batch only completes its sequence
+	};
+
+	// lets decoders on other threads post pages only while the model exists
+	struct ModelGuard {
+		QMutex mutex;
+		PagingModel *model = nullptr;
+	};
+
+	// everything a decoder needs, copied on the models thread so workers never touch the model.
+	// The serializer is only used while holding the client guard, as the client may delete it
+	struct DecodeContext {
+		QSharedPointer<IPagingFactory> pagingFactory;
+		QSharedPointer<RestClientPrivate::ClientGuard> clientGuard;
+#ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
+		QPointer<QtJsonSerializer::SerializerBase> serializer;
+#endif
+		int typeId = QMetaType::UnknownType;
+		quint64 generation = 0;
+		quint64 sequence = 0;
+		QThread *targetThread = nullptr;
+		QUrl requestUrl;
+		HeaderHash headers;
+	};
+
+	class PageDecoder : public QRunnable
+	{
+	public:
+		PageDecoder(QSharedPointer<ModelGuard> guard, DecodeContext context, RestReply::DataType data);
+
+		void run() override;
+
+	private:
+		QSharedPointer<ModelGuard> _guard;
+		DecodeContext _context;
+		RestReply::DataType _data;
+	};
+
+	QSharedPointer<ModelGuard> guard = QSharedPointer<ModelGuard>::create();
 	int typeId = QMetaType::UnknownType;
 	QScopedPointer<IPagingModelFetcher> fetcher {};
 	std::optional<QUrl> nextUrl;
@@ -25,12 +85,41 @@ public:
 	QStringList columns;
 	QHash<int, QHash<int, QByteArray>> roleMapping; //column -> (role -> property)
 
+	quint64 generation = 0;
+	QList<PageBatch> pendingPages;
+	bool flushQueued = false;
+
+	HeaderDiscovery headerDiscovery = HeaderDiscovery::Disabled;
+	quint64 requestSequence = 0;
+	quint64 commitSequence = 0;
+	int placeholderRows = 0;
+	bool headPending = false;
+	QSet<QUrl> prefetchedUrls;
+
+	static PageBatch decodeReply(const DecodeContext &context, const RestReply::DataType &data);
+	static PageBatch decodePaging(const DecodeContext &context, IPaging *paging);
+	static void postPage(PagingModel *model, PageBatch &&page);
+	static void postPage(const QSharedPointer<ModelGuard> &guard, int typeId, PageBatch &&page);
+	static void discardItems(int typeId, const QVariantList &items);
+	static bool holdsObjects(int typeId);
+	static QUrl prefetchKey(const QUrl &url);
+
+	DecodeContext decodeContext(quint64 sequence, const QUrl &requestUrl = {}, const HeaderHash &headers = {}) const;
+
 	void clearData();
 	void generateRoleNames();
 	void requestNext();
-	void processReply(int code, const RestReply::DataType &data);
+	void requestHead(const QUrl &url);
+	void watchReply(RestReply *reply, quint64 sequence, const QUrl &requestUrl);
+	void processHeaders(const HeaderHash &headers, std::optional<quint64> sequence, const QUrl &requestUrl);
+	void processReply(DecodeContext context, const RestReply::DataType &data);
 	void processPaging(IPaging *paging);
-	void processError(const QString &message, int code, RestReply::Error errorType);
+	static void processError(const QSharedPointer<ModelGuard> &guard, const QString &message, int code, RestReply::Error errorType, quint64 generation, quint64 sequence);
+	void enqueuePage(PageBatch &&page);
+	void flushPages();
+	void commitRows(QVariantList &rows);
+	void reserveRows(qint64 total);
+	void dropPlaceholders();
 };
 
 Q_DECLARE_LOGGING_CATEGORY(logPagingModel)
@@ -0,0 +1,412 @@
+#ifndef QTRESTCLIENT_PAGINGSTREAM_H
+#define QTRESTCLIENT_PAGINGSTREAM_H
+
+#include "QtRestClient/qtrestclient_global.h"
+#include "QtRestClient/paging.h"
+#include "QtRestClient/restreplyawaitable.h"
+
+#include <functional>
+#include <optional>
+
+#include <QtCore/qmutex.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qsharedpointer.h>
+
+namespace QtRestClient {
+
+namespace __private {
+template <typename T, typename EO>
+class PagingStreamData;
+}
+
+//! A pull based stream over all items of a paging, that only requests pages as they are needed
+template <typename T, typename EO = QObject*>
+class PagingStream
+{
+public:
+	//! The type of the handlers passed to next()
+	using ItemHandler = std::function<void(std::optional<T>)>;
+	//! The exception thrown when awaiting an item of a failed stream
+	using exceptionType = GenericAwaitedException<EO>;
+
+	//! Creates an invalid stream
+	PagingStream() = default;
+	//! Creates a stream that starts with the paging of the given reply
+	explicit PagingStream(GenericRestReply<Paging<T>, EO> *reply, int readAhead = 0);
+	//! Creates a stream that starts with the given paging
+	explicit PagingStream(const Paging<T> &paging, int readAhead = 0);
+
+	//! Returns true, if the stream was created from a paging or a reply
+	bool isValid() const;
+	//! Returns true, if all items have been taken from the stream and no further page can be requested
+	bool atEnd() const;
+	//! Returns the number of items that have been received but not taken yet
+	qint64 bufferedItems() const;
+	//! Returns the error that ended the stream, if any
+	std::optional<exceptionType> error() const;
+
+	//! Returns the number of pages that are requested before they are needed
+	int readAhead() const;
+	//! Sets the number of pages that are requested before they are needed
+	void setReadAhead(int readAhead);
+	//! Set a handler to be called if requesting a page failed
+	PagingStream &onAllErrors(const std::function<void(QString, int, RestReply::Error)> &handler,
+							  const std::function<QString(EO, int)> &failureTransformer = {});
+
+	//! Takes the next item from the stream and passes it to the handler, once it is available
+	void next(ItemHandler handler);
+
+#if defined(DOXYGEN_RUN) || defined(QT_RESTCLIENT_USE_COROUTINES)
+	//! The awaitable returned by next()
+	class NextAwaitable
+	{
+	public:
+		//! @private
+		NextAwaitable(QSharedPointer<__private::PagingStreamData<T, EO>> data);
+
+		//! Returns true, if the item can be taken without waiting
+		bool await_ready();
+		//! Resumes the coroutine once the next item is available
+		void await_suspend(std::coroutine_handle<> handle);
+		//! Returns the item, nothing at the end of the stream, or throws if the stream failed
+		std::optional<T> await_resume();
+
+	private:
+		QSharedPointer<__private::PagingStreamData<T, EO>> _data;
+		std::optional<T> _result;
+	};
+
+	//! Takes the next item from the stream in a coroutine
+	NextAwaitable next();
+#endif
+
+private:
+	QSharedPointer<__private::PagingStreamData<T, EO>> d;
+};
+
+// ------------- Generic Implementation -------------
+
+namespace __private {
+
+template <typename T, typename EO>
+class PagingStreamData : public QEnableSharedFromThis<PagingStreamData<T, EO>>
+{
+public:
+	using ItemHandler = typename PagingStream<T, EO>::ItemHandler;
+	using exceptionType = GenericAwaitedException<EO>;
+	using Delivery = QList<std::pair<ItemHandler, std::optional<T>>>;
+
+	mutable QMutex mutex;
+	QQueue<QList<T>> pages;  // the front page is the one currently being read
+	int position = 0;
+	Paging<T> lastPage;
+	bool fetching = false;
+	int readAhead = 0;
+	QQueue<ItemHandler> waiters;
+	bool draining = false;
+	std::optional<exceptionType> error;
+	std::function<void(QString, int, RestReply::Error)> errorHandler;
+	std::function<QString(EO, int)> failureTransformer;
+
+	~PagingStreamData();
+
+	bool hasItem() const;
+	bool isDone() const;
+	T take();
+	void request(ItemHandler handler);
+
+	void watch(GenericRestReply<Paging<T>, EO> *reply);
+	void appendPage(const Paging<T> &paging);
+	void fail(exceptionType &&exception);
+
+	// must be called with the mutex locked
+	void maybeFetch();
+	Delivery collectDeliveries();
+	void drain(QMutexLocker &locker);
+};
+
+template <typename T, typename EO>
+PagingStreamData<T, EO>::~PagingStreamData()
+{
+	// delete all items that have never been taken
+	for (auto i = 0; i < pages.size(); ++i) {
+		const auto &page = pages[i];
+		for (auto j = (i == 0 ? position : 0); j < page.size(); ++j)
+			MetaComponent<T>::deleteLater(page[j]);
+	}
+}
+
+template <typename T, typename EO>
+bool PagingStreamData<T, EO>::hasItem() const
+{
+	return !pages.isEmpty();
+}
+
+template <typename T, typename EO>
+bool PagingStreamData<T, EO>::isDone() const
+{
+	return !hasItem() &&
+		   !fetching &&
+		   (error || !lastPage.isValid() || !lastPage.hasNext());
+}
+
+template <typename T, typename EO>
+T PagingStreamData<T, EO>::take()
+{
+	const auto &page = pages.head();
+	auto item = page[position++];
+	if (position >= page.size()) {
+		pages.dequeue();
+		position = 0;
+	}
+	return item;
+}
+
+template <typename T, typename EO>
+void PagingStreamData<T, EO>::request(ItemHandler handler)
+{
+	QMutexLocker locker{&mutex};
+	waiters.enqueue(std::move(handler));
+	drain(locker);
+}
+
+template <typename T, typename EO>
+void PagingStreamData<T, EO>::watch(GenericRestReply<Paging<T>, EO> *reply)
+{
+	// only hold weak references, so dropping the stream stops it
+	const QWeakPointer<PagingStreamData<T, EO>> weak = this->sharedFromThis();
+	reply->onSucceeded([weak](int, const Paging<T> &paging) {
+			  if (const auto data = weak.toStrongRef(); data)
+				  data->appendPage(paging);
+			  else
+				  paging.deleteAllItems();
+		  })
+		->onFailed([weak](int code, EO obj) {
+			if (const auto data = weak.toStrongRef(); data)
+				data->fail(exceptionType{code, obj});
+			else
+				MetaComponent<EO>::deleteLater(obj);
+		})
+		->onError([weak](const QString &message, int code, RestReply::Error type) {
+			if (const auto data = weak.toStrongRef(); data)
+				data->fail(exceptionType{code, type, message});
+		})
+		->onSerializeException([weak](const QtJsonSerializer::Exception &exception) {
+			if (const auto data = weak.toStrongRef(); data)
+				data->fail(exceptionType{0, RestReply::Error::Deserialization, QString::fromUtf8(exception.what())});
+		});
+}
+
+template <typename T, typename EO>
+void PagingStreamData<T, EO>::appendPage(const Paging<T> &paging)
+{
+	QMutexLocker locker{&mutex};
+	fetching = false;
+	lastPage = paging;
+	if (const auto items = paging.items(); !items.isEmpty())
+		pages.enqueue(items);
+	drain(locker);
+}
+
+template <typename T, typename EO>
+void PagingStreamData<T, EO>::fail(exceptionType &&exception)
+{
+	QMutexLocker locker{&mutex};
+	fetching = false;
+	error.emplace(std::move(exception));
+	const auto handler = errorHandler;
+	const auto transformer = failureTransformer;
+	const auto failure = *error;
+	locker.unlock();
+
+	if (handler) {
+		if (failure.errorType() == RestReply::Error::Failure)
+			handler(transformer ? transformer(failure.genericError(), failure.errorCode()) : QString{}, failure.errorCode(), RestReply::Error::Failure);
+		else
+			handler(failure.errorString(), failure.errorCode(), failure.errorType());
+	}
+
+	locker.relock();
+	drain(locker);
+}
+
+template <typename T, typename EO>
+void PagingStreamData<T, EO>::maybeFetch()
+{
+	if (fetching || error || !lastPage.isValid() || !lastPage.hasNext())
+		return;
+	// without waiters, only keep up to readAhead pages buffered
+	if (waiters.isEmpty() && pages.size() > readAhead)
+		return;
+
+	qCDebug(logPaging) << "Streaming next paging object from"
+					   << lastPage.nextUrl().toString(QUrl::PrettyDecoded | QUrl::RemoveUserInfo);
+	fetching = true;
+	watch(lastPage.template next<EO>());
+}
+
+template <typename T, typename EO>
+typename PagingStreamData<T, EO>::Delivery PagingStreamData<T, EO>::collectDeliveries()
+{
+	Delivery delivery;
+	while (!waiters.isEmpty()) {
+		if (hasItem())
+			delivery.append(std::make_pair(waiters.dequeue(), std::make_optional(take())));
+		else if (isDone())
+			delivery.append(std::make_pair(waiters.dequeue(), std::optional<T>{}));
+		else
+			break;
+	}
+	return delivery;
+}
+
+template <typename T, typename EO>
+void PagingStreamData<T, EO>::drain(QMutexLocker &locker)
+{
+	// handlers that request the next item only enqueue it, the drain already running delivers it
+	// after they returned. This way, taking buffered items does not recurse
+	if (draining)
+		return;
+	draining = true;
+	forever {
+		const auto delivery = collectDeliveries();
+		maybeFetch();
+		if (delivery.isEmpty())
+			break;
+		locker.unlock();
+		for (const auto &entry : delivery)
+			entry.first(entry.second);
+		locker.relock();
+	}
+	draining = false;
+}
+
+}
+
+template <typename T, typename EO>
+PagingStream<T, EO>::PagingStream(GenericRestReply<Paging<T>, EO> *reply, int readAhead) :
+	d{QSharedPointer<__private::PagingStreamData<T, EO>>::create()}
+{
+	d->readAhead = readAhead;
+	d->fetching = true;
+	d->watch(reply);
+}
+
+template <typename T, typename EO>
+PagingStream<T, EO>::PagingStream(const Paging<T> &paging, int readAhead) :
+	d{QSharedPointer<__private::PagingStreamData<T, EO>>::create()}
+{
+	d->readAhead = readAhead;
+	d->appendPage(paging);
+}
+
+template <typename T, typename EO>
+bool PagingStream<T, EO>::isValid() const
+{
+	return static_cast<bool>(d);
+}
+
+template <typename T, typename EO>
+bool PagingStream<T, EO>::atEnd() const
+{
+	QMutexLocker locker{&d->mutex};
+	return d->isDone();
+}
+
+template <typename T, typename EO>
+qint64 PagingStream<T, EO>::bufferedItems() const
+{
+	QMutexLocker locker{&d->mutex};
+	qint64 count = -d->position;
+	for (const auto &page : qAsConst(d->pages))
+		count += page.size();
+	return count;
+}
+
+template <typename T, typename EO>
+std::optional<typename PagingStream<T, EO>::exceptionType> PagingStream<T, EO>::error() const
+{
+	QMutexLocker locker{&d->mutex};
+	return d->error;
+}
+
+template <typename T, typename EO>
+int PagingStream<T, EO>::readAhead() const
+{
+	QMutexLocker locker{&d->mutex};
+	return d->readAhead;
+}
+
+template <typename T, typename EO>
+void PagingStream<T, EO>::setReadAhead(int readAhead)
+{
+	QMutexLocker locker{&d->mutex};
+	d->readAhead = readAhead;
+	d->maybeFetch();
+}
+
+template <typename T, typename EO>
+PagingStream<T, EO> &PagingStream<T, EO>::onAllErrors(const std::function<void (QString, int, RestReply::Error)> &handler, const std::function<QString (EO, int)> &failureTransformer)
+{
+	QMutexLocker locker{&d->mutex};
+	d->errorHandler = handler;
+	d->failureTransformer = failureTransformer;
+	return *this;
+}
+
+template <typename T, typename EO>
+void PagingStream<T, EO>::next(ItemHandler handler)
+{
+	d->request(std::move(handler));
+}
+
+#ifdef QT_RESTCLIENT_USE_COROUTINES
+template <typename T, typename EO>
+typename PagingStream<T, EO>::NextAwaitable PagingStream<T, EO>::next()
+{
+	return NextAwaitable{d};
+}
+
+template <typename T, typename EO>
+PagingStream<T, EO>::NextAwaitable::NextAwaitable(QSharedPointer<__private::PagingStreamData<T, EO>> data) :
+	_data{std::move(data)}
+{}
+
+template <typename T, typename EO>
+bool PagingStream<T, EO>::NextAwaitable::await_ready()
+{
+	QMutexLocker locker{&_data->mutex};
+	if (_data->hasItem()) {
+		_result = _data->take();
+		_data->maybeFetch();
+		return true;
+	} else
+		return _data->isDone();
+}
+
+template <typename T, typename EO>
+void PagingStream<T, EO>::NextAwaitable::await_suspend(std::coroutine_handle<> handle)
+{
+	_data->request([this, handle](std::optional<T> item) {
+		_result = std::move(item);
+		handle.resume();
+	});
+}
+
+template <typename T, typename EO>
+std::optional<T> PagingStream<T, EO>::NextAwaitable::await_resume()
+{
+	if (!_result) {
+		QMutexLocker locker{&_data->mutex};
+		if (const auto error = _data->error; error) {
+			locker.unlock();
+			error->raise();
+		}
+	}
+	return std::move(_result);
+}
+#endif
+
+}
+
+#endif // QTRESTCLIENT_PAGINGSTREAM_H
@@ -7,6 +7,9 @@
 #include <QtCore/qobject.h>
 #include <QtCore/qbytearray.h>
 #include <QtCore/qloggingcategory.h>
+#include <QtCore/qmetatype.h>
+
+#include <chrono>
 
 #ifndef QT_STATIC
 #  if defined(QT_BUILD_RESTCLIENT_LIB)
@@ -22,6 +25,12 @@
 #define QT_RESTCLIENT_USE_ASYNC
 #endif
 
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define QT_RESTCLIENT_USE_COROUTINES
+#endif
+#endif
+
 //! The Namespace containing all classes of the QtRestClient module
 namespace QtRestClient {
 
@@ -46,4 +55,10 @@ Q_RESTCLIENT_EXPORT Q_DECLARE_LOGGING_CATEGORY(logGlobal)
 
 }
 
+// durations are used as property types. Qt 6 registers them automatically
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+Q_DECLARE_METATYPE(std::chrono::milliseconds)
+Q_DECLARE_METATYPE(std::chrono::seconds)
+#endif
+
 #endif // QTRESTCLIENT_GLOBAL_H
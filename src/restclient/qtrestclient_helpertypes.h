@@ -25,7 +25,27 @@ overload(Ts...) -> overload<Ts...>;
 namespace __binder {
 
 using DataType = std::variant<std::nullopt_t, QCborValue, QJsonValue>;
-using FunctionType = std::function<void(int, DataType)>;
+
+// all conversions only share the underlying containers, the data is never copied
+template <typename T>
+inline T valueAs(const QCborValue &value) {
+	if constexpr (std::is_same_v<T, QCborMap>)
+		return value.toMap();
+	else if constexpr (std::is_same_v<T, QCborArray>)
+		return value.toArray();
+	else
+		return value;
+}
+
+template <typename T>
+inline T valueAs(const QJsonValue &value) {
+	if constexpr (std::is_same_v<T, QJsonObject>)
+		return value.toObject();
+	else if constexpr (std::is_same_v<T, QJsonArray>)
+		return value.toArray();
+	else
+		return value;
+}
 
 template <typename... TArgs>
 struct FnBinder;
@@ -33,7 +53,7 @@ struct FnBinder;
 template <>
 struct FnBinder<int, DataType> {
 	template <typename TFn>
-	static inline FunctionType bind(TFn &&fn) {
+	static inline auto bind(TFn &&fn) {
 		return std::forward<TFn>(fn);
 	}
 };
@@ -41,7 +61,7 @@ struct FnBinder<int, DataType> {
 template <>
 struct FnBinder<> {
 	template <typename TFn>
-	static inline FunctionType bind(TFn &&fn) {
+	static inline auto bind(TFn &&fn) {
 		return [xFn = std::forward<TFn>(fn)](int, const DataType &) {
 			xFn();
 		};
@@ -51,7 +71,7 @@ struct FnBinder<> {
 template <>
 struct FnBinder<int> {
 	template <typename TFn>
-	static inline FunctionType bind(TFn &&fn) {
+	static inline auto bind(TFn &&fn) {
 		return [xFn = std::forward<TFn>(fn)](int code, const DataType &) {
 			xFn(code);
 		};
@@ -61,7 +81,7 @@ struct FnBinder<int> {
 template <typename TData>
 struct FnBinder<TData> {
 	template <typename TFn>
-	static inline FunctionType bind(TFn &&fn) {
+	static inline auto bind(TFn &&fn) {
 		return FnBinder<int, TData>::bind([xFn = std::forward<TFn>(fn)](int, const TData &value) {  // TData is already decayed -> true move
 			xFn(value);
 		});
@@ -71,16 +91,16 @@ struct FnBinder<TData> {
 template <>
 struct FnBinder<int, QJsonValue> {
 	template <typename TFn>
-	static inline FunctionType bind(TFn &&fn) {
+	static inline auto bind(TFn &&fn) {
 		return [xFn = std::forward<TFn>(fn)](int code, const DataType &value) {
 			std::visit(overload {
-						   [xFn, code](std::nullopt_t){
+						   [&](std::nullopt_t){
 							   xFn(code, QJsonValue{QJsonValue::Undefined});
 						   },
-						   [xFn, code](const QCborValue &){
+						   [&](const QCborValue &){
 							   qCWarning(logGlobal, "CBOR data in JSON callback - discarding");
 						   },
-						   [xFn, code](const QJsonValue &vValue){
+						   [&](const QJsonValue &vValue){
 							   xFn(code, vValue);
 						   }
 					   }, value);
@@ -91,16 +111,16 @@ struct FnBinder<int, QJsonValue> {
 template <>
 struct FnBinder<int, QJsonObject> {
 	template <typename TFn>
-	static inline FunctionType bind(TFn &&fn) {
+	static inline auto bind(TFn &&fn) {
 		return [xFn = std::forward<TFn>(fn)](int code, const DataType &value) {
 			std::visit(overload {
-						   [xFn, code](std::nullopt_t){
+						   [&](std::nullopt_t){
 							   xFn(code, QJsonObject{});
 						   },
-						   [xFn, code](const QCborValue &){
+						   [&](const QCborValue &){
 							   qCWarning(logGlobal, "CBOR data in JSON callback - discarding");
 						   },
-						   [xFn, code](const QJsonValue &vValue){
+						   [&](const QJsonValue &vValue){
 							   xFn(code, vValue.toObject());
 						   }
 					   }, value);
@@ -111,16 +131,16 @@ struct FnBinder<int, QJsonObject> {
 template <>
 struct FnBinder<int, QJsonArray> {
 	template <typename TFn>
-	static inline FunctionType bind(TFn &&fn) {
+	static inline auto bind(TFn &&fn) {
 		return [xFn = std::forward<TFn>(fn)](int code, const DataType &value) {
 			std::visit(overload {
-						   [xFn, code](std::nullopt_t){
+						   [&](std::nullopt_t){
 							   xFn(code, QJsonArray{});
 						   },
-						   [xFn, code](const QCborValue &){
+						   [&](const QCborValue &){
 							   qCWarning(logGlobal, "CBOR data in JSON callback - discarding");
 						   },
-						   [xFn, code](const QJsonValue &vValue){
+						   [&](const QJsonValue &vValue){
 							   xFn(code, vValue.toArray());
 						   }
 					   }, value);
@@ -131,16 +151,16 @@ struct FnBinder<int, QJsonArray> {
 template <>
 struct FnBinder<int, QCborValue> {
 	template <typename TFn>
-	static inline FunctionType bind(TFn &&fn) {
+	static inline auto bind(TFn &&fn) {
 		return [xFn = std::forward<TFn>(fn)](int code, const DataType &value) {
 			std::visit(overload {
-						   [xFn, code](std::nullopt_t){
+						   [&](std::nullopt_t){
 							   xFn(code, QCborValue{QCborSimpleType::Undefined});
 						   },
-						   [xFn, code](const QCborValue &vValue){
+						   [&](const QCborValue &vValue){
 							   xFn(code, vValue);
 						   },
-						   [xFn, code](const QJsonValue &){
+						   [&](const QJsonValue &){
 							   qCWarning(logGlobal, "JSON data in CBOR callback - discarding");
 						   }
 					   }, value);
@@ -151,16 +171,16 @@ struct FnBinder<int, QCborValue> {
 template <>
 struct FnBinder<int, QCborMap> {
 	template <typename TFn>
-	static inline FunctionType bind(TFn &&fn) {
+	static inline auto bind(TFn &&fn) {
 		return [xFn = std::forward<TFn>(fn)](int code, const DataType &value) {
 			std::visit(overload {
-						   [xFn, code](std::nullopt_t){
+						   [&](std::nullopt_t){
 							   xFn(code, QCborMap{});
 						   },
-						   [xFn, code](const QCborValue &vValue){
+						   [&](const QCborValue &vValue){
 							   xFn(code, vValue.toMap());
 						   },
-						   [xFn, code](const QJsonValue &){
+						   [&](const QJsonValue &){
 							   qCWarning(logGlobal, "JSON data in CBOR callback - discarding");
 						   }
 					   }, value);
@@ -171,16 +191,16 @@ struct FnBinder<int, QCborMap> {
 template <>
 struct FnBinder<int, QCborArray> {
 	template <typename TFn>
-	static inline FunctionType bind(TFn &&fn) {
+	static inline auto bind(TFn &&fn) {
 		return [xFn = std::forward<TFn>(fn)](int code, const DataType &value) {
 			std::visit(overload {
-						   [xFn, code](std::nullopt_t){
+						   [&](std::nullopt_t){
 							   xFn(code, QCborArray{});
 						   },
-						   [xFn, code](const QCborValue &vValue){
+						   [&](const QCborValue &vValue){
 							   xFn(code, vValue.toArray());
 						   },
-						   [xFn, code](const QJsonValue &){
+						   [&](const QJsonValue &){
 							   qCWarning(logGlobal, "JSON data in CBOR callback - discarding");
 						   }
 					   }, value);
@@ -191,19 +211,17 @@ struct FnBinder<int, QCborArray> {
 template <typename TCbor, typename TJson>
 struct FnBinder<int, std::variant<std::nullopt_t, TCbor, TJson>> {
 	template <typename TFn>
-	static inline FunctionType bind(TFn &&fn) {
+	static inline auto bind(TFn &&fn) {
 		return [xFn = std::forward<TFn>(fn)](int code, const DataType &value) {
-			auto cFn = FnBinder<int, TCbor>::bind(xFn)(code, value);
-			auto jFn = FnBinder<int, TJson>::bind(xFn)(code, value);
 			std::visit(overload {
-						   [xFn, code](std::nullopt_t){
+						   [&](std::nullopt_t){
 							   xFn(code, std::nullopt);
 						   },
-						   [xcFn = std::move(cFn), code](const QCborValue &vValue){
-							   xcFn(code, vValue);
+						   [&](const QCborValue &vValue){
+							   xFn(code, valueAs<TCbor>(vValue));
 						   },
-						   [xjFn = std::move(jFn), code](const QJsonValue &vValue){
-							   xjFn(code, vValue);
+						   [&](const QJsonValue &vValue){
+							   xFn(code, valueAs<TJson>(vValue));
 						   }
 					   }, value);
 		};
@@ -213,19 +231,17 @@ struct FnBinder<int, std::variant<std::nullopt_t, TCbor, TJson>> {
 template <typename TCbor, typename TJson>
 struct FnBinder<int, std::variant<TCbor, TJson>> {
 	template <typename TFn>
-	static inline FunctionType bind(TFn &&fn) {
+	static inline auto bind(TFn &&fn) {
 		return [xFn = std::forward<TFn>(fn)](int code, const DataType &value) {
-			auto cFn = FnBinder<int, TCbor>::bind(xFn)(code, value);
-			auto jFn = FnBinder<int, TJson>::bind(xFn)(code, value);
 			std::visit(overload {
-						   [xFn, code](std::nullopt_t){
+						   [&](std::nullopt_t){
 							   xFn(code, std::variant<TCbor, TJson>{});
 						   },
-						   [xcFn = std::move(cFn), code](const QCborValue &vValue){
-							   xcFn(code, vValue);
+						   [&](const QCborValue &vValue){
+							   xFn(code, valueAs<TCbor>(vValue));
 						   },
-						   [xjFn = std::move(jFn), code](const QJsonValue &vValue){
-							   xjFn(code, vValue);
+						   [&](const QJsonValue &vValue){
+							   xFn(code, valueAs<TJson>(vValue));
 						   }
 					   }, value);
 		};
@@ -269,13 +285,14 @@ struct FnInfo<TRet(TClass::*(TBinders...))(TArgs...)>
 
 }
 
+// the bound functor is passed to QObject::connect as is, without an intermediate std::function
 template <typename TFn>
-static inline __binder::FunctionType bindCallback(TFn &&fn) {
+static inline auto bindCallback(TFn &&fn) {
 	return __binder::FnInfo<std::decay_t<TFn>>::Binder::bind(std::forward<TFn>(fn));
 }
 
 template <typename TFn, typename TError>
-static inline __binder::FunctionType bindCallback(const std::function<void(QString, int, TError)> &handler, TFn &&tFn, TError errorType) {
+static inline auto bindCallback(const std::function<void(QString, int, TError)> &handler, TFn &&tFn, TError errorType) {
 	return bindCallback([handler, xTFn = std::forward<TFn>(tFn), errorType](int code, auto &&data) {
 		handler(xTFn(data, code), code, errorType);
 	});
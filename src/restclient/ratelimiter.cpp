@@ -0,0 +1,169 @@
+#include "ratelimiter.h"
+#include "ratelimiter_p.h"
+#include "restreply_p.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QtCore/QDateTime>
+using namespace QtRestClient;
+using namespace std::chrono;
+
+Q_LOGGING_CATEGORY(QtRestClient::logRateLimiter, "qt.restclient.RateLimiter")
+
+// ------------- Private Implementation -------------
+
+RateLimiter::RateLimiter(RateLimiterSettings settings) :
+	_settings{std::move(settings)}
+{
+	_clock.start();
+}
+
+const RateLimiterSettings &RateLimiter::settings() const
+{
+	return _settings;
+}
+
+QString RateLimiter::bucket(const QNetworkRequest &request) const
+{
+	return RestReplyPrivate::routeKey(request, _settings.scope == RateLimiterSettings::Scope::Route);
+}
+
+milliseconds RateLimiter::reserve(const QString &bucket)
+{
+	QMutexLocker _{&_mutex};
+	const auto now = _clock.elapsed();
+	auto &current = refill(bucket, now);
+	current.tokens -= 1.0;
+
+	milliseconds wait {0};
+	if (current.tokens < 0.0)
+		wait = milliseconds{static_cast<qint64>(std::ceil(-current.tokens * 1000.0 / rate(current, now)))};
+	// tokens are only added again once the server accepts requests again
+	if (current.blockedUntil > now)
+		wait += milliseconds{current.blockedUntil - now};
+	return wait;
+}
+
+bool RateLimiter::tryTake(const QString &bucket)
+{
+	QMutexLocker _{&_mutex};
+	const auto now = _clock.elapsed();
+	auto &current = refill(bucket, now);
+	if (current.tokens < 1.0 || current.blockedUntil > now)
+		return false;
+	current.tokens -= 1.0;
+	return true;
+}
+
+void RateLimiter::update(const QString &bucket, QNetworkReply *reply)
+{
+	const auto status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+	auto remainingHeader = reply->rawHeader("RateLimit-Remaining");
+	if (remainingHeader.isEmpty())
+		remainingHeader = reply->rawHeader("X-RateLimit-Remaining");
+	auto hasRemaining = false;
+	const auto remaining = remainingHeader.trimmed().toInt(&hasRemaining);
+	if (status != 429 && (!_settings.adaptive || !hasRemaining))
+		return;
+
+	const auto reset = resetDelay(reply);
+
+	QMutexLocker _{&_mutex};
+	const auto now = _clock.elapsed();
+	auto &current = refill(bucket, now);
+	if (status == 429) {
+		auto backoff = retryAfterDelay(reply);
+		if (!backoff)
+			backoff = reset;
+		const auto pause = backoff.value_or(TooManyRequestsBackoff);
+		qCWarning(logRateLimiter) << "Server rejected requests to" << bucket
+								  << "- pausing them for" << pause.count() << "milliseconds";
+		current.blockedUntil = std::max(current.blockedUntil, now + pause.count());
+		current.tokens = std::min(current.tokens, 0.0);
+	} else {
+		// the bucket never holds more than what the server has left
+		current.tokens = std::min(current.tokens, static_cast<double>(remaining));
+		if (!reset)
+			return;
+		if (remaining <= 0) {
+			qCDebug(logRateLimiter) << "Quota of" << bucket << "is used up - pausing requests for"
+									<< reset->count() << "milliseconds";
+			current.blockedUntil = std::max(current.blockedUntil, now + reset->count());
+		} else if (reset->count() > 0) {
+			// spread the remaining quota until it is reset
+			current.quotaRate = remaining * 1000.0 / reset->count();
+			current.quotaUntil = now + reset->count();
+		}
+	}
+}
+
+RateLimiter::Bucket &RateLimiter::refill(const QString &bucket, qint64 now)
+{
+	auto it = _buckets.find(bucket);
+	if (it == _buckets.end())
+		return *_buckets.insert(bucket, Bucket{static_cast<double>(_settings.burst), now});
+
+	// no tokens are added while the server rejects requests
+	const auto from = std::max(it->updated, it->blockedUntil);
+	if (now > from)
+		it->tokens = std::min(static_cast<double>(_settings.burst), it->tokens + (now - from) * rate(*it, now) / 1000.0);
+	it->updated = now;
+	return *it;
+}
+
+double RateLimiter::rate(const Bucket &bucket, qint64 now) const
+{
+	if (bucket.quotaRate > 0.0 && bucket.quotaUntil > now)
+		return std::min(_settings.rate, bucket.quotaRate);
+	else
+		return _settings.rate;
+}
+
+std::optional<milliseconds> RateLimiter::resetDelay(QNetworkReply *reply) const
+{
+	// the standardized header is always relative
+	if (const auto value = reply->rawHeader("RateLimit-Reset").trimmed(); !value.isEmpty())
+		return deltaSeconds(value);
+
+	const auto value = reply->rawHeader("X-RateLimit-Reset").trimmed();
+	if (value.isEmpty())
+		return std::nullopt;
+	switch (_settings.resetFormat) {
+	case RateLimiterSettings::ResetFormat::DeltaSeconds:
+		return deltaSeconds(value);
+	case RateLimiterSettings::ResetFormat::UnixTime: {
+		auto ok = false;
+		const auto resetAt = value.toLongLong(&ok);
+		if (!ok)
+			return std::nullopt;
+		return duration_cast<milliseconds>(seconds{std::max<qint64>(resetAt - QDateTime::currentSecsSinceEpoch(), 0)});
+	}
+	default:
+		Q_UNREACHABLE();
+	}
+}
+
+std::optional<milliseconds> RateLimiter::retryAfterDelay(QNetworkReply *reply)
+{
+	const auto value = reply->rawHeader("Retry-After").trimmed();
+	if (value.isEmpty())
+		return std::nullopt;
+	if (const auto delay = deltaSeconds(value); delay)
+		return delay;
+
+	// otherwise it is a HTTP-date
+	const auto date = QDateTime::fromString(QString::fromLatin1(value), Qt::RFC2822Date);
+	if (!date.isValid())
+		return std::nullopt;
+	return milliseconds{std::max<qint64>(QDateTime::currentDateTimeUtc().msecsTo(date), 0)};
+}
+
+std::optional<milliseconds> RateLimiter::deltaSeconds(const QByteArray &value)
+{
+	auto ok = false;
+	const auto secs = value.toLongLong(&ok);
+	if (!ok)
+		return std::nullopt;
+	return duration_cast<milliseconds>(seconds{std::max<qint64>(secs, 0)});
+}
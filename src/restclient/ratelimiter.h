@@ -0,0 +1,43 @@
+#ifndef QTRESTCLIENT_RATELIMITER_H
+#define QTRESTCLIENT_RATELIMITER_H
+
+#include "QtRestClient/qtrestclient_global.h"
+
+#include <optional>
+
+namespace QtRestClient {
+
+//! The settings of the rate limiter of a RestClient
+struct Q_RESTCLIENT_EXPORT RateLimiterSettings
+{
+	//! Specifies which requests share a quota
+	enum class Scope {
+		Host,  //!< All requests to the same host and port
+		Route  //!< All requests to the same host and port, that were created by the same RestClass
+	};
+
+	//! Specifies how the `X-RateLimit-Reset` header of the server is read
+	enum class ResetFormat {
+		DeltaSeconds,  //!< The number of seconds until the quota is reset
+		UnixTime  //!< The point in time the quota is reset, in seconds since the unix epoch
+	};
+
+	//! Specifies which requests share a quota
+	Scope scope = Scope::Host;
+	//! The number of requests per second that may be sent, on average
+	double rate = 10.0;
+	//! The number of requests that may be sent at once after being idle
+	int burst = 10;
+	//! Specifies whether the quota headers of replies slow down the rate
+	bool adaptive = true;
+	//! Specifies how the `X-RateLimit-Reset` header of the server is read
+	ResetFormat resetFormat = ResetFormat::DeltaSeconds;
+	//! How often a request that was rejected with status 429 is queued again, before it fails
+	int maxRequeues = 3;
+};
+
+}
+
+Q_DECLARE_METATYPE(std::optional<QtRestClient::RateLimiterSettings>)
+
+#endif // QTRESTCLIENT_RATELIMITER_H
@@ -0,0 +1,64 @@
+#ifndef QTRESTCLIENT_RATELIMITER_P_H
+#define QTRESTCLIENT_RATELIMITER_P_H
+
+#include "ratelimiter.h"
+
+#include <chrono>
+#include <optional>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QLoggingCategory>
+
+#include <QtNetwork/QNetworkReply>
+
+namespace QtRestClient {
+
+// token buckets of a client, which reserve a send slot for every request
+class Q_RESTCLIENT_EXPORT RateLimiter
+{
+	Q_DISABLE_COPY(RateLimiter)
+public:
+	static constexpr std::chrono::seconds TooManyRequestsBackoff {1};
+
+	explicit RateLimiter(RateLimiterSettings settings);
+
+	const RateLimiterSettings &settings() const;
+
+	QString bucket(const QNetworkRequest &request) const;
+	// takes a token and returns how long the request has to wait for it
+	std::chrono::milliseconds reserve(const QString &bucket);
+	// only takes a token if one is available right away
+	bool tryTake(const QString &bucket);
+	// adapts the bucket to the quota reported by the server
+	void update(const QString &bucket, QNetworkReply *reply);
+
+private:
+	struct Bucket {
+		// negative while requests are waiting for tokens
+		double tokens;
+		qint64 updated;
+		// the remaining quota of the server, the rate is limited to spread it until the reset
+		double quotaRate = -1.0;
+		qint64 quotaUntil = 0;
+		qint64 blockedUntil = 0;
+	};
+
+	const RateLimiterSettings _settings;
+	QElapsedTimer _clock;
+	mutable QMutex _mutex;
+	QHash<QString, Bucket> _buckets;
+
+	Bucket &refill(const QString &bucket, qint64 now);
+	double rate(const Bucket &bucket, qint64 now) const;
+	std::optional<std::chrono::milliseconds> resetDelay(QNetworkReply *reply) const;
+	static std::optional<std::chrono::milliseconds> retryAfterDelay(QNetworkReply *reply);
+	static std::optional<std::chrono::milliseconds> deltaSeconds(const QByteArray &value);
+};
+
+Q_DECLARE_LOGGING_CATEGORY(logRateLimiter)
+
+}
+
+#endif // QTRESTCLIENT_RATELIMITER_P_H
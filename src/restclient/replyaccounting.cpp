@@ -0,0 +1,104 @@
+#include "replyaccounting_p.h"
+
+#include <QtCore/QTimer>
+using namespace QtRestClient;
+using namespace std::chrono;
+
+void ReplyAccounting::attach(QNetworkReply *reply, QSharedPointer<CircuitBreaker> circuitBreaker, QString circuit, QDeadlineTimer deadline, QSharedPointer<RateLimiter> rateLimiter)
+{
+	// owned by the reply, so it lives in the same thread
+	new ReplyAccounting{reply, std::move(circuitBreaker), std::move(circuit), deadline, std::move(rateLimiter)};
+}
+
+ReplyAccounting *ReplyAccounting::of(QNetworkReply *reply)
+{
+	return reply ?
+			   reply->findChild<ReplyAccounting*>(QString{}, Qt::FindDirectChildrenOnly) :
+			   nullptr;
+}
+
+CircuitBreaker::Outcome ReplyAccounting::outcomeOf(QNetworkReply *reply)
+{
+	// only server errors and failed connections count against a circuit
+	const auto error = reply->error();
+	if (error == QNetworkReply::OperationCanceledError)
+		return CircuitBreaker::Outcome::Canceled;
+	else if (const auto status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+			 status >= 500 || (status == 0 && error != QNetworkReply::NoError))
+		return CircuitBreaker::Outcome::Failure;
+	else
+		return CircuitBreaker::Outcome::Success;
+}
+
+ReplyAccounting::~ReplyAccounting()
+{
+	// replies deleted while still running never finish
+	finish(CircuitBreaker::Outcome::Canceled);
+}
+
+bool ReplyAccounting::takeOver()
+{
+	return _done.testAndSetOrdered(false, true);
+}
+
+QString ReplyAccounting::circuit() const
+{
+	return _circuit;
+}
+
+QElapsedTimer ReplyAccounting::timer() const
+{
+	return _timer;
+}
+
+bool ReplyAccounting::takeOverDeadline()
+{
+	return _deadlineState.testAndSetOrdered(DeadlineWatched, DeadlineTakenOver) ||
+		   _deadlineState.loadAcquire() == DeadlineTakenOver;
+}
+
+bool ReplyAccounting::hasTimedOut() const
+{
+	return _deadlineState.loadAcquire() == DeadlineExpired;
+}
+
+bool ReplyAccounting::takeOverRateLimit()
+{
+	return _rateLimitDone.testAndSetOrdered(false, true);
+}
+
+ReplyAccounting::ReplyAccounting(QNetworkReply *reply, QSharedPointer<CircuitBreaker> circuitBreaker, QString circuit, QDeadlineTimer deadline, QSharedPointer<RateLimiter> rateLimiter) :
+	QObject{reply},
+	_circuitBreaker{std::move(circuitBreaker)},
+	_circuit{std::move(circuit)},
+	_rateLimiter{std::move(rateLimiter)}
+{
+	_timer.start();
+	connect(reply, &QNetworkReply::finished,
+			this, [this, reply]() {
+				// replies aborted at their deadline are just what the circuit breaker protects against
+				finish(hasTimedOut() ? CircuitBreaker::Outcome::Failure : outcomeOf(reply));
+				if (_rateLimiter && takeOverRateLimit())
+					_rateLimiter->update(_rateLimiter->bucket(reply->request()), reply);
+			});
+
+	// requests that spent their whole deadline in the send queue are aborted right away, but
+	// deferred, so the caller can connect to the reply before it finishes
+	if (!deadline.isForever()) {
+		auto deadlineTimer = new QTimer{this};
+		deadlineTimer->setSingleShot(true);
+		deadlineTimer->setTimerType(Qt::PreciseTimer);
+		connect(deadlineTimer, &QTimer::timeout,
+				this, [this, reply]() {
+					if (!reply->isFinished() && _deadlineState.testAndSetOrdered(DeadlineWatched, DeadlineExpired))
+						reply->abort();
+				});
+		deadlineTimer->start(std::chrono::ceil<milliseconds>(deadline.remainingTimeAsDuration()));
+	}
+}
+
+void ReplyAccounting::finish(CircuitBreaker::Outcome outcome)
+{
+	if (takeOver() && _circuitBreaker)
+		_circuitBreaker->release(_circuit, outcome, milliseconds{_timer.elapsed()});
+}
@@ -0,0 +1,71 @@
+#ifndef QTRESTCLIENT_REPLYACCOUNTING_P_H
+#define QTRESTCLIENT_REPLYACCOUNTING_P_H
+
+#include "circuitbreaker_p.h"
+#include "ratelimiter_p.h"
+
+#include <QtCore/QAtomicInteger>
+#include <QtCore/QDeadlineTimer>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QObject>
+#include <QtCore/QSharedPointer>
+
+#include <QtNetwork/QNetworkReply>
+
+namespace QtRestClient {
+
+// evaluates a sent network reply for the circuit breaker and the rate limiter and aborts it at its
+// deadline, unless a RestReply takes it over. This way, raw replies and reply handles are guarded
+// as well
+class Q_RESTCLIENT_EXPORT ReplyAccounting : public QObject
+{
+	Q_OBJECT
+public:
+	static void attach(QNetworkReply *reply,
+					   QSharedPointer<CircuitBreaker> circuitBreaker,
+					   QString circuit,
+					   QDeadlineTimer deadline,
+					   QSharedPointer<RateLimiter> rateLimiter);
+	// returns nullptr for replies that are not guarded at all
+	static ReplyAccounting *of(QNetworkReply *reply);
+	static CircuitBreaker::Outcome outcomeOf(QNetworkReply *reply);
+
+	~ReplyAccounting() override;
+
+	// hands the evaluation to the caller, returns false if the reply was already evaluated
+	bool takeOver();
+	QString circuit() const;
+	QElapsedTimer timer() const;
+	// hands the deadline to the caller, returns false if the reply was already aborted
+	bool takeOverDeadline();
+	bool hasTimedOut() const;
+	// hands the quota headers to the caller, returns false if they were already read
+	bool takeOverRateLimit();
+
+private:
+	enum DeadlineState {
+		DeadlineWatched,
+		DeadlineTakenOver,
+		DeadlineExpired
+	};
+
+	QSharedPointer<CircuitBreaker> _circuitBreaker;
+	const QString _circuit;
+	QElapsedTimer _timer;
+	QAtomicInteger<bool> _done = false;
+	QAtomicInt _deadlineState = DeadlineWatched;
+	QSharedPointer<RateLimiter> _rateLimiter;
+	QAtomicInteger<bool> _rateLimitDone = false;
+
+	ReplyAccounting(QNetworkReply *reply,
+					QSharedPointer<CircuitBreaker> circuitBreaker,
+					QString circuit,
+					QDeadlineTimer deadline,
+					QSharedPointer<RateLimiter> rateLimiter);
+
+	void finish(CircuitBreaker::Outcome outcome);
+};
+
+}
+
+#endif // QTRESTCLIENT_REPLYACCOUNTING_P_H
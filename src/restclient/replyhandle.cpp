@@ -0,0 +1,66 @@
+#include "replyhandle.h"
+#include "circuitbreaker_p.h"
+#include "replyaccounting_p.h"
+
+#include <utility>
+using namespace QtRestClient;
+
+ReplyHandle::ReplyHandle(ReplyHandle &&other) noexcept :
+	_state{std::exchange(other._state, nullptr)}
+{}
+
+ReplyHandle &ReplyHandle::operator=(ReplyHandle &&other) noexcept
+{
+	_state = std::exchange(other._state, nullptr);
+	return *this;
+}
+
+QNetworkReply *ReplyHandle::networkReply() const
+{
+	if (!_state)
+		return nullptr;
+	QMutexLocker _{&_state->mutex};
+	return _state->reply;
+}
+
+bool ReplyHandle::isFinished() const
+{
+	if (!_state)
+		return true;
+	QMutexLocker _{&_state->mutex};
+	return _state->sent && _state->finished;
+}
+
+void ReplyHandle::abort()
+{
+	if (!_state)
+		return;
+	QMutexLocker _{&_state->mutex};
+	if (!_state->sent)
+		_state->aborted = true;
+	else if (!_state->finished)  // the reply is only deleted after it was marked as finished
+		QMetaObject::invokeMethod(_state->reply, "abort");
+}
+
+ReplyHandle::Result ReplyHandle::resultOf(QNetworkReply *networkReply)
+{
+	Result result;
+	result.status = networkReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+	result.networkError = networkReply->error();
+	// the body is never read, so any HTTP error status is a failure, with or without data
+	if (const auto accounting = ReplyAccounting::of(networkReply); accounting && accounting->hasTimedOut()) {
+		result.error = RestReply::Error::Timeout;
+		result.networkError = QNetworkReply::TimeoutError;
+		result.errorString = QStringLiteral("The request did not complete before its deadline");
+	} else if (qobject_cast<RejectedNetworkReply*>(networkReply)) {
+		result.error = RestReply::Error::CircuitOpen;
+		result.errorString = networkReply->errorString();
+	} else if (result.status >= 300) {
+		result.error = RestReply::Error::Failure;
+		result.errorString = networkReply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toString();
+	} else if (result.networkError != QNetworkReply::NoError) {
+		result.error = RestReply::Error::Network;
+		result.errorString = networkReply->errorString();
+	}
+	return result;
+}
@@ -0,0 +1,169 @@
+#ifndef QTRESTCLIENT_REPLYHANDLE_H
+#define QTRESTCLIENT_REPLYHANDLE_H
+
+#include "QtRestClient/qtrestclient_global.h"
+#include "QtRestClient/restreply.h"
+
+#include <memory>
+#include <optional>
+
+#include <QtCore/qmutex.h>
+#include <QtCore/qsharedpointer.h>
+#include <QtCore/qthread.h>
+#ifdef QT_RESTCLIENT_USE_ASYNC
+#include <QtCore/qfuturewatcher.h>
+#endif
+
+#include <QtNetwork/qnetworkreply.h>
+
+namespace QtRestClient {
+
+namespace __private {
+
+// shared between a handle and the thread of its network reply
+struct ReplyHandleState
+{
+	QMutex mutex;
+	QNetworkReply *reply = nullptr;
+	bool sent = false;
+	bool finished = false;
+	bool aborted = false;
+};
+
+}
+
+//! A lightweight, move-only handle to a request that only reports whether it succeeded
+class Q_RESTCLIENT_EXPORT ReplyHandle
+{
+	Q_DISABLE_COPY(ReplyHandle)
+
+public:
+	//! The outcome of a finished request, passed to the completion handler
+	struct Result {
+		//! The HTTP status code of the response, or 0 if no response was received
+		int status = 0;
+		//! The error type, if the request did not succeed
+		std::optional<RestReply::Error> error;
+		//! The network error of the underlying reply
+		QNetworkReply::NetworkError networkError = QNetworkReply::NoError;
+		//! A description of the error, if the request did not succeed
+		QString errorString;
+
+		//! Returns true, if the request succeeded
+		inline bool succeeded() const {
+			return !error;
+		}
+	};
+
+	//! Creates an invalid handle
+	ReplyHandle() = default;
+	//! Move constructor
+	ReplyHandle(ReplyHandle &&other) noexcept;
+	//! Move assignment operator
+	ReplyHandle &operator=(ReplyHandle &&other) noexcept;
+	~ReplyHandle() = default;
+
+	//! Returns the network reply of the request, if it has already been sent and is not finished
+	QNetworkReply *networkReply() const;
+	//! Returns true, if the request is not running (anymore)
+	bool isFinished() const;
+	//! Aborts the request. The completion handler will still be called
+	void abort();
+
+	//! Creates a handle for the network reply that calls completion once it is finished
+	template <typename TFn>
+	static ReplyHandle create(QNetworkReply *networkReply, TFn &&completion);
+#ifdef QT_RESTCLIENT_USE_ASYNC
+	//! Creates a handle for the future network reply that calls completion once it is finished
+	template <typename TFn>
+	static ReplyHandle create(const QFuture<QNetworkReply*> &networkReplyFuture, TFn &&completion);
+#endif
+
+private:
+	QSharedPointer<__private::ReplyHandleState> _state;
+
+	static Result resultOf(QNetworkReply *networkReply);
+	template <typename TFn>
+	static void connectFinished(const QSharedPointer<__private::ReplyHandleState> &state, QObject *watcher, TFn &&completion);
+};
+
+// ------------- Generic Implementation -------------
+
+template <typename TFn>
+ReplyHandle ReplyHandle::create(QNetworkReply *networkReply, TFn &&completion)
+{
+	ReplyHandle handle;
+	handle._state = QSharedPointer<__private::ReplyHandleState>::create();
+	handle._state->reply = networkReply;
+	handle._state->sent = true;
+	connectFinished(handle._state, nullptr, std::forward<TFn>(completion));
+	return handle;
+}
+
+#ifdef QT_RESTCLIENT_USE_ASYNC
+template <typename TFn>
+ReplyHandle ReplyHandle::create(const QFuture<QNetworkReply*> &networkReplyFuture, TFn &&completion)
+{
+	if (networkReplyFuture.isFinished())
+		return create(networkReplyFuture.result(), std::forward<TFn>(completion));
+
+	// the reply is created on the thread of the network access manager, so wait for it first
+	ReplyHandle handle;
+	handle._state = QSharedPointer<__private::ReplyHandleState>::create();
+	auto watcher = new QFutureWatcher<QNetworkReply*>{};
+	QObject::connect(watcher, &QFutureWatcherBase::finished,
+					 watcher, [watcher, state = handle._state, xFn = std::forward<TFn>(completion)]() mutable {
+						 const auto reply = watcher->result();
+						 QMutexLocker locker{&state->mutex};
+						 state->reply = reply;
+						 state->sent = true;
+						 if (state->aborted)
+							 QMetaObject::invokeMethod(reply, "abort", Qt::QueuedConnection);
+						 locker.unlock();
+						 connectFinished(state, watcher, std::move(xFn));
+					 }, Qt::DirectConnection);
+	watcher->setFuture(networkReplyFuture);
+	return handle;
+}
+#endif
+
+template <typename TFn>
+void ReplyHandle::connectFinished(const QSharedPointer<__private::ReplyHandleState> &state, QObject *watcher, TFn &&completion)
+{
+	// a single connection, no reply object and no parsing of the body
+	const auto networkReply = state->reply;
+	const auto fn = std::make_shared<std::optional<std::decay_t<TFn>>>(std::forward<TFn>(completion));
+	const auto finish = [networkReply, state, watcher, fn]() {
+		// the reply may report both via its signal and via the check below
+		if (!*fn)
+			return;
+		auto xFn = std::move(**fn);
+		fn->reset();
+		{
+			QMutexLocker _{&state->mutex};
+			state->finished = true;
+			state->reply = nullptr;
+		}
+		xFn(resultOf(networkReply));
+		networkReply->deleteLater();
+		if (watcher)
+			watcher->deleteLater();
+	};
+	QObject::connect(networkReply, &QNetworkReply::finished, networkReply, finish);
+
+	// replies that finished before the connection was made, i.e. aborted or rejected ones, never
+	// emit finished again. The check runs on the thread of the reply, as it may finish any time
+	if (networkReply->thread() == QThread::currentThread()) {
+		if (networkReply->isFinished())
+			QMetaObject::invokeMethod(networkReply, finish, Qt::QueuedConnection);
+	} else {
+		QMetaObject::invokeMethod(networkReply, [networkReply, finish]() {
+			if (networkReply->isFinished())
+				finish();
+		}, Qt::QueuedConnection);
+	}
+}
+
+}
+
+#endif // QTRESTCLIENT_REPLYHANDLE_H
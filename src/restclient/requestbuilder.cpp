@@ -36,6 +36,12 @@ RequestBuilder &RequestBuilder::setExtender(RequestBuilder::IExtender *extender)
 	return *this;
 }
 
+RequestBuilder &RequestBuilder::setExtender(QSharedPointer<IExtender> extender)
+{
+	d->extender = std::move(extender);
+	return *this;
+}
+
 RequestBuilder &RequestBuilder::setCredentials(QString user, QString password)
 {
 	d->user = std::move(user);
@@ -150,10 +156,23 @@ RequestBuilder &RequestBuilder::setSslConfig(QSslConfiguration sslConfig)
 }
 #endif
 
+RequestBuilder &RequestBuilder::setDeadline(QDeadlineTimer deadline)
+{
+	d->deadline = std::move(deadline);
+	return *this;
+}
+
+RequestBuilder &RequestBuilder::setTimeout(std::chrono::milliseconds timeout)
+{
+	d->timeout = std::move(timeout);
+	return *this;
+}
+
 RequestBuilder &RequestBuilder::setBody(QByteArray body, const QByteArray &contentType, bool setAccept)
 {
 	d->body = std::move(body);
 	d->postQuery.clear();
+	d->bodyDevice.clear();
 	d->headers.insert(RequestBuilderPrivate::ContentType, contentType);
 	if (setAccept)
 		d->headers.insert(RequestBuilderPrivate::Accept, contentType);
@@ -164,6 +183,7 @@ RequestBuilder &RequestBuilder::setBody(QCborValue body, bool setAccept)
 {
 	d->body = body.toCbor();
 	d->postQuery.clear();
+	d->bodyDevice.clear();
 	d->headers.insert(RequestBuilderPrivate::ContentType, RequestBuilderPrivate::ContentTypeCbor);
 	if (setAccept)
 		d->headers.insert(RequestBuilderPrivate::Accept, RequestBuilderPrivate::ContentTypeCbor);
@@ -185,12 +205,24 @@ RequestBuilder &RequestBuilder::setBody(const QJsonValue &body, bool setAccept)
 		break;
 	}
 	d->postQuery.clear();
+	d->bodyDevice.clear();
 	d->headers.insert(RequestBuilderPrivate::ContentType, RequestBuilderPrivate::ContentTypeJson);
 	if (setAccept)
 		d->headers.insert(RequestBuilderPrivate::Accept, RequestBuilderPrivate::ContentTypeJson);
 	return *this;
 }
 
+RequestBuilder &RequestBuilder::setBody(QIODevice *device, const QByteArray &contentType, bool setAccept)
+{
+	d->body.clear();
+	d->postQuery.clear();
+	d->bodyDevice = device;
+	d->headers.insert(RequestBuilderPrivate::ContentType, contentType);
+	if (setAccept)
+		d->headers.insert(RequestBuilderPrivate::Accept, contentType);
+	return *this;
+}
+
 RequestBuilder &RequestBuilder::setVerb(QByteArray verb)
 {
 	d->verb = std::move(verb);
@@ -212,6 +244,7 @@ RequestBuilder &RequestBuilder::addPostParameter(const QString &name, const QStr
 {
 	d->postQuery.addQueryItem(name, value);
 	d->body.clear();
+	d->bodyDevice.clear();
 	d->headers.insert(RequestBuilderPrivate::ContentType, RequestBuilderPrivate::ContentTypeUrlEncoded);
 	return *this;
 }
@@ -221,6 +254,7 @@ RequestBuilder &RequestBuilder::addPostParameters(const QUrlQuery &parameters)
 	for (const auto &param : parameters.queryItems(QUrl::FullyDecoded)) // clazy:exclude=range-loop
 		d->postQuery.addQueryItem(param.first, param.second);
 	d->body.clear();
+	d->bodyDevice.clear();
 	d->headers.insert(RequestBuilderPrivate::ContentType, RequestBuilderPrivate::ContentTypeUrlEncoded);
 	return *this;
 }
@@ -265,7 +299,8 @@ QNetworkRequest RequestBuilder::build() const
 	if (d->extender && d->extender->requiresBody())
 		pBody = &bBody;
 
-	d->prepareRequest(request, pBody);
+	if (const auto failure = d->prepareRequest(request, pBody); !failure.isNull())
+		qCWarning(logBuilder).noquote() << failure;
 	if (d->extender) {
 		auto eVerb = d->verb;
 		d->extender->extendRequest(request, eVerb, pBody);
@@ -276,27 +311,35 @@ QNetworkRequest RequestBuilder::build() const
 
 QNetworkReply *RequestBuilder::send() const
 {
-	QNetworkRequest request{buildUrl()};
+	QNetworkRequest request{d->sendUrl(buildUrl())};
 	auto verb = d->verb;
 	QByteArray body;
-	d->prepareRequest(request, &body);
+	const auto pBody = d->sendBody(body);
+	const auto failure = d->prepareRequest(request, pBody);
+	d->prepareSend(request);
 	if (d->extender)
-		d->extender->extendRequest(request, verb, &body);
-	return RestReplyPrivate::compatSend(d->nam, request, verb, body);
+		d->extender->extendRequest(request, verb, pBody);
+	// synchronous sends cannot wait, so they bypass the rate limiter
+	return RestReplyPrivate::compatSend(d->nam, request, verb, body, d->bodyDevice, d->circuitBreaker, d->rateLimiter, failure);
 }
 
 #ifdef QT_RESTCLIENT_USE_ASYNC
 QFuture<QNetworkReply*> RequestBuilder::sendAsync() const
 {
-	QNetworkRequest request{buildUrl()};
+	QNetworkRequest request{d->sendUrl(buildUrl())};
 	auto verb = d->verb;
 	QByteArray body;
-	d->prepareRequest(request, &body);
+	const auto pBody = d->sendBody(body);
+	const auto failure = d->prepareRequest(request, pBody);
+	d->prepareSend(request);
 	if (d->extender)
-		d->extender->extendRequest(request, verb, &body);
+		d->extender->extendRequest(request, verb, pBody);
 
+	const auto delay = d->rateLimiter ?
+						   d->rateLimiter->reserve(d->rateLimiter->bucket(request)) :
+						   std::chrono::milliseconds{0};
 	QFutureInterface<QNetworkReply*> futureIf;
-	RestReplyPrivate::compatSendAsync(futureIf, d->nam, request, verb, body);
+	RestReplyPrivate::compatSendAsync(futureIf, d->nam, request, verb, body, d->bodyDevice, d->circuitBreaker, d->rateLimiter, delay, failure);
 	return futureIf.future();
 }
 #endif
@@ -308,6 +351,7 @@ const QByteArray RequestBuilderPrivate::ContentTypeCbor = "application/cbor";
 const QByteArray RequestBuilderPrivate::ContentTypeJson = "application/json";
 const QByteArray RequestBuilderPrivate::ContentTypeUrlEncoded = "application/x-www-form-urlencoded";
 const QByteArray RequestBuilderPrivate::Accept = "Accept";
+const QString RequestBuilderPrivate::SequentialBodyError = QStringLiteral("Unable to sign the body of a sequential device without consuming it");
 
 RequestBuilderPrivate::RequestBuilderPrivate(const QUrl &baseUrl, QNetworkAccessManager *nam) :
 	QSharedData{},
@@ -323,7 +367,7 @@ RequestBuilderPrivate::RequestBuilderPrivate(const QUrl &baseUrl, QNetworkAccess
 	verb{RestClass::GetVerb}
 {}
 
-void RequestBuilderPrivate::prepareRequest(QNetworkRequest &request, QByteArray *sBody) const
+QString RequestBuilderPrivate::prepareRequest(QNetworkRequest &request, QByteArray *sBody) const
 {
 	// add headers etc.
 	for (auto it = headers.constBegin(); it != headers.constEnd(); it++)
@@ -340,12 +384,48 @@ void RequestBuilderPrivate::prepareRequest(QNetworkRequest &request, QByteArray
 
 	// create the body
 	if (sBody) {
-		if (!body.isEmpty())
+		if (bodyDevice) {
+			// only read for extenders that sign the body, the device itself is streamed when sent
+			if (bodyDevice->isSequential())
+				return SequentialBodyError;
+			*sBody = bodyDevice->peek(bodyDevice->bytesAvailable());
+		} else if (!body.isEmpty())
 			*sBody = body;
 		else if (headers.value(RequestBuilderPrivate::ContentType) == RequestBuilderPrivate::ContentTypeUrlEncoded &&
 				 !postQuery.isEmpty())
 			*sBody = postQuery.query().toUtf8();
 	}
+	return {};
+}
+
+QByteArray *RequestBuilderPrivate::sendBody(QByteArray &sBody) const
+{
+	// streamed bodies are only materialized if the extender needs them
+	if (!bodyDevice || (extender && extender->requiresBody()))
+		return &sBody;
+	else
+		return nullptr;
+}
+
+QUrl RequestBuilderPrivate::sendUrl(const QUrl &url) const
+{
+	// the endpoint is chosen per request, so build() still returns URLs of the base URL
+	return endpoints ? endpoints->resolve(url) : url;
+}
+
+void RequestBuilderPrivate::prepareSend(QNetworkRequest &request) const
+{
+	// an empty route still marks the request as guarded by the circuit breaker
+	if (circuitBreaker || rateLimiter)
+		request.setAttribute(RestReplyPrivate::RouteAttribute, route);
+
+	// an explicit deadline replaces the timeout, which starts with sending, so time spent in the
+	// send queue counts against it
+	auto sendDeadline = deadline;
+	if (sendDeadline.isForever() && timeout.count() >= 0)
+		sendDeadline = QDeadlineTimer{timeout};
+	if (!sendDeadline.isForever())
+		request.setAttribute(RestReplyPrivate::DeadlineAttribute, sendDeadline.deadline());
 }
 
 RequestBuilder::IExtender::IExtender() = default;
@@ -3,13 +3,17 @@
 
 #include "QtRestClient/qtrestclient_global.h"
 
+#include <chrono>
+
 #include <QtCore/qcborvalue.h>
 #include <QtCore/qjsonvalue.h>
 #include <QtCore/qurl.h>
 #include <QtCore/qurlquery.h>
 #include <QtCore/qversionnumber.h>
 #include <QtCore/qshareddata.h>
+#include <QtCore/qsharedpointer.h>
 #include <QtCore/qmimetype.h>
+#include <QtCore/qdeadlinetimer.h>
 #ifdef QT_RESTCLIENT_USE_ASYNC
 #include <QtCore/qfuture.h>
 #endif
@@ -56,6 +60,8 @@ public:
 	RequestBuilder &setNetworkAccessManager(QNetworkAccessManager *nam);
 	//! Sets the extender to use for extending the build
 	RequestBuilder &setExtender(IExtender *extender);
+	//! @copybrief RequestBuilder::setExtender(IExtender *)
+	RequestBuilder &setExtender(QSharedPointer<IExtender> extender);
 
 	//! Sets the credentails of the URL
 	RequestBuilder &setCredentials(QString user, QString password = {});
@@ -89,6 +95,10 @@ public:
 	//! Sets the ssl configuration to be used by the network request
 	RequestBuilder &setSslConfig(QSslConfiguration sslConfig);
 #endif
+	//! Sets the point in time by which the reply to the sent request must be complete
+	RequestBuilder &setDeadline(QDeadlineTimer deadline);
+	//! Sets how long after sending the reply to the sent request may take to complete
+	RequestBuilder &setTimeout(std::chrono::milliseconds timeout);
 
 	//! Sets the content of the generated network request
 	RequestBuilder &setBody(QByteArray body, const QByteArray &contentType, bool setAccept = true);
@@ -96,6 +106,8 @@ public:
 	RequestBuilder &setBody(QCborValue body, bool setAccept = true);
 	//! @copybrief RequestBuilder::setBody(QByteArray, const QByteArray &, bool)
 	RequestBuilder &setBody(const QJsonValue &body, bool setAccept = true);
+	//! Sets a device to stream the content of the generated network request from
+	RequestBuilder &setBody(QIODevice *device, const QByteArray &contentType, bool setAccept = true);
 	//! Sets the HTTP-Verb to be used by the generated network request
 	RequestBuilder &setVerb(QByteArray verb);
 	//! Sets the "Accept" HTTP-header to the given mimetype
@@ -120,6 +132,8 @@ public:
 #endif
 
 private:
+	friend class RestClientPrivate;
+	friend class RestClass;
 	QSharedDataPointer<RequestBuilderPrivate> d;
 };
 
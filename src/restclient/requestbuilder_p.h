@@ -3,7 +3,11 @@
 
 #include "requestbuilder.h"
 #include "restclass.h"
+#include "endpointselector_p.h"
+#include "circuitbreaker_p.h"
+#include "ratelimiter_p.h"
 
+#include <QtCore/QDeadlineTimer>
 #include <QtCore/QPointer>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QLoggingCategory>
@@ -17,12 +21,17 @@ struct Q_RESTCLIENT_EXPORT RequestBuilderPrivate : public QSharedData
 	static const QByteArray ContentTypeJson;
 	static const QByteArray ContentTypeUrlEncoded;
 	static const QByteArray Accept;
+	static const QString SequentialBodyError;
 
 	RequestBuilderPrivate(const QUrl &baseUrl, QNetworkAccessManager *nam);
 	RequestBuilderPrivate(const RequestBuilderPrivate &other) = default;
 
 	QPointer<QNetworkAccessManager> nam;
 	QSharedPointer<RequestBuilder::IExtender> extender;
+	QSharedPointer<EndpointPool> endpoints;
+	QSharedPointer<CircuitBreaker> circuitBreaker;
+	QSharedPointer<RateLimiter> rateLimiter;
+	QString route;
 
 	QUrl base;
 	QVersionNumber version;
@@ -37,11 +46,18 @@ struct Q_RESTCLIENT_EXPORT RequestBuilderPrivate : public QSharedData
 #ifndef QT_NO_SSL
 	QSslConfiguration sslConfig;
 #endif
+	QDeadlineTimer deadline {QDeadlineTimer::Forever};
+	std::chrono::milliseconds timeout {-1};
 	QByteArray body;
+	QPointer<QIODevice> bodyDevice;
 	QByteArray verb;
 	QUrlQuery postQuery;
 
-	void prepareRequest(QNetworkRequest &request, QByteArray *sBody) const;
+	// returns the reason the request cannot be sent, if any
+	QString prepareRequest(QNetworkRequest &request, QByteArray *sBody) const;
+	QByteArray *sendBody(QByteArray &sBody) const;
+	QUrl sendUrl(const QUrl &url) const;
+	void prepareSend(QNetworkRequest &request) const;
 };
 
 Q_DECLARE_LOGGING_CATEGORY(logBuilder)
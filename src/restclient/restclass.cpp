@@ -1,6 +1,7 @@
 #include "restclass.h"
 #include "restclass_p.h"
 #include "restclient.h"
+#include "requestbuilder_p.h"
 using namespace QtRestClient;
 
 const QByteArray RestClass::GetVerb("GET");
@@ -44,117 +45,66 @@ RestClass *RestClass::subClass(const QString &path, QObject *parent) const
 
 RestReply *RestClass::callRaw(const QByteArray &verb, const QString &methodPath, const QVariantHash &parameters, const HeaderHash &headers, bool paramsAsBody) const
 {
-	return std::visit([&](const auto &reply) {
-#ifdef QT_RESTCLIENT_USE_ASYNC
-		Q_D(const RestClass);
-		return new RestReply{reply, d->client->asyncPool(), nullptr};
-#else
-		return new RestReply{reply, nullptr};
-#endif
-	}, create(verb, methodPath, parameters, headers, paramsAsBody));
+	Q_D(const RestClass);
+	return d->createRawReply(create(verb, methodPath, parameters, headers, paramsAsBody));
 }
 
 RestReply *RestClass::callRaw(const QByteArray &verb, const QString &methodPath, const QCborValue &body, const QVariantHash &parameters, const HeaderHash &headers) const
 {
-	return std::visit([&](const auto &reply) {
-#ifdef QT_RESTCLIENT_USE_ASYNC
-		Q_D(const RestClass);
-		return new RestReply{reply, d->client->asyncPool(), nullptr};
-#else
-		return new RestReply{reply, nullptr};
-#endif
-	}, create(verb, methodPath, body, parameters, headers));
+	Q_D(const RestClass);
+	return d->createRawReply(create(verb, methodPath, body, parameters, headers));
 }
 
 RestReply *RestClass::callRaw(const QByteArray &verb, const QString &methodPath, const QJsonValue &body, const QVariantHash &parameters, const HeaderHash &headers) const
 {
-	return std::visit([&](const auto &reply) {
-#ifdef QT_RESTCLIENT_USE_ASYNC
-		Q_D(const RestClass);
-		return new RestReply{reply, d->client->asyncPool(), nullptr};
-#else
-		return new RestReply{reply, nullptr};
-#endif
-	}, create(verb, methodPath, body, parameters, headers));
+	Q_D(const RestClass);
+	return d->createRawReply(create(verb, methodPath, body, parameters, headers));
 }
 
 RestReply *RestClass::callRaw(const QByteArray &verb, const QVariantHash &parameters, const HeaderHash &headers, bool paramsAsBody) const
 {
-	return std::visit([&](const auto &reply) {
-#ifdef QT_RESTCLIENT_USE_ASYNC
-		Q_D(const RestClass);
-		return new RestReply{reply, d->client->asyncPool(), nullptr};
-#else
-		return new RestReply{reply, nullptr};
-#endif
-	}, create(verb, parameters, headers, paramsAsBody));
+	Q_D(const RestClass);
+	return d->createRawReply(create(verb, parameters, headers, paramsAsBody));
 }
 
 RestReply *RestClass::callRaw(const QByteArray &verb, const QCborValue &body, const QVariantHash &parameters, const HeaderHash &headers) const
 {
-	return std::visit([&](const auto &reply) {
-#ifdef QT_RESTCLIENT_USE_ASYNC
-		Q_D(const RestClass);
-		return new RestReply{reply, d->client->asyncPool(), nullptr};
-#else
-		return new RestReply{reply, nullptr};
-#endif
-	}, create(verb, body, parameters, headers));
+	Q_D(const RestClass);
+	return d->createRawReply(create(verb, body, parameters, headers));
 }
 
 RestReply *RestClass::callRaw(const QByteArray &verb, const QJsonValue &body, const QVariantHash &parameters, const HeaderHash &headers) const
 {
-	return std::visit([&](const auto &reply) {
-#ifdef QT_RESTCLIENT_USE_ASYNC
-		Q_D(const RestClass);
-		return new RestReply{reply, d->client->asyncPool(), nullptr};
-#else
-		return new RestReply{reply, nullptr};
-#endif
-	}, create(verb, body, parameters, headers));
+	Q_D(const RestClass);
+	return d->createRawReply(create(verb, body, parameters, headers));
 }
 
 RestReply *RestClass::callRaw(const QByteArray &verb, const QUrl &relativeUrl, const QVariantHash &parameters, const HeaderHash &headers, bool paramsAsBody) const
 {
-	return std::visit([&](const auto &reply) {
-#ifdef QT_RESTCLIENT_USE_ASYNC
-		Q_D(const RestClass);
-		return new RestReply{reply, d->client->asyncPool(), nullptr};
-#else
-		return new RestReply{reply, nullptr};
-#endif
-	}, create(verb, relativeUrl, parameters, headers, paramsAsBody));
+	Q_D(const RestClass);
+	return d->createRawReply(create(verb, relativeUrl, parameters, headers, paramsAsBody));
 }
 
 RestReply *RestClass::callRaw(const QByteArray &verb, const QUrl &relativeUrl, const QCborValue &body, const QVariantHash &parameters, const HeaderHash &headers) const
 {
-	return std::visit([&](const auto &reply) {
-#ifdef QT_RESTCLIENT_USE_ASYNC
-		Q_D(const RestClass);
-		return new RestReply{reply, d->client->asyncPool(), nullptr};
-#else
-		return new RestReply{reply, nullptr};
-#endif
-	}, create(verb, relativeUrl, body, parameters, headers));
+	Q_D(const RestClass);
+	return d->createRawReply(create(verb, relativeUrl, body, parameters, headers));
 }
 
 RestReply *RestClass::callRaw(const QByteArray &verb, const QUrl &relativeUrl, const QJsonValue &body, const QVariantHash &parameters, const HeaderHash &headers) const
 {
-	return std::visit([&](const auto &reply) {
-#ifdef QT_RESTCLIENT_USE_ASYNC
-		Q_D(const RestClass);
-		return new RestReply{reply, d->client->asyncPool(), nullptr};
-#else
-		return new RestReply{reply, nullptr};
-#endif
-	}, create(verb, relativeUrl, body, parameters, headers));
+	Q_D(const RestClass);
+	return d->createRawReply(create(verb, relativeUrl, body, parameters, headers));
 }
 
 RequestBuilder RestClass::builder() const
 {
 	Q_D(const RestClass);
-	return d->client->builder()
-			.addPath(d->subPath);
+	auto builder = d->client->builder()
+					   .addPath(d->subPath);
+	// the circuit breaker may guard the requests of each class separately
+	builder.d->route = d->subPath.join(QLatin1Char('/'));
+	return builder;
 }
 
 RestClass::CreateResult RestClass::create(const QByteArray &verb, const QString &methodPath, const QVariantHash &parameters, const HeaderHash &headers, bool paramsAsBody) const
@@ -165,12 +115,7 @@ RestClass::CreateResult RestClass::create(const QByteArray &verb, const QString
 		.addPath(methodPath)
 		.addHeaders(headers)
 		.setVerb(verb);
-#ifdef QT_RESTCLIENT_USE_ASYNC
-	if (client()->isThreaded())
-		return cBuilder.sendAsync();
-	else
-#endif
-		return cBuilder.send();
+	return send(cBuilder);
 }
 
 RestClass::CreateResult RestClass::create(const QByteArray &verb, const QString &methodPath, const QCborValue &body, const QVariantHash &parameters, const HeaderHash &headers) const
@@ -181,12 +126,7 @@ RestClass::CreateResult RestClass::create(const QByteArray &verb, const QString
 		.addHeaders(headers)
 		.setBody(body, false)
 		.setVerb(verb);
-#ifdef QT_RESTCLIENT_USE_ASYNC
-	if (client()->isThreaded())
-		return cBuilder.sendAsync();
-	else
-#endif
-		return cBuilder.send();
+	return send(cBuilder);
 }
 
 RestClass::CreateResult RestClass::create(const QByteArray &verb, const QString &methodPath, const QJsonValue &body, const QVariantHash &parameters, const HeaderHash &headers) const
@@ -197,12 +137,7 @@ RestClass::CreateResult RestClass::create(const QByteArray &verb, const QString
 		.addHeaders(headers)
 		.setBody(body, false)
 		.setVerb(verb);
-#ifdef QT_RESTCLIENT_USE_ASYNC
-	if (client()->isThreaded())
-		return cBuilder.sendAsync();
-	else
-#endif
-		return cBuilder.send();
+	return send(cBuilder);
 }
 
 RestClass::CreateResult RestClass::create(const QByteArray &verb, const QVariantHash &parameters, const HeaderHash &headers, bool paramsAsBody) const
@@ -212,12 +147,7 @@ RestClass::CreateResult RestClass::create(const QByteArray &verb, const QVariant
 				builder().addParameters(RestClassPrivate::hashToQuery(parameters)))
 		.addHeaders(headers)
 		.setVerb(verb);
-#ifdef QT_RESTCLIENT_USE_ASYNC
-	if (client()->isThreaded())
-		return cBuilder.sendAsync();
-	else
-#endif
-		return cBuilder.send();
+	return send(cBuilder);
 }
 
 RestClass::CreateResult RestClass::create(const QByteArray &verb, const QCborValue &body, const QVariantHash &parameters, const HeaderHash &headers) const
@@ -227,12 +157,7 @@ RestClass::CreateResult RestClass::create(const QByteArray &verb, const QCborVal
 		.addHeaders(headers)
 		.setBody(body, false)
 		.setVerb(verb);
-#ifdef QT_RESTCLIENT_USE_ASYNC
-	if (client()->isThreaded())
-		return cBuilder.sendAsync();
-	else
-#endif
-		return cBuilder.send();
+	return send(cBuilder);
 }
 
 RestClass::CreateResult RestClass::create(const QByteArray &verb, const QJsonValue &body, const QVariantHash &parameters, const HeaderHash &headers) const
@@ -242,12 +167,7 @@ RestClass::CreateResult RestClass::create(const QByteArray &verb, const QJsonVal
 		.addHeaders(headers)
 		.setBody(body, false)
 		.setVerb(verb);
-#ifdef QT_RESTCLIENT_USE_ASYNC
-	if (client()->isThreaded())
-		return cBuilder.sendAsync();
-	else
-#endif
-		return cBuilder.send();
+	return send(cBuilder);
 }
 
 RestClass::CreateResult RestClass::create(const QByteArray &verb, const QUrl &relativeUrl, const QVariantHash &parameters, const HeaderHash &headers, bool paramsAsBody) const
@@ -258,12 +178,7 @@ RestClass::CreateResult RestClass::create(const QByteArray &verb, const QUrl &re
 		.updateFromRelativeUrl(relativeUrl, true)
 		.addHeaders(headers)
 		.setVerb(verb);
-#ifdef QT_RESTCLIENT_USE_ASYNC
-	if (client()->isThreaded())
-		return cBuilder.sendAsync();
-	else
-#endif
-		return cBuilder.send();
+	return send(cBuilder);
 }
 
 RestClass::CreateResult RestClass::create(const QByteArray &verb, const QUrl &relativeUrl, const QCborValue &body, const QVariantHash &parameters, const HeaderHash &headers) const
@@ -274,12 +189,7 @@ RestClass::CreateResult RestClass::create(const QByteArray &verb, const QUrl &re
 		.addHeaders(headers)
 		.setBody(body, false)
 		.setVerb(verb);
-#ifdef QT_RESTCLIENT_USE_ASYNC
-	if (client()->isThreaded())
-		return cBuilder.sendAsync();
-	else
-#endif
-		return cBuilder.send();
+	return send(cBuilder);
 }
 
 RestClass::CreateResult RestClass::create(const QByteArray &verb, const QUrl &relativeUrl, const QJsonValue &body, const QVariantHash &parameters, const HeaderHash &headers) const
@@ -290,12 +200,19 @@ RestClass::CreateResult RestClass::create(const QByteArray &verb, const QUrl &re
 		.addHeaders(headers)
 		.setBody(body, false)
 		.setVerb(verb);
+	return send(cBuilder);
+}
+
+RestClass::CreateResult RestClass::send(const RequestBuilder &requestBuilder) const
+{
 #ifdef QT_RESTCLIENT_USE_ASYNC
-	if (client()->isThreaded())
-		return cBuilder.sendAsync();
+	// rate limited requests may have to wait, which only works without blocking when sent
+	// asynchronously. See RestClient::rateLimiter
+	if (client()->isThreaded() || requestBuilder.d->rateLimiter)
+		return requestBuilder.sendAsync();
 	else
 #endif
-		return cBuilder.send();
+		return requestBuilder.send();
 }
 
 // ------------- Private Implementation -------------
@@ -307,3 +224,16 @@ QUrlQuery RestClassPrivate::hashToQuery(const QVariantHash &hash)
 		query.addQueryItem(it.key(), it.value().toString());
 	return query;
 }
+
+RestReply *RestClassPrivate::createRawReply(const RestClass::CreateResult &result) const
+{
+	const auto reply = std::visit([this](const auto &networkReply) {
+#ifdef QT_RESTCLIENT_USE_ASYNC
+		return new RestReply{networkReply, client->asyncPool(), nullptr};
+#else
+		return new RestReply{networkReply, nullptr};
+#endif
+	}, result);
+	reply->setupClient(client);
+	return reply;
+}
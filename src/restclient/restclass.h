@@ -5,6 +5,7 @@
 #include "QtRestClient/requestbuilder.h"
 #include "QtRestClient/restreply.h"
 #include "QtRestClient/restclient.h"
+#include "QtRestClient/replyhandle.h"
 
 #ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
 #include "QtRestClient/genericrestreply.h"
@@ -57,6 +58,17 @@ public:
 	RestReply *callRaw(const QByteArray &verb, const QUrl &relativeUrl, const QJsonValue &body, const QVariantHash &parameters = {}, const HeaderHash &headers = {}) const;
 	//! @}
 
+	//lightweight calls (status only)
+	//! @{
+	//! @brief Performs a API call of the given verb and only reports the outcome to a single completion handler
+	template <typename TFn>
+	ReplyHandle send(const QByteArray &verb, const QString &methodPath, TFn &&completion, const QVariantHash &parameters = {}, const HeaderHash &headers = {}) const;
+	template <typename TFn>
+	ReplyHandle send(const QByteArray &verb, const QString &methodPath, const QCborValue &body, TFn &&completion, const QVariantHash &parameters = {}, const HeaderHash &headers = {}) const;
+	template <typename TFn>
+	ReplyHandle send(const QByteArray &verb, const QString &methodPath, const QJsonValue &body, TFn &&completion, const QVariantHash &parameters = {}, const HeaderHash &headers = {}) const;
+	//! @}
+
 #ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
 	//! @{
 	//! @brief Performs an API call of the given verb with generic objects
@@ -221,6 +233,7 @@ private:
 	CreateResult create(const QByteArray &verb, const QUrl &relativeUrl, const QVariantHash &parameters, const HeaderHash &headers, bool paramsAsBody) const;
 	CreateResult create(const QByteArray &verb, const QUrl &relativeUrl, const QCborValue &body, const QVariantHash &parameters, const HeaderHash &headers) const;
 	CreateResult create(const QByteArray &verb, const QUrl &relativeUrl, const QJsonValue &body, const QVariantHash &parameters, const HeaderHash &headers) const;
+	CreateResult send(const RequestBuilder &requestBuilder) const;
 };
 
 //! Short macro for RestClass::concatParams(), to make the call shorter
@@ -228,6 +241,30 @@ private:
 
 // ------------- Generic Implementation -------------
 
+template <typename TFn>
+ReplyHandle RestClass::send(const QByteArray &verb, const QString &methodPath, TFn &&completion, const QVariantHash &parameters, const HeaderHash &headers) const
+{
+	return std::visit([&](const auto &reply) {
+		return ReplyHandle::create(reply, std::forward<TFn>(completion));
+	}, create(verb, methodPath, parameters, headers, false));
+}
+
+template <typename TFn>
+ReplyHandle RestClass::send(const QByteArray &verb, const QString &methodPath, const QCborValue &body, TFn &&completion, const QVariantHash &parameters, const HeaderHash &headers) const
+{
+	return std::visit([&](const auto &reply) {
+		return ReplyHandle::create(reply, std::forward<TFn>(completion));
+	}, create(verb, methodPath, body, parameters, headers));
+}
+
+template <typename TFn>
+ReplyHandle RestClass::send(const QByteArray &verb, const QString &methodPath, const QJsonValue &body, TFn &&completion, const QVariantHash &parameters, const HeaderHash &headers) const
+{
+	return std::visit([&](const auto &reply) {
+		return ReplyHandle::create(reply, std::forward<TFn>(completion));
+	}, create(verb, methodPath, body, parameters, headers));
+}
+
 #ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
 template<typename DT, typename ET>
 GenericRestReply<DT, ET> *RestClass::call(const QByteArray &verb, const QString &methodPath, const QVariantHash &parameters, const HeaderHash &headers, bool paramsAsBody) const
@@ -244,7 +281,7 @@ GenericRestReply<DT, ET> *RestClass::call(const QByteArray &verb, const QString
 		return std::visit([&](const auto &reply) {
 			return new GenericRestReply<DT, ET>{reply, client(), nullptr};
 		}, create(verb, methodPath, bodyData, parameters, headers));
-	}, client()->serializer()->serializeGeneric(QtJsonSerializer::__private::variant_helper<RO>::toVariant(body)));
+	}, GeneratedCodec::serialize<RO>(body, client()->serializer()));
 }
 
 template<typename DT, typename ET>
@@ -262,7 +299,7 @@ GenericRestReply<DT, ET> *RestClass::call(const QByteArray &verb, const RO &body
 		return std::visit([&](const auto &reply) {
 			return new GenericRestReply<DT, ET>{reply, client(), nullptr};
 		}, create(verb, bodyData, parameters, headers));
-	}, client()->serializer()->serializeGeneric(QtJsonSerializer::__private::variant_helper<RO>::toVariant(body)));
+	}, GeneratedCodec::serialize<RO>(body, client()->serializer()));
 }
 
 template<typename DT, typename ET>
@@ -280,7 +317,7 @@ GenericRestReply<DT, ET> *RestClass::call(const QByteArray &verb, const QUrl &re
 		return std::visit([&](const auto &reply) {
 			return new GenericRestReply<DT, ET>{reply, client(), nullptr};
 		}, create(verb, relativeUrl, bodyData, parameters, headers));
-	}, client()->serializer()->serializeGeneric(QtJsonSerializer::__private::variant_helper<RO>::toVariant(body)));
+	}, GeneratedCodec::serialize<RO>(body, client()->serializer()));
 }
 #endif
 
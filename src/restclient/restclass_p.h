@@ -15,6 +15,8 @@ public:
 	QStringList subPath;
 
 	static QUrlQuery hashToQuery(const QVariantHash &hash);
+
+	RestReply *createRawReply(const RestClass::CreateResult &result) const;
 };
 
 }
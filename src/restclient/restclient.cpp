@@ -4,7 +4,11 @@
 #include "requestbuilder_p.h"
 #include <QtCore/QBitArray>
 #include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QPointer>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QSaveFile>
+#include <QtCore/QCborMap>
 #include <QtCore/QUuid>
 using namespace QtRestClient;
 
@@ -15,6 +19,19 @@ using namespace QtRestClient;
 using namespace QtJsonSerializer;
 #endif
 
+namespace {
+
+void qtRestClientStartup()
+{
+	qRegisterMetaType<std::chrono::milliseconds>();
+	qRegisterMetaType<std::chrono::seconds>();
+	qRegisterMetaType<std::optional<CircuitBreakerSettings>>();
+	qRegisterMetaType<std::optional<RateLimiterSettings>>();
+}
+
+}
+Q_COREAPP_STARTUP_FUNCTION(qtRestClientStartup)
+
 RestClient::RestClient(QObject *parent) :
 	  RestClient{DataMode::Json, parent}
 {}
@@ -35,6 +52,23 @@ RestClient::RestClient(SerializerBase *serializer, QObject *parent) :
 }
 #endif
 
+RestClient::~RestClient()
+{
+	Q_D(RestClient);
+	{
+		// replies still running on other threads must not reach the client anymore
+		QWriteLocker _{&d->guard->lock};
+		d->guard->client = nullptr;
+	}
+#ifndef QT_NO_SSL
+	// tickets that are still waiting to be saved are not lost
+	if (d->ticketSaveTimer->isActive()) {
+		d->ticketSaveTimer->stop();
+		d->saveSessionTickets();
+	}
+#endif
+}
+
 RestClass *RestClient::createClass(const QString &path, QObject *parent)
 {
 #if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
@@ -66,6 +100,13 @@ SerializerBase *RestClient::serializer() const
 }
 #endif
 
+IEndpointSelector *RestClient::endpointSelector() const
+{
+	Q_D(const RestClient);
+	QReadLocker _{d->threadLock};
+	return d->endpointSelector.data();
+}
+
 IPagingFactory *RestClient::pagingFactory() const
 {
 	Q_D(const RestClient);
@@ -73,6 +114,20 @@ IPagingFactory *RestClient::pagingFactory() const
 	return d->pagingFactory.data();
 }
 
+IReplyParser *RestClient::replyParser(const QByteArray &contentType) const
+{
+	Q_D(const RestClient);
+	QReadLocker _{d->threadLock};
+	return d->codecs.parser(contentType);
+}
+
+ContentCodecRegistry RestClient::codecRegistry() const
+{
+	Q_D(const RestClient);
+	QReadLocker _{d->threadLock};
+	return d->codecs;
+}
+
 RestClient::DataMode RestClient::dataMode() const
 {
 	Q_D(const RestClient);
@@ -93,6 +148,13 @@ QUrl RestClient::baseUrl() const
 	return d->baseUrl;
 }
 
+QList<QUrl> RestClient::endpoints() const
+{
+	Q_D(const RestClient);
+	QReadLocker _{d->threadLock};
+	return d->endpoints;
+}
+
 QVersionNumber RestClient::apiVersion() const
 {
 	Q_D(const RestClient);
@@ -127,6 +189,13 @@ bool RestClient::isThreaded() const
 	return d->threadLock;
 }
 
+int RestClient::autoWarmUp() const
+{
+	Q_D(const RestClient);
+	QReadLocker _{d->threadLock};
+	return d->autoWarmUp;
+}
+
 #ifndef QT_NO_SSL
 QSslConfiguration RestClient::sslConfiguration() const
 {
@@ -134,6 +203,20 @@ QSslConfiguration RestClient::sslConfiguration() const
 	QReadLocker _{d->threadLock};
 	return d->sslConfig;
 }
+
+bool RestClient::sessionResumption() const
+{
+	Q_D(const RestClient);
+	QReadLocker _{d->threadLock};
+	return d->sessionResumption;
+}
+
+QString RestClient::sessionTicketFile() const
+{
+	Q_D(const RestClient);
+	QReadLocker _{d->threadLock};
+	return d->sessionTicketFile;
+}
 #endif
 
 #ifdef QT_RESTCLIENT_USE_ASYNC
@@ -145,32 +228,111 @@ QThreadPool *RestClient::asyncPool() const
 }
 #endif
 
-RequestBuilder RestClient::builder() const
+std::chrono::milliseconds RestClient::hedgingDelay() const
 {
 	Q_D(const RestClient);
 	QReadLocker _{d->threadLock};
-	RequestBuilder builder{d->baseUrl, d->nam};
+	return d->hedgingDelay;
+}
 
-	builder.setVersion(d->apiVersion)
-		.setAttributes(d->attribs)
-#ifndef QT_NO_SSL
-		.setSslConfig(d->sslConfig)
-#endif
-		.addHeaders(d->headers)
-		.addParameters(d->query);
+void RestClient::setHedgingDelay(std::chrono::milliseconds hedgingDelay)
+{
+	Q_D(RestClient);
+	QWriteLocker _{d->threadLock};
+	if (d->hedgingDelay == hedgingDelay)
+		return;
 
-	switch (dataMode()) {
-	case DataMode::Cbor:
-		builder.setAccept(RequestBuilderPrivate::ContentTypeCbor);
-		break;
-	case DataMode::Json:
-		builder.setAccept(RequestBuilderPrivate::ContentTypeJson);
-		break;
-	default:
-		Q_UNREACHABLE();
+	// hedging needs the latency statistics of the pool, even for a single endpoint
+	const auto resetPool = (d->hedgingDelay.count() < 0) != (hedgingDelay.count() < 0);
+	d->hedgingDelay = hedgingDelay;
+	if (resetPool) {
+		d->resetEndpoints();
+		d->invalidateBuilder();
 	}
+	Q_EMIT hedgingDelayChanged(d->hedgingDelay, {});
+}
 
-	return builder;
+std::chrono::milliseconds RestClient::defaultTimeout() const
+{
+	Q_D(const RestClient);
+	QReadLocker _{d->threadLock};
+	return d->defaultTimeout;
+}
+
+void RestClient::setDefaultTimeout(std::chrono::milliseconds defaultTimeout)
+{
+	Q_D(RestClient);
+	QWriteLocker _{d->threadLock};
+	if (d->defaultTimeout == defaultTimeout)
+		return;
+
+	d->defaultTimeout = defaultTimeout;
+	d->invalidateBuilder();
+	Q_EMIT defaultTimeoutChanged(d->defaultTimeout, {});
+}
+
+std::optional<CircuitBreakerSettings> RestClient::circuitBreaker() const
+{
+	Q_D(const RestClient);
+	QReadLocker _{d->threadLock};
+	return d->circuitBreakerSettings;
+}
+
+void RestClient::setCircuitBreaker(std::optional<CircuitBreakerSettings> circuitBreaker)
+{
+	Q_D(RestClient);
+	QWriteLocker _{d->threadLock};
+	// new settings start with closed circuits
+	d->circuitBreakerSettings = std::move(circuitBreaker);
+	if (d->circuitBreakerSettings)
+		d->circuitBreaker.reset(new CircuitBreaker{*d->circuitBreakerSettings});
+	else
+		d->circuitBreaker.reset();
+	d->invalidateBuilder();
+	Q_EMIT circuitBreakerChanged(d->circuitBreakerSettings, {});
+}
+
+std::optional<RateLimiterSettings> RestClient::rateLimiter() const
+{
+	Q_D(const RestClient);
+	QReadLocker _{d->threadLock};
+	return d->rateLimiterSettings;
+}
+
+void RestClient::setRateLimiter(std::optional<RateLimiterSettings> rateLimiter)
+{
+	Q_D(RestClient);
+	QWriteLocker _{d->threadLock};
+	// new settings start with full buckets
+	d->rateLimiterSettings = std::move(rateLimiter);
+	if (d->rateLimiterSettings)
+		d->rateLimiter.reset(new RateLimiter{*d->rateLimiterSettings});
+	else
+		d->rateLimiter.reset();
+	d->invalidateBuilder();
+	Q_EMIT rateLimiterChanged(d->rateLimiterSettings, {});
+}
+
+RequestBuilder RestClient::builder() const
+{
+	Q_D(const RestClient);
+	QReadLocker _{d->threadLock};
+	QMutexLocker cacheLocker{&d->builderMutex};
+#ifndef QT_NO_SSL
+	// the ticket of the template is only replaced once it expired
+	if (d->builderTemplate &&
+		d->builderTicketExpiry.isValid() &&
+		d->builderTicketExpiry <= QDateTime::currentDateTimeUtc())
+		d->builderTemplate.reset();
+#endif
+	if (!d->builderTemplate) {
+#ifndef QT_NO_SSL
+		// read before the ticket is applied, so a ticket stored in between only causes a rebuild
+		d->builderTicketExpiry = d->ticketExpiry(d->baseUrl);
+#endif
+		d->builderTemplate = d->createBuilder();
+	}
+	return *d->builderTemplate;
 }
 
 void RestClient::setManager(QNetworkAccessManager *manager)
@@ -180,6 +342,7 @@ void RestClient::setManager(QNetworkAccessManager *manager)
 	d->nam->deleteLater();
 	d->nam = manager;
 	manager->setParent(this);
+	d->invalidateBuilder();
 }
 
 #ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
@@ -190,10 +353,16 @@ void RestClient::setSerializer(SerializerBase *serializer)
 	if (d->serializer == serializer)
 		return;
 
-	if (d->serializer)
-		d->serializer->deleteLater();
+	if (d->serializer) {
+		// paging decoders on other threads only use the serializer while holding the guard
+		QMetaObject::invokeMethod(this, [guard = d->guard, oldSerializer = QPointer<SerializerBase>{d->serializer}]() {
+			QWriteLocker _{&guard->lock};
+			delete oldSerializer;
+		}, Qt::QueuedConnection);
+	}
 	d->serializer = serializer;
 	serializer->setParent(this);
+	d->invalidateBuilder();
 	_.unlock();
 	Q_EMIT dataModeChanged(dataMode(), {});
 }
@@ -206,6 +375,39 @@ void RestClient::setPagingFactory(IPagingFactory *factory)
 	d->pagingFactory.reset(factory);
 }
 
+void RestClient::addReplyParser(IReplyParser *parser)
+{
+	Q_D(RestClient);
+	QWriteLocker _{d->threadLock};
+	d->codecs.addParser(parser);
+	d->invalidateBuilder();
+}
+
+void RestClient::removeReplyParser(const QByteArray &contentType)
+{
+	Q_D(RestClient);
+	QWriteLocker _{d->threadLock};
+	d->codecs.remove(contentType);
+	d->invalidateBuilder();
+}
+
+void RestClient::setCodecRegistry(const ContentCodecRegistry &registry)
+{
+	Q_D(RestClient);
+	QWriteLocker _{d->threadLock};
+	d->codecs = registry;
+	d->invalidateBuilder();
+}
+
+void RestClient::setEndpointSelector(IEndpointSelector *selector)
+{
+	Q_D(RestClient);
+	QWriteLocker _{d->threadLock};
+	d->endpointSelector.reset(selector);
+	d->resetEndpoints();
+	d->invalidateBuilder();
+}
+
 void RestClient::setDataMode(RestClient::DataMode dataMode)
 {
 	Q_D(RestClient);
@@ -232,6 +434,7 @@ void RestClient::setDataMode(RestClient::DataMode dataMode)
 		return;
 
 	d->dataMode = dataMode;
+	d->invalidateBuilder();
 	Q_EMIT dataModeChanged(d->dataMode, {});
 #endif
 }
@@ -244,9 +447,29 @@ void RestClient::setBaseUrl(QUrl baseUrl)
 		return;
 
 	d->baseUrl = std::move(baseUrl);
+	d->resetEndpoints();
+	d->invalidateBuilder();
+	if (d->autoWarmUp > 0)
+		d->warmUp(d->autoWarmUp);
 	Q_EMIT baseUrlChanged(d->baseUrl, {});
 }
 
+void RestClient::setEndpoints(QList<QUrl> endpoints)
+{
+	Q_D(RestClient);
+	QWriteLocker _{d->threadLock};
+	if (d->endpoints == endpoints)
+		return;
+
+	d->endpoints = std::move(endpoints);
+	// without a base URL, requests are built against the first endpoint
+	if (!d->baseUrl.isValid() && !d->endpoints.isEmpty())
+		setBaseUrl(d->endpoints.first());
+	d->resetEndpoints();
+	d->invalidateBuilder();
+	Q_EMIT endpointsChanged(d->endpoints, {});
+}
+
 void RestClient::setApiVersion(QVersionNumber apiVersion)
 {
 	Q_D(RestClient);
@@ -255,6 +478,7 @@ void RestClient::setApiVersion(QVersionNumber apiVersion)
 		return;
 
 	d->apiVersion = std::move(apiVersion);
+	d->invalidateBuilder();
 	Q_EMIT apiVersionChanged(d->apiVersion, {});
 }
 
@@ -266,6 +490,7 @@ void RestClient::setGlobalHeaders(HeaderHash globalHeaders)
 		return;
 
 	d->headers = std::move(globalHeaders);
+	d->invalidateBuilder();
 	Q_EMIT globalHeadersChanged(d->headers, {});
 }
 
@@ -277,6 +502,7 @@ void RestClient::setGlobalParameters(QUrlQuery globalParameters)
 		return;
 
 	d->query = std::move(globalParameters);
+	d->invalidateBuilder();
 	Q_EMIT globalParametersChanged(d->query, {});
 }
 
@@ -288,6 +514,7 @@ void RestClient::setRequestAttributes(QHash<QNetworkRequest::Attribute, QVariant
 		return;
 
 	d->attribs = std::move(requestAttributes);
+	d->invalidateBuilder();
 	Q_EMIT requestAttributesChanged(d->attribs, {});
 }
 
@@ -304,6 +531,7 @@ void RestClient::setModernAttributes()
 #else
 	d->attribs.insert(QNetworkRequest::Http2AllowedAttribute, true);
 #endif
+	d->invalidateBuilder();
 	Q_EMIT requestAttributesChanged(d->attribs, {});
 }
 
@@ -322,6 +550,17 @@ void RestClient::setThreaded(bool threaded)
 	Q_EMIT threadedChanged(d->threadLock, {});
 }
 
+void RestClient::setAutoWarmUp(int autoWarmUp)
+{
+	Q_D(RestClient);
+	QWriteLocker _{d->threadLock};
+	if (d->autoWarmUp == autoWarmUp)
+		return;
+
+	d->autoWarmUp = autoWarmUp;
+	Q_EMIT autoWarmUpChanged(d->autoWarmUp, {});
+}
+
 #ifndef QT_NO_SSL
 void RestClient::setSslConfiguration(QSslConfiguration sslConfiguration)
 {
@@ -331,8 +570,39 @@ void RestClient::setSslConfiguration(QSslConfiguration sslConfiguration)
 		return;
 
 	d->sslConfig = std::move(sslConfiguration);
+	d->invalidateBuilder();
 	Q_EMIT sslConfigurationChanged(d->sslConfig, {});
 }
+
+void RestClient::setSessionResumption(bool sessionResumption)
+{
+	Q_D(RestClient);
+	QWriteLocker _{d->threadLock};
+	if (d->sessionResumption == sessionResumption)
+		return;
+
+	d->sessionResumption = sessionResumption;
+	d->invalidateBuilder();
+	Q_EMIT sessionResumptionChanged(d->sessionResumption, {});
+}
+
+void RestClient::setSessionTicketFile(QString sessionTicketFile)
+{
+	Q_D(RestClient);
+	QWriteLocker _{d->threadLock};
+	if (d->sessionTicketFile == sessionTicketFile)
+		return;
+
+	// tickets that are still waiting to be saved belong to the previous file
+	if (d->ticketSaveTimer->isActive()) {
+		d->ticketSaveTimer->stop();
+		d->saveSessionTickets();
+	}
+	d->sessionTicketFile = std::move(sessionTicketFile);
+	d->loadSessionTickets();
+	d->invalidateBuilder();
+	Q_EMIT sessionTicketFileChanged(d->sessionTicketFile, {});
+}
 #endif
 
 #ifdef QT_RESTCLIENT_USE_ASYNC
@@ -355,6 +625,7 @@ void RestClient::addGlobalHeader(const QByteArray &name, const QByteArray &value
 	Q_D(RestClient);
 	QWriteLocker _{d->threadLock};
 	d->headers.insert(name, value);
+	d->invalidateBuilder();
 	Q_EMIT globalHeadersChanged(d->headers, {});
 }
 
@@ -362,8 +633,10 @@ void RestClient::removeGlobalHeader(const QByteArray &name)
 {
 	Q_D(RestClient);
 	QWriteLocker _{d->threadLock};
-	if(d->headers.remove(name) > 0)
+	if(d->headers.remove(name) > 0) {
+		d->invalidateBuilder();
 		Q_EMIT globalHeadersChanged(d->headers, {});
+	}
 }
 
 void RestClient::addGlobalParameter(const QString &name, const QString &value)
@@ -371,6 +644,7 @@ void RestClient::addGlobalParameter(const QString &name, const QString &value)
 	Q_D(RestClient);
 	QWriteLocker _{d->threadLock};
 	d->query.addQueryItem(name, value);
+	d->invalidateBuilder();
 	Q_EMIT globalParametersChanged(d->query, {});
 }
 
@@ -379,6 +653,7 @@ void RestClient::removeGlobalParameter(const QString &name)
 	Q_D(RestClient);
 	QWriteLocker _{d->threadLock};
 	d->query.removeQueryItem(name);
+	d->invalidateBuilder();
 	Q_EMIT globalParametersChanged(d->query, {});
 }
 
@@ -387,6 +662,7 @@ void RestClient::addRequestAttribute(QNetworkRequest::Attribute attribute, const
 	Q_D(RestClient);
 	QWriteLocker _{d->threadLock};
 	d->attribs.insert(attribute, value);
+	d->invalidateBuilder();
 	Q_EMIT requestAttributesChanged(d->attribs, {});
 }
 
@@ -395,15 +671,34 @@ void RestClient::removeRequestAttribute(QNetworkRequest::Attribute attribute)
 	Q_D(RestClient);
 	QWriteLocker _{d->threadLock};
 	d->attribs.remove(attribute);
+	d->invalidateBuilder();
 	Q_EMIT requestAttributesChanged(d->attribs, {});
 }
 
+void RestClient::warmUp(int connections)
+{
+	Q_D(RestClient);
+	QReadLocker _{d->threadLock};
+	d->warmUp(connections);
+}
+
 RestClient::RestClient(RestClientPrivate &dd, QObject *parent) :
 	  QObject{dd, parent}
 {
 	Q_D(RestClient);
+	d->guard->client = d;
 	d->pagingFactory.reset(new StandardPagingFactory{});
+	d->endpointSelector.reset(IEndpointSelector::create(IEndpointSelector::Strategy::RoundRobin));
 	d->rootClass = new RestClass{this, {}, this};
+#ifndef QT_NO_SSL
+	d->ticketSaveTimer = new QTimer{this};
+	d->ticketSaveTimer->setSingleShot(true);
+	d->ticketSaveTimer->setInterval(std::chrono::seconds{1});
+	connect(d->ticketSaveTimer, &QTimer::timeout,
+			this, [d]() {
+				d->saveSessionTickets();
+			});
+#endif
 }
 
 void RestClient::setupNam()
@@ -427,6 +722,228 @@ RestClientPrivate::~RestClientPrivate()
 }
 #endif
 
+RequestBuilder RestClientPrivate::createBuilder() const
+{
+	RequestBuilder builder{baseUrl, nam};
+	builder.setVersion(apiVersion)
+		.setAttributes(attribs)
+#ifndef QT_NO_SSL
+		.setSslConfig(requestSslConfig(baseUrl))
+#endif
+		.addHeaders(headers)
+		.addParameters(query)
+		.setTimeout(defaultTimeout);
+	builder.d->endpoints = endpointPool;
+	builder.d->circuitBreaker = circuitBreaker;
+	builder.d->rateLimiter = rateLimiter;
+
+#ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
+	const auto isCbor = serializer && serializer->metaObject()->inherits(&CborSerializer::staticMetaObject);
+#else
+	const auto isCbor = dataMode == DataMode::Cbor;
+#endif
+	builder.setAccept(codecs.acceptHeader(isCbor ?
+											  RequestBuilderPrivate::ContentTypeCbor :
+											  RequestBuilderPrivate::ContentTypeJson));
+	return builder;
+}
+
+void RestClientPrivate::invalidateBuilder()
+{
+	QMutexLocker _{&builderMutex};
+	builderTemplate.reset();
+}
+
+void RestClientPrivate::resetEndpoints()
+{
+	// statistics start over, builders and replies keep using the pool they were created with
+	if (!endpoints.isEmpty())
+		endpointPool.reset(new EndpointPool{baseUrl, endpoints, endpointSelector});
+	else if (hedgingDelay.count() >= 0 && baseUrl.isValid())
+		endpointPool.reset(new EndpointPool{baseUrl, {baseUrl}, endpointSelector});
+	else
+		endpointPool.reset();
+}
+
+void RestClientPrivate::warmUp(int connections) const
+{
+	// the network access manager never opens more than 6 connections per host anyway
+	connections = qBound(0, connections, 6);
+	const auto urls = endpoints.isEmpty() ? QList<QUrl>{baseUrl} : endpoints;
+	for (const auto &url : urls) {
+		if (!url.isValid() || url.host().isEmpty())
+			continue;
+
+		const auto host = url.host();
+		if (url.scheme() == QStringLiteral("https")) {
+#ifndef QT_NO_SSL
+			const auto port = static_cast<quint16>(url.port(443));
+			// connections are opened by the managers thread and kept alive in its connection pool
+			QMetaObject::invokeMethod(nam, [xNam = QPointer<QNetworkAccessManager>{nam}, host, port, connections, config = requestSslConfig(url)]() {
+				for (auto i = 0; xNam && i < connections; ++i)
+					xNam->connectToHostEncrypted(host, port, config);
+			});
+#else
+			qCWarning(logGlobal) << "Unable to warm up HTTPS connections without SSL support";
+#endif
+		} else if (url.scheme() == QStringLiteral("http")) {
+			const auto port = static_cast<quint16>(url.port(80));
+			QMetaObject::invokeMethod(nam, [xNam = QPointer<QNetworkAccessManager>{nam}, host, port, connections]() {
+				for (auto i = 0; xNam && i < connections; ++i)
+					xNam->connectToHost(host, port);
+			});
+		} else
+			qCWarning(logGlobal) << "Unable to warm up connections for URL scheme" << url.scheme();
+	}
+}
+
+#ifndef QT_NO_SSL
+QSslConfiguration RestClientPrivate::requestSslConfig(const QUrl &url) const
+{
+	if (!sessionResumption)
+		return sslConfig;
+
+	auto config = sslConfig;
+	config.setSslOption(QSsl::SslOptionDisableSessionPersistence, false);
+	QMutexLocker _{&ticketMutex};
+	if (const auto it = sessionTickets.constFind(ticketKey(url));
+		it != sessionTickets.constEnd() && it->expiresAt > QDateTime::currentDateTimeUtc())
+		config.setSessionTicket(it->ticket);
+	return config;
+}
+
+QDateTime RestClientPrivate::ticketExpiry(const QUrl &url) const
+{
+	if (!sessionResumption)
+		return {};
+
+	QMutexLocker _{&ticketMutex};
+	if (const auto it = sessionTickets.constFind(ticketKey(url));
+		it != sessionTickets.constEnd() && it->expiresAt > QDateTime::currentDateTimeUtc())
+		return it->expiresAt;
+	else
+		return {};
+}
+
+void RestClientPrivate::storeSessionTicket(QNetworkReply *reply)
+{
+	QReadLocker _{threadLock};
+	const auto url = reply->url();
+	if (!sessionResumption || url.scheme() != QStringLiteral("https"))
+		return;
+	const auto config = reply->sslConfiguration();
+	const auto ticket = config.sessionTicket();
+	if (ticket.isEmpty())
+		return;
+
+	// servers without a lifetime hint usually keep sessions for two hours
+	const auto lifetime = config.sessionTicketLifeTimeHint();
+	const auto key = ticketKey(url);
+	QMutexLocker ticketLocker{&ticketMutex};
+	auto &entry = sessionTickets[key];
+	if (entry.ticket == ticket)
+		return;
+	entry.ticket = ticket;
+	entry.expiresAt = QDateTime::currentDateTimeUtc().addSecs(lifetime > 0 ? lifetime : 7200);
+	ticketLocker.unlock();
+	if (!sessionTicketFile.isEmpty())
+		scheduleTicketSave();
+
+	qCDebug(logGlobal) << "Stored TLS session ticket for" << key;
+	// only the base URL's ticket is part of the builder. TLS 1.3 servers hand out new tickets all
+	// the time, so a template that still has a valid one keeps it
+	if (key == ticketKey(baseUrl)) {
+		QMutexLocker builderLocker{&builderMutex};
+		if (!builderTicketExpiry.isValid() || builderTicketExpiry <= QDateTime::currentDateTimeUtc())
+			builderTemplate.reset();
+	}
+}
+
+void RestClientPrivate::loadSessionTickets()
+{
+	QMutexLocker _{&ticketMutex};
+	sessionTickets.clear();
+	if (sessionTicketFile.isEmpty())
+		return;
+
+	QFile file{sessionTicketFile};
+	if (!file.exists())
+		return;
+	if (!file.open(QIODevice::ReadOnly)) {
+		qCWarning(logGlobal) << "Unable to read TLS session tickets from" << sessionTicketFile
+							 << "with error:" << file.errorString();
+		return;
+	}
+
+	const auto now = QDateTime::currentDateTimeUtc();
+	const auto tickets = QCborValue::fromCbor(file.readAll()).toMap();
+	for (auto it = tickets.constBegin(), end = tickets.constEnd(); it != end; ++it) {
+		const auto value = it.value().toMap();
+		SessionTicket entry {
+			value[QStringLiteral("ticket")].toByteArray(),
+			value[QStringLiteral("expiresAt")].toDateTime()
+		};
+		// expired tickets would only be rejected by the server
+		if (!entry.ticket.isEmpty() && entry.expiresAt > now)
+			sessionTickets.insert(it.key().toString(), std::move(entry));
+	}
+}
+
+void RestClientPrivate::scheduleTicketSave()
+{
+	// called by replies on any thread, the timer is only started on the client's thread
+	QMetaObject::invokeMethod(ticketSaveTimer, [timer = ticketSaveTimer]() {
+		// not restarted, so a steady stream of tickets cannot delay the write forever
+		if (!timer->isActive())
+			timer->start();
+	});
+}
+
+void RestClientPrivate::saveSessionTickets() const
+{
+	const auto now = QDateTime::currentDateTimeUtc();
+	QCborMap tickets;
+	{
+		QMutexLocker _{&ticketMutex};
+		for (auto it = sessionTickets.constBegin(), end = sessionTickets.constEnd(); it != end; ++it) {
+			if (it->expiresAt > now) {
+				tickets.insert(it.key(), QCborMap {
+					{QStringLiteral("ticket"), it->ticket},
+					{QStringLiteral("expiresAt"), QCborValue{it->expiresAt}}
+				});
+			}
+		}
+	}
+
+	// the tickets allow resuming the encrypted session, so only the user may read them
+	QSaveFile file{sessionTicketFile};
+	if (!file.open(QIODevice::WriteOnly) ||
+		file.write(tickets.toCborValue().toCbor()) < 0 ||
+		!file.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner) ||
+		!file.commit()) {
+		qCWarning(logGlobal) << "Unable to write TLS session tickets to" << sessionTicketFile
+							 << "with error:" << file.errorString();
+	}
+}
+
+QString RestClientPrivate::ticketKey(const QUrl &url)
+{
+	return url.host() + QLatin1Char(':') + QString::number(url.port(443));
+}
+#endif
+
+QSharedPointer<RequestBuilder::IExtender> RestClientPrivate::replyExtender() const
+{
+	return {};
+}
+
+bool RestClientPrivate::interceptReply(RestReply *reply, QNetworkReply *networkReply)
+{
+	Q_UNUSED(reply)
+	Q_UNUSED(networkReply)
+	return false;
+}
+
 // ------------- Global header implementation -------------
 
 Q_LOGGING_CATEGORY(QtRestClient::logGlobal, "qt.restclient");
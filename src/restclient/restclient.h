@@ -3,6 +3,13 @@
 
 #include "QtRestClient/qtrestclient_global.h"
 #include "QtRestClient/requestbuilder.h"
+#include "QtRestClient/contentcodecregistry.h"
+#include "QtRestClient/endpointselector.h"
+#include "QtRestClient/circuitbreaker.h"
+#include "QtRestClient/ratelimiter.h"
+
+#include <chrono>
+#include <optional>
 
 #include <QtCore/qobject.h>
 #include <QtCore/qurl.h>
@@ -36,6 +43,8 @@ class Q_RESTCLIENT_EXPORT RestClient : public QObject
 	Q_PROPERTY(DataMode dataMode READ dataMode WRITE setDataMode NOTIFY dataModeChanged)
 	//! The base URL to be used for every request to that api
 	Q_PROPERTY(QUrl baseUrl READ baseUrl WRITE setBaseUrl NOTIFY baseUrlChanged)
+	//! Replicas of the base URL that requests are distributed across
+	Q_PROPERTY(QList<QUrl> endpoints READ endpoints WRITE setEndpoints NOTIFY endpointsChanged)
 	//! The version number to be appended to the path
 	Q_PROPERTY(QVersionNumber apiVersion READ apiVersion WRITE setApiVersion NOTIFY apiVersionChanged)
 	//! A collection of headers to be added to every request
@@ -46,10 +55,24 @@ class Q_RESTCLIENT_EXPORT RestClient : public QObject
 	Q_PROPERTY(QHash<QNetworkRequest::Attribute, QVariant> requestAttributes READ requestAttributes WRITE setRequestAttributes NOTIFY requestAttributesChanged)
 	//! Specifies, whether the client can be used in a multithreaded context
 	Q_PROPERTY(bool threaded READ isThreaded WRITE setThreaded NOTIFY threadedChanged)
+	//! The number of connections to open in advance whenever the base URL changes
+	Q_PROPERTY(int autoWarmUp READ autoWarmUp WRITE setAutoWarmUp NOTIFY autoWarmUpChanged)
+	//! The delay after which idempotent requests are sent a second time, if still unanswered
+	Q_PROPERTY(std::chrono::milliseconds hedgingDelay READ hedgingDelay WRITE setHedgingDelay NOTIFY hedgingDelayChanged)
+	//! The time requests may take to complete, unless specified otherwise
+	Q_PROPERTY(std::chrono::milliseconds defaultTimeout READ defaultTimeout WRITE setDefaultTimeout NOTIFY defaultTimeoutChanged)
+	//! The settings of the circuit breaker, if enabled
+	Q_PROPERTY(std::optional<CircuitBreakerSettings> circuitBreaker READ circuitBreaker WRITE setCircuitBreaker NOTIFY circuitBreakerChanged)
+	//! The settings of the rate limiter, if enabled
+	Q_PROPERTY(std::optional<RateLimiterSettings> rateLimiter READ rateLimiter WRITE setRateLimiter NOTIFY rateLimiterChanged)
 
 #ifndef QT_NO_SSL
 	//! The SSL configuration to be used for HTTPS
 	Q_PROPERTY(QSslConfiguration sslConfiguration READ sslConfiguration WRITE setSslConfiguration NOTIFY sslConfigurationChanged)
+	//! Specifies, whether TLS session tickets of replies are reused for new connections
+	Q_PROPERTY(bool sessionResumption READ sessionResumption WRITE setSessionResumption NOTIFY sessionResumptionChanged)
+	//! A file to persist the TLS session tickets in, so they survive restarts
+	Q_PROPERTY(QString sessionTicketFile READ sessionTicketFile WRITE setSessionTicketFile NOTIFY sessionTicketFileChanged)
 #endif
 
 #ifdef QT_RESTCLIENT_USE_ASYNC
@@ -73,6 +96,7 @@ public:
 	//! Constructor with a serializer
 	explicit RestClient(QtJsonSerializer::SerializerBase *serializer, QObject *parent = nullptr);
 #endif
+	~RestClient() override;
 
 	//! Creates a new rest class for the given path and parent
 	RestClass *createClass(const QString &path, QObject *parent = nullptr);
@@ -87,11 +111,19 @@ public:
 #endif
 	//! Returns the paging factory used by the restclient
 	IPagingFactory *pagingFactory() const;
+	//! Returns the reply parser used for the given content type
+	IReplyParser *replyParser(const QByteArray &contentType) const;
+	//! Returns the registry with the parsers and codecs of all content types
+	ContentCodecRegistry codecRegistry() const;
+	//! Returns the selector that chooses one of the endpoints for each request
+	IEndpointSelector *endpointSelector() const;
 
 	//! @readAcFn{RestClient::dataMode}
 	DataMode dataMode() const;
 	//! @readAcFn{RestClient::baseUrl}
 	QUrl baseUrl() const;
+	//! @readAcFn{RestClient::endpoints}
+	QList<QUrl> endpoints() const;
 	//! @readAcFn{RestClient::apiVersion}
 	QVersionNumber apiVersion() const;
 	//! @readAcFn{RestClient::globalHeaders}
@@ -102,14 +134,28 @@ public:
 	QHash<QNetworkRequest::Attribute, QVariant> requestAttributes() const;
 	//! @readAcFn{RestClient::threaded}
 	bool isThreaded() const;
+	//! @readAcFn{RestClient::autoWarmUp}
+	int autoWarmUp() const;
 #ifndef QT_NO_SSL
 	//! @readAcFn{RestClient::sslConfiguration}
 	QSslConfiguration sslConfiguration() const;
+	//! @readAcFn{RestClient::sessionResumption}
+	bool sessionResumption() const;
+	//! @readAcFn{RestClient::sessionTicketFile}
+	QString sessionTicketFile() const;
 #endif
 #ifdef QT_RESTCLIENT_USE_ASYNC
 	//! @readAcFn{RestClient::asyncPool}
 	QThreadPool* asyncPool() const;
 #endif
+	//! @readAcFn{RestClient::hedgingDelay}
+	std::chrono::milliseconds hedgingDelay() const;
+	//! @readAcFn{RestClient::defaultTimeout}
+	std::chrono::milliseconds defaultTimeout() const;
+	//! @readAcFn{RestClient::circuitBreaker}
+	std::optional<CircuitBreakerSettings> circuitBreaker() const;
+	//! @readAcFn{RestClient::rateLimiter}
+	std::optional<RateLimiterSettings> rateLimiter() const;
 
 	//! Creates a request builder with all the settings of this client
 	virtual RequestBuilder builder() const;
@@ -124,11 +170,21 @@ public Q_SLOTS:
 
 	//! Sets the paging factory to be used by all paging requests for this client
 	void setPagingFactory(IPagingFactory *factory);
+	//! Adds a parser to be used by all replies of this client for the content types of the parser
+	void addReplyParser(IReplyParser *parser);
+	//! Removes the parser or codec of the given content type
+	void removeReplyParser(const QByteArray &contentType);
+	//! Sets the registry with the parsers and codecs of all content types
+	void setCodecRegistry(const ContentCodecRegistry &registry);
+	//! Sets the selector that chooses one of the endpoints for each request
+	void setEndpointSelector(IEndpointSelector *selector);
 
 	//! @writeAcFn{RestClient::dataMode}
 	void setDataMode(DataMode dataMode);
 	//! @writeAcFn{RestClient::baseUrl}
 	void setBaseUrl(QUrl baseUrl);
+	//! @writeAcFn{RestClient::endpoints}
+	void setEndpoints(QList<QUrl> endpoints);
 	//! @writeAcFn{RestClient::apiVersion}
 	void setApiVersion(QVersionNumber apiVersion);
 	//! @writeAcFn{RestClient::globalHeaders}
@@ -141,9 +197,23 @@ public Q_SLOTS:
 	void setModernAttributes();
 	//! @writeAcFn{RestClient::threaded}
 	void setThreaded(bool threaded);
+	//! @writeAcFn{RestClient::autoWarmUp}
+	void setAutoWarmUp(int autoWarmUp);
+	//! @writeAcFn{RestClient::hedgingDelay}
+	void setHedgingDelay(std::chrono::milliseconds hedgingDelay);
+	//! @writeAcFn{RestClient::defaultTimeout}
+	void setDefaultTimeout(std::chrono::milliseconds defaultTimeout);
+	//! @writeAcFn{RestClient::circuitBreaker}
+	void setCircuitBreaker(std::optional<CircuitBreakerSettings> circuitBreaker);
+	//! @writeAcFn{RestClient::rateLimiter}
+	void setRateLimiter(std::optional<RateLimiterSettings> rateLimiter);
 #ifndef QT_NO_SSL
 	//! @writeAcFn{RestClient::sslConfiguration}
 	void setSslConfiguration(QSslConfiguration sslConfiguration);
+	//! @writeAcFn{RestClient::sessionResumption}
+	void setSessionResumption(bool sessionResumption);
+	//! @writeAcFn{RestClient::sessionTicketFile}
+	void setSessionTicketFile(QString sessionTicketFile);
 #endif
 #ifdef QT_RESTCLIENT_USE_ASYNC
 	//! @writeAcFn{RestClient::asyncPool}
@@ -165,11 +235,16 @@ public Q_SLOTS:
 	//! @writeAcFn{RestClient::requestAttributes}
 	void removeRequestAttribute(QNetworkRequest::Attribute attribute);
 
+	//! Opens connections to the host of the base URL before any request is sent
+	void warmUp(int connections = 1);
+
 Q_SIGNALS:
 	//! @notifyAcFn{RestClient::dataMode}
 	void dataModeChanged(DataMode dataMode, QPrivateSignal);
 	//! @notifyAcFn{RestClient::baseUrl}
 	void baseUrlChanged(QUrl baseUrl, QPrivateSignal);
+	//! @notifyAcFn{RestClient::endpoints}
+	void endpointsChanged(QList<QUrl> endpoints, QPrivateSignal);
 	//! @notifyAcFn{RestClient::apiVersion}
 	void apiVersionChanged(QVersionNumber apiVersion, QPrivateSignal);
 	//! @notifyAcFn{RestClient::globalHeaders}
@@ -180,9 +255,23 @@ Q_SIGNALS:
 	void requestAttributesChanged(QHash<QNetworkRequest::Attribute, QVariant> requestAttributes, QPrivateSignal);
 	//! @notifyAcFn{RestClient::threaded}
 	void threadedChanged(bool threaded, QPrivateSignal);
+	//! @notifyAcFn{RestClient::autoWarmUp}
+	void autoWarmUpChanged(int autoWarmUp, QPrivateSignal);
+	//! @notifyAcFn{RestClient::hedgingDelay}
+	void hedgingDelayChanged(std::chrono::milliseconds hedgingDelay, QPrivateSignal);
+	//! @notifyAcFn{RestClient::defaultTimeout}
+	void defaultTimeoutChanged(std::chrono::milliseconds defaultTimeout, QPrivateSignal);
+	//! @notifyAcFn{RestClient::circuitBreaker}
+	void circuitBreakerChanged(std::optional<CircuitBreakerSettings> circuitBreaker, QPrivateSignal);
+	//! @notifyAcFn{RestClient::rateLimiter}
+	void rateLimiterChanged(std::optional<RateLimiterSettings> rateLimiter, QPrivateSignal);
 #ifndef QT_NO_SSL
 	//! @notifyAcFn{RestClient::sslConfiguration}
 	void sslConfigurationChanged(QSslConfiguration sslConfiguration, QPrivateSignal);
+	//! @notifyAcFn{RestClient::sessionResumption}
+	void sessionResumptionChanged(bool sessionResumption, QPrivateSignal);
+	//! @notifyAcFn{RestClient::sessionTicketFile}
+	void sessionTicketFileChanged(QString sessionTicketFile, QPrivateSignal);
 #endif
 #ifdef QT_RESTCLIENT_USE_ASYNC
 	//! @notifyAcFn{RestClient::asyncPool}
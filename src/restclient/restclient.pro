@@ -27,7 +27,21 @@ HEADERS += \
 	restreply.h \
 	standardpaging_p.h \
 	restreplyawaitable.h \
-	restreplyawaitable_p.h
+	restreplyawaitable_p.h \
+	configurablepagingfactory.h \
+	configurablepagingfactory_p.h \
+	replyhandle.h \
+	ireplyparser.h \
+	contentcodecregistry.h \
+	contentcodecregistry_p.h \
+	endpointselector.h \
+	endpointselector_p.h \
+	circuitbreaker.h \
+	circuitbreaker_p.h \
+	ratelimiter.h \
+	ratelimiter_p.h \
+	replyaccounting_p.h \
+	failednetworkreply_p.h
 
 !no_json_serializer {
 	HEADERS += \
@@ -35,6 +49,8 @@ HEADERS += \
 		paging_fwd.h \
 		paging.h \
 		genericrestreply.h \
+		generatedcodec.h \
+		pagingstream.h \
 		simple.h
 }
 
@@ -46,7 +62,17 @@ SOURCES += \
 	restreply.cpp \
 	standardpaging.cpp \
 	ipaging.cpp \
-	restreplyawaitable.cpp
+	restreplyawaitable.cpp \
+	configurablepagingfactory.cpp \
+	replyhandle.cpp \
+	ireplyparser.cpp \
+	contentcodecregistry.cpp \
+	messagepackcodec.cpp \
+	endpointselector.cpp \
+	circuitbreaker.cpp \
+	ratelimiter.cpp \
+	replyaccounting.cpp \
+	failednetworkreply.cpp
 
 load(qt_module)
 
@@ -3,10 +3,17 @@
 
 #include "restclient.h"
 #include "standardpaging_p.h"
+#include "contentcodecregistry.h"
+#include "endpointselector_p.h"
+#include "circuitbreaker_p.h"
+#include "ratelimiter_p.h"
 
 #include <optional>
 
+#include <QtCore/QDateTime>
+#include <QtCore/QMutex>
 #include <QtCore/QReadWriteLock>
+#include <QtCore/QTimer>
 
 #ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
 #include <QtJsonSerializer/SerializerBase>
@@ -25,14 +32,43 @@ public:
 	static QReadWriteLock globalApiLock;
 	static QHash<QString, RestClient*> globalApis;
 
+	// lets replies on other threads reach the client only while it exists
+	struct ClientGuard {
+		QReadWriteLock lock;
+		RestClientPrivate *client = nullptr;
+	};
+	QSharedPointer<ClientGuard> guard = QSharedPointer<ClientGuard>::create();
+
 	QUrl baseUrl;
+	QList<QUrl> endpoints;
+	QSharedPointer<IEndpointSelector> endpointSelector;
+	QSharedPointer<EndpointPool> endpointPool;
+	std::chrono::milliseconds hedgingDelay {-1};
+	std::chrono::milliseconds defaultTimeout {-1};
+	std::optional<CircuitBreakerSettings> circuitBreakerSettings;
+	QSharedPointer<CircuitBreaker> circuitBreaker;
+	std::optional<RateLimiterSettings> rateLimiterSettings;
+	QSharedPointer<RateLimiter> rateLimiter;
 	QVersionNumber apiVersion;
 	HeaderHash headers;
 	QUrlQuery query;
 	QHash<QNetworkRequest::Attribute, QVariant> attribs;
 	QAtomicPointer<QReadWriteLock> threadLock {nullptr};
+	int autoWarmUp = 0;
 #ifndef QT_NO_SSL
 	QSslConfiguration sslConfig = QSslConfiguration::defaultConfiguration();
+	bool sessionResumption = false;
+	QString sessionTicketFile;
+
+	struct SessionTicket {
+		QByteArray ticket;
+		QDateTime expiresAt;
+	};
+	// tickets by "host:port", updated by replies from any thread
+	mutable QMutex ticketMutex;
+	QHash<QString, SessionTicket> sessionTickets;
+	// collects new tickets on the client's thread, so the file is written at most once per interval
+	QTimer *ticketSaveTimer = nullptr;
 #endif
 #ifdef QT_RESTCLIENT_USE_ASYNC
 	QPointer<QThreadPool> asyncPool;
@@ -45,11 +81,39 @@ public:
 	DataMode dataMode = DataMode::Json;
 #endif
 
-	QScopedPointer<IPagingFactory> pagingFactory {};
+	QSharedPointer<IPagingFactory> pagingFactory;
+	ContentCodecRegistry codecs;
 
 	RestClass *rootClass = nullptr;
 
+	// prebuilt builder with all client settings, copied for every request
+	mutable QMutex builderMutex;
+	mutable std::optional<RequestBuilder> builderTemplate;
+#ifndef QT_NO_SSL
+	// expiry of the session ticket in the template, invalid if it has none
+	mutable QDateTime builderTicketExpiry;
+#endif
+
 	~RestClientPrivate() override;
+
+	RequestBuilder createBuilder() const;
+	void invalidateBuilder();
+	void resetEndpoints();
+	void warmUp(int connections) const;
+#ifndef QT_NO_SSL
+	QSslConfiguration requestSslConfig(const QUrl &url) const;
+	QDateTime ticketExpiry(const QUrl &url) const;
+	void storeSessionTicket(QNetworkReply *reply);
+	void loadSessionTickets();
+	void scheduleTicketSave();
+	void saveSessionTickets() const;
+	static QString ticketKey(const QUrl &url);
+#endif
+
+	// extender to sign a request again when a reply of this client is retried
+	virtual QSharedPointer<RequestBuilder::IExtender> replyExtender() const;
+	// called for every finished reply before it is evaluated. Returning true takes over the reply
+	virtual bool interceptReply(RestReply *reply, QNetworkReply *networkReply);
 };
 
 }
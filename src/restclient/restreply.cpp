@@ -1,11 +1,13 @@
 #include "restreply.h"
 #include "restreply_p.h"
 #include "restclass.h"
+#include "restclient_p.h"
 #include "restreplyawaitable.h"
 #include "requestbuilder_p.h"
+#include "contentcodecregistry_p.h"
 
 #include <QtCore/QBuffer>
-#include <QtCore/QJsonDocument>
+#include <QtCore/QMetaMethod>
 #include <QtCore/QTimer>
 #include <QtCore/QCborStreamReader>
 using namespace QtRestClient;
@@ -64,6 +66,9 @@ RestReply::RestReply(const QFuture<QNetworkReply *> &networkReplyFuture, QThread
 RestReply::~RestReply()
 {
 	Q_D(RestReply);
+	d->cancelHedge();
+	d->endEndpoint(EndpointPool::Outcome::Canceled);
+	d->endCircuit(CircuitBreaker::Outcome::Canceled);
 	if (d->networkReply)
 		d->networkReply->deleteLater();
 }
@@ -133,6 +138,35 @@ QNetworkReply *RestReply::networkReply() const
 	return d->networkReply.data();
 }
 
+void RestReply::setupClient(RestClient *client)
+{
+	Q_D(RestReply);
+	const auto clientD = static_cast<RestClientPrivate*>(QObjectPrivate::get(client));
+	QReadLocker _{clientD->threadLock};
+	d->codecs = clientD->codecs;
+	d->clientGuard = clientD->guard;
+	d->extender = clientD->replyExtender();
+	d->endpoints = clientD->endpointPool;
+	d->hedgingDelay = clientD->hedgingDelay;
+	d->circuitBreaker = clientD->circuitBreaker;
+	d->rateLimiter = clientD->rateLimiter;
+	d->beginEndpoint();
+	d->beginCircuit();
+	d->beginRateLimit();
+	d->startHedging();
+}
+
+HeaderHash RestReply::responseHeaders() const
+{
+	Q_D(const RestReply);
+	HeaderHash headers;
+	if (d->networkReply) {
+		for (const auto &header : d->networkReply->rawHeaderPairs())
+			headers.insert(header.first.toLower(), header.second);
+	}
+	return headers;
+}
+
 RestReplyAwaitable RestReply::awaitable()
 {
 	return RestReplyAwaitable{this};
@@ -206,6 +240,12 @@ RestReply::RestReply(RestReplyPrivate &dd, QObject *parent) :
 			Qt::DirectConnection);
 }
 
+void RestReply::setCborDecoder(std::function<bool(QCborStreamReader &)> decoder)
+{
+	Q_D(RestReply);
+	d->cborDecoder = std::move(decoder);
+}
+
 Qt::ConnectionType RestReply::callbackType() const
 {
 #ifdef QT_RESTCLIENT_USE_ASYNC
@@ -220,34 +260,80 @@ Qt::ConnectionType RestReply::callbackType() const
 
 const QByteArray RestReplyPrivate::PropertyBuffer("__QtRestClient_RestReplyPrivate_PropertyBuffer");
 
-QNetworkReply *RestReplyPrivate::compatSend(QNetworkAccessManager *nam, const QNetworkRequest &request, const QByteArray &verb, const QByteArray &body)
+const QByteArray RestReplyPrivate::PropertyDevice("__QtRestClient_RestReplyPrivate_PropertyDevice");
+
+// the last user attributes, as applications usually allocate theirs from the start of the range
+const QNetworkRequest::Attribute RestReplyPrivate::DeadlineAttribute = QNetworkRequest::UserMax;
+
+const QNetworkRequest::Attribute RestReplyPrivate::RouteAttribute = static_cast<QNetworkRequest::Attribute>(QNetworkRequest::UserMax - 1);
+
+QDeadlineTimer RestReplyPrivate::requestDeadline(const QNetworkRequest &request)
+{
+	QDeadlineTimer deadline{QDeadlineTimer::Forever};
+	if (const auto value = request.attribute(DeadlineAttribute); value.isValid())
+		deadline.setDeadline(value.toLongLong(), Qt::PreciseTimer);
+	return deadline;
+}
+
+QString RestReplyPrivate::routeKey(const QNetworkRequest &request, bool withRoute)
+{
+	const auto url = request.url();
+	auto key = QStringLiteral("%1:%2")
+				   .arg(url.host())
+				   .arg(url.port(url.scheme() == QStringLiteral("https") ? 443 : 80));
+	if (const auto route = request.attribute(RouteAttribute).toString(); withRoute && !route.isEmpty())
+		key += QLatin1Char('/') + route;
+	return key;
+}
+
+QNetworkReply *RestReplyPrivate::compatSend(QNetworkAccessManager *nam, const QNetworkRequest &request, const QByteArray &verb, const QByteArray &body, QIODevice *device, const QSharedPointer<CircuitBreaker> &circuitBreaker, const QSharedPointer<RateLimiter> &rateLimiter, const QString &failure)
 {
 	QNetworkReply *reply = nullptr;
-	if (body.isEmpty())
+	const auto circuit = circuitBreaker && failure.isNull() ? circuitBreaker->circuit(request) : QString{};
+	// requests that could not be prepared or go to open circuits never reach the network access manager
+	if (!failure.isNull())
+		reply = new FailedNetworkReply{nam, request, verb, QNetworkReply::ProtocolInvalidOperationError, failure};
+	else if (!circuit.isEmpty() && !circuitBreaker->tryAcquire(circuit))
+		reply = new RejectedNetworkReply{nam, request, verb, circuit};
+	else if (device)
+		reply = nam->sendCustomRequest(request, verb, device);
+	else if (body.isEmpty())
 		reply = nam->sendCustomRequest(request, verb);
-	else {
+	else
 		reply = nam->sendCustomRequest(request, verb, body);
-		if (reply)
-			reply->setProperty(PropertyBuffer, body);
-	}
+
+	// the acquired circuit slot is given free, the quota headers are read once the reply finished
+	// and the deadline is enforced, whoever evaluates the reply
+	if (const auto deadline = requestDeadline(request);
+		reply && (!circuit.isEmpty() || !deadline.isForever() || rateLimiter) && !qobject_cast<FailedNetworkReply*>(reply))
+		ReplyAccounting::attach(reply, circuitBreaker, circuit, deadline, rateLimiter);
+	if (reply && device) {
+		// streamed bodies are never buffered, a retry reads the device again
+		reply->setProperty(PropertyDevice, QVariant::fromValue(QPointer<QIODevice>{device}));
+	} else if (reply && !body.isEmpty())
+		reply->setProperty(PropertyBuffer, body);
 	return reply;
 }
 
 #ifdef QT_RESTCLIENT_USE_ASYNC
-void RestReplyPrivate::compatSendAsync(QFutureInterface<QNetworkReply*> futureIf, QNetworkAccessManager *nam, const QNetworkRequest &request, const QByteArray &verb, const QByteArray &body)
+void RestReplyPrivate::compatSendAsync(QFutureInterface<QNetworkReply*> futureIf, QNetworkAccessManager *nam, const QNetworkRequest &request, const QByteArray &verb, const QByteArray &body, QIODevice *device, QSharedPointer<CircuitBreaker> circuitBreaker, QSharedPointer<RateLimiter> rateLimiter, milliseconds delay, const QString &failure)
 {
 	futureIf.reportStarted();
-	if (QThread::currentThread() == nam->thread()) {
-		auto rep = compatSend(nam, request, verb, body);
+	if (QThread::currentThread() == nam->thread() && delay <= 0ms) {
+		auto rep = compatSend(nam, request, verb, body, device, circuitBreaker, rateLimiter, failure);
 		futureIf.reportFinished(&rep);
 	} else {
-		auto helper = new AsyncHelper{[xfif = std::move(futureIf), nam, request, verb, body]() {
+		auto helper = new AsyncHelper{[xfif = std::move(futureIf), nam, request, verb, body, xDevice = QPointer<QIODevice>{device}, circuitBreaker, rateLimiter, failure]() {
 			auto fif = xfif;
-			auto rep = compatSend(nam, request, verb, body);
+			auto rep = compatSend(nam, request, verb, body, xDevice, circuitBreaker, rateLimiter, failure);
 			fif.reportFinished(&rep);
 		}};
 		helper->moveToThread(nam->thread());
-		QMetaObject::invokeMethod(helper, "exec");
+		// rate limited requests wait on the thread of the network access manager
+		if (delay > 0ms)
+			QTimer::singleShot(delay, helper, &AsyncHelper::exec);
+		else
+			QMetaObject::invokeMethod(helper, "exec");
 	}
 }
 #endif
@@ -260,8 +346,15 @@ RestReplyPrivate::RestReplyPrivate()
 void RestReplyPrivate::connectReply()
 {
 	Q_Q(RestReply);
-	connect(networkReply, &QNetworkReply::finished,
-			this, &RestReplyPrivate::_q_replyFinished);
+	accounted = false;
+	rateLimited = false;
+	// replies that finished while being connected report twice, but are only evaluated once
+	const auto onFinished = [this, q, reply = networkReply]() {
+		if (networkReply == reply && QObject::disconnect(reply, &QNetworkReply::finished, q, nullptr))
+			_q_replyFinished();
+	};
+	QObject::connect(networkReply, &QNetworkReply::finished,
+					 q, onFinished);
 
 	// forward some signals
 #if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
@@ -279,10 +372,194 @@ void RestReplyPrivate::connectReply()
 					 q, &RestReply::downloadProgress);
 	QObject::connect(networkReply, &QNetworkReply::uploadProgress,
 					 q, &RestReply::uploadProgress);
+	QObject::connect(networkReply, &QNetworkReply::metaDataChanged,
+					 q, &RestReply::metaDataChanged);
+	beginEndpoint();
+	beginCircuit();
+	beginRateLimit();
+	startHedging();
+	startDeadline();
+
+	// replies aborted while being sent finish before they can be connected
+	if (networkReply->isFinished())
+		QMetaObject::invokeMethod(q, onFinished, Qt::QueuedConnection);
+}
+
+void RestReplyPrivate::beginEndpoint()
+{
+	// every network reply counts as outstanding for its endpoint until it is evaluated
+	if (!endpoints || !networkReply || endpoint != -1)
+		return;
+	endpoint = endpoints->indexOf(networkReply->request().url());
+	if (endpoint != -1) {
+		endpoints->begin(endpoint);
+		endpointTimer.start();
+	}
+}
+
+void RestReplyPrivate::endEndpoint(EndpointPool::Outcome outcome)
+{
+	if (endpoint == -1)
+		return;
+	endpoints->end(endpoint, outcome, milliseconds{endpointTimer.elapsed()});
+	endpoint = -1;
+}
+
+void RestReplyPrivate::beginCircuit()
+{
+	// rejected requests never took part in their circuit, and replies that finished before they
+	// were connected have already been evaluated
+	if (!circuitBreaker || !networkReply || !circuit.isEmpty())
+		return;
+	if (const auto accounting = ReplyAccounting::of(networkReply); accounting && accounting->takeOver()) {
+		circuit = accounting->circuit();
+		circuitTimer = accounting->timer();
+	}
+}
+
+void RestReplyPrivate::endCircuit(CircuitBreaker::Outcome outcome)
+{
+	if (circuit.isEmpty())
+		return;
+	circuitBreaker->release(std::exchange(circuit, {}), outcome, milliseconds{circuitTimer.elapsed()});
+}
+
+void RestReplyPrivate::beginRateLimit()
+{
+	// replies that finished before they were connected have already updated their bucket
+	if (!rateLimiter || !networkReply || rateLimited)
+		return;
+	const auto accounting = ReplyAccounting::of(networkReply);
+	rateLimited = !accounting || accounting->takeOverRateLimit();
+}
+
+void RestReplyPrivate::startHedging()
+{
+	Q_Q(RestReply);
+	if (hedgingDelay < 0ms || !networkReply || networkReply->isFinished() || hedgeReply)
+		return;
+	// only safe requests can be sent twice without side effects
+	const auto verb = networkReply->request().attribute(QNetworkRequest::CustomVerbAttribute, RestClass::GetVerb).toByteArray();
+	if ((verb != RestClass::GetVerb && verb != RestClass::HeadVerb) ||
+		networkReply->property(PropertyDevice).isValid())
+		return;
+
+	auto delay = hedgingDelay;
+	if (delay == 0ms) {
+		// without enough measurements, there is no 95th percentile to wait for
+		const auto percentile = endpoint != -1 ?
+									endpoints->latencyPercentile(endpoint, 0.95) :
+									std::nullopt;
+		if (!percentile)
+			return;
+		delay = *percentile;
+	}
+
+	if (!hedgeTimer) {
+		hedgeTimer = new QTimer{q};
+		hedgeTimer->setSingleShot(true);
+		connect(hedgeTimer, &QTimer::timeout,
+				this, &RestReplyPrivate::_q_sendHedge);
+	}
+	hedgeTimer->start(delay);
+}
+
+void RestReplyPrivate::cancelHedge()
+{
+	Q_Q(RestReply);
+	if (hedgeTimer)
+		hedgeTimer->stop();
+	if (hedgeReply) {
+		// disconnect first, as aborting emits finished
+		QObject::disconnect(hedgeReply, nullptr, q, nullptr);
+		if (hedgeEndpoint != -1)
+			endpoints->end(std::exchange(hedgeEndpoint, -1), EndpointPool::Outcome::Canceled, milliseconds{hedgeEndpointTimer.elapsed()});
+		if (!hedgeCircuit.isEmpty())
+			circuitBreaker->release(std::exchange(hedgeCircuit, {}), CircuitBreaker::Outcome::Canceled, milliseconds{hedgeEndpointTimer.elapsed()});
+		hedgeReply->abort();
+		hedgeReply->deleteLater();
+		hedgeReply = nullptr;
+	}
+}
+
+void RestReplyPrivate::startDeadline()
+{
+	Q_Q(RestReply);
+	// retries and hedges carry the deadline of the original request. Replies that were aborted at
+	// it before they were connected still count as timed out
+	deadline = requestDeadline(networkReply->request());
+	if (const auto accounting = ReplyAccounting::of(networkReply); accounting && !accounting->takeOverDeadline())
+		timedOut = true;
+	if (deadline.isForever() || networkReply->isFinished())
+		return;
+
+	if (!deadlineTimer) {
+		deadlineTimer = new QTimer{q};
+		deadlineTimer->setSingleShot(true);
+		deadlineTimer->setTimerType(Qt::PreciseTimer);
+		connect(deadlineTimer, &QTimer::timeout,
+				this, &RestReplyPrivate::_q_deadlineExpired);
+	}
+	deadlineTimer->start(std::chrono::ceil<milliseconds>(deadline.remainingTimeAsDuration()));
+}
+
+void RestReplyPrivate::reportTimeout()
+{
+	Q_Q(RestReply);
+	qCDebug(logReply) << "Request did not complete before its deadline";
+	Q_EMIT q->error(QStringLiteral("The request did not complete before its deadline"),
+					QNetworkReply::TimeoutError,
+					Error::Timeout,
+					{});
+}
+
+QNetworkReply *RestReplyPrivate::resend(bool hedge) const
+{
+	auto nam = networkReply->manager();
+	if (const auto failed = qobject_cast<FailedNetworkReply*>(networkReply.data()); failed)
+		nam = failed->nam();
+	auto request = networkReply->request();
+	auto verb = request.attribute(QNetworkRequest::CustomVerbAttribute, RestClass::GetVerb).toByteArray();
+	auto body = networkReply->property(PropertyBuffer).toByteArray();
+	const auto device = networkReply->property(PropertyDevice).value<QPointer<QIODevice>>();
+	if (device && !device->reset())
+		qCWarning(logReply) << "Unable to rewind the body device - retrying with the remaining data";
+	// hedges always go to another endpoint, retries only leave an endpoint that was ejected in the meantime
+	if (endpoints) {
+		if (const auto current = endpoints->indexOf(request.url()); current != -1 && (hedge || !endpoints->isHealthy(current)))
+			request.setUrl(endpoints->resolve(request.url(), current));
+	}
+	// sign the request again, as credentials or the URL might have changed since it was sent
+	QString failure;
+	if (extender) {
+		if (device && extender->requiresBody()) {
+			if (device->isSequential())
+				failure = RequestBuilderPrivate::SequentialBodyError;
+			else
+				body = device->peek(device->bytesAvailable());
+		}
+		extender->extendRequest(request, verb, &body);
+	}
+
+	qCDebug(logReply) << (hedge ? "Hedging" : "Retrying") << "request with HTTP-Verb:"
+					  << verb.constData();
+	return compatSend(nam, request, verb, body, device, circuitBreaker, rateLimiter, failure);
+}
+
+bool RestReplyPrivate::hasDataReceivers() const
+{
+	Q_Q(const RestReply);
+	// a decoder is only set for a single typed handler, which is connected to succeeded. Any other
+	// connection, i.e. plain QObject::connect calls, needs the document
+	static const auto succeededSignal = QByteArray::number(QSIGNAL_CODE) + QMetaMethod::fromSignal(&RestReply::succeeded).methodSignature();
+	static const auto completedSignal = QByteArray::number(QSIGNAL_CODE) + QMetaMethod::fromSignal(&RestReply::completed).methodSignature();
+	return q->receivers(succeededSignal.constData()) - ForwardedSignals > 1 ||
+		   q->receivers(completedSignal.constData()) > 0;
 }
 
 void RestReplyPrivate::_q_replyFinished()
 {
+	cancelHedge();
 #ifdef QT_RESTCLIENT_USE_ASYNC
 	if (asyncPool)
 		asyncPool->start(this);
@@ -293,19 +570,97 @@ void RestReplyPrivate::_q_replyFinished()
 
 void RestReplyPrivate::_q_retryReply()
 {
-	auto nam = networkReply->manager();
-	auto request = networkReply->request();
-	auto verb = request.attribute(QNetworkRequest::CustomVerbAttribute, RestClass::GetVerb).toByteArray();
-	auto body = networkReply->property(PropertyBuffer).toByteArray();
+	Q_Q(RestReply);
+	// the deadline may have passed while waiting for the retry, i.e. for a token refresh
+	if (timedOut || deadline.hasExpired()) {
+		reportTimeout();
+		if (autoDelete)
+			q->deleteLater();
+		return;
+	}
 
-	qCDebug(logReply) << "Retrying request with HTTP-Verb:"
-					  << verb.constData();
+	auto reply = resend(false);
+	networkReply->deleteLater();
+	networkReply = reply;
+	connectReply();
+}
+
+void RestReplyPrivate::_q_sendHedge()
+{
+	if (!networkReply || networkReply->isFinished() || hedgeReply)
+		return;
+	// hedges are only worth it while the quota of the server has room for them
+	if (rateLimiter && !rateLimiter->tryTake(rateLimiter->bucket(networkReply->request())))
+		return;
 
+	const auto reply = resend(true);
+	// hedging into an open circuit would not help
+	if (qobject_cast<FailedNetworkReply*>(reply)) {
+		reply->deleteLater();
+		return;
+	}
+
+	hedgeReply = reply;
+	connect(hedgeReply, &QNetworkReply::finished,
+			this, &RestReplyPrivate::_q_hedgeFinished);
+	hedgeEndpointTimer.start();
+	if (endpoints) {
+		hedgeEndpoint = endpoints->indexOf(hedgeReply->request().url());
+		if (hedgeEndpoint != -1)
+			endpoints->begin(hedgeEndpoint);
+	}
+	if (const auto accounting = circuitBreaker ? ReplyAccounting::of(hedgeReply) : nullptr;
+		accounting && accounting->takeOver())
+		hedgeCircuit = accounting->circuit();
+}
+
+void RestReplyPrivate::_q_hedgeFinished()
+{
+	Q_Q(RestReply);
+	if (!hedgeReply)
+		return;
+
+	// a failed hedge never wins, the original request may still succeed
+	const auto error = hedgeReply->error();
+	const auto status = hedgeReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+	if (error != QNetworkReply::NoError && (status == 0 || status >= 500)) {
+		if (hedgeEndpoint != -1)
+			endpoints->end(std::exchange(hedgeEndpoint, -1), EndpointPool::Outcome::Failure, milliseconds{hedgeEndpointTimer.elapsed()});
+		if (!hedgeCircuit.isEmpty())
+			circuitBreaker->release(std::exchange(hedgeCircuit, {}), CircuitBreaker::Outcome::Failure, milliseconds{hedgeEndpointTimer.elapsed()});
+		hedgeReply->deleteLater();
+		hedgeReply = nullptr;
+		return;
+	}
+
+	// the original request lost, so it is stopped without ever being evaluated
+	qCDebug(logReply) << "Hedged request finished first - aborting the original one";
+	QObject::disconnect(networkReply, nullptr, q, nullptr);
+	endEndpoint(EndpointPool::Outcome::Canceled);
+	endCircuit(CircuitBreaker::Outcome::Canceled);
+	networkReply->abort();
 	networkReply->deleteLater();
-	networkReply = compatSend(nam, request, verb, body);
+
+	networkReply = std::exchange(hedgeReply, nullptr);
+	endpoint = std::exchange(hedgeEndpoint, -1);
+	endpointTimer = hedgeEndpointTimer;
+	circuit = std::exchange(hedgeCircuit, {});
+	circuitTimer = hedgeEndpointTimer;
 	connectReply();
 }
 
+void RestReplyPrivate::_q_deadlineExpired()
+{
+	// finished replies are stopped when evaluated or retried instead
+	if (!networkReply || networkReply->isFinished())
+		return;
+
+	qCDebug(logReply) << "Aborting request after its deadline expired";
+	timedOut = true;
+	cancelHedge();
+	networkReply->abort();
+}
+
 #ifndef QT_NO_SSL
 void RestReplyPrivate::_q_handleSslErrors(const QList<QSslError> &errors)
 {
@@ -324,7 +679,48 @@ void RestReplyPrivate::run()
 	if (!networkReply)
 		return;
 
+	const auto unsent = qobject_cast<FailedNetworkReply*>(networkReply.data()) != nullptr;
+	const auto rejected = qobject_cast<RejectedNetworkReply*>(networkReply.data()) != nullptr;
+	// only server errors and failed connections count against the health of an endpoint
+	auto outcome = EndpointPool::Outcome::Success;
+	if (const auto error = networkReply->error(); unsent || error == QNetworkReply::OperationCanceledError)
+		outcome = EndpointPool::Outcome::Canceled;
+	else if (const auto status = networkReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+			 status >= 500 || (status == 0 && error != QNetworkReply::NoError))
+		outcome = EndpointPool::Outcome::Failure;
+	endEndpoint(outcome);
+	// replies aborted at their deadline are just what the circuit breaker protects against
+	endCircuit(timedOut ? CircuitBreaker::Outcome::Failure : outcome);
+	// intercepted replies are evaluated again once the client hands them back, but only counted once
+	const auto account = !std::exchange(accounted, true);
+	if (account && rateLimited && !unsent)
+		rateLimiter->update(rateLimiter->bucket(networkReply->request()), networkReply);
+
+	const auto expired = timedOut || deadline.hasExpired();
+	if (clientGuard) {
+		QReadLocker _{&clientGuard->lock};
+		if (const auto clientD = clientGuard->client; clientD) {
+#ifndef QT_NO_SSL
+			if (account)
+				clientD->storeSessionTicket(networkReply);
+#endif
+			// the client may take over a reply once, i.e. to replay it after refreshing its credentials
+			if (!expired && !intercepted && clientD->interceptReply(q, networkReply)) {
+				intercepted = true;
+				return;
+			}
+		}
+	}
+
 	retryDelay = -1ms;
+	// after the deadline, the data is neither parsed nor handed to any handler
+	if (expired) {
+		reportTimeout();
+		if (autoDelete)
+			QMetaObject::invokeMethod(q, "deleteLater");
+		return;
+	}
+
 	const auto status = networkReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
 	auto contentType = networkReply->header(QNetworkRequest::ContentTypeHeader).toByteArray().trimmed();
 	const auto contentLength = networkReply->header(QNetworkRequest::ContentLengthHeader).toInt();
@@ -333,6 +729,14 @@ void RestReplyPrivate::run()
 					  << "and content of type" << contentType
 					  << "with length" << contentLength;
 
+	// the server did not process requests rejected for exceeding its quota, so they are queued again
+	if (rateLimiter && status == 429 && requeues < rateLimiter->settings().maxRequeues) {
+		++requeues;
+		qCDebug(logReply) << "Queuing request again after it exceeded the quota of the server";
+		scheduleRetry(0ms);
+		return;
+	}
+
 	DataType data{std::nullopt};
 	std::optional<std::pair<int, QString>> parseError = std::nullopt;
 
@@ -353,41 +757,35 @@ void RestReplyPrivate::run()
 
 	if (parseError) {
 		// means content type is invalid -> do nothing, but is here to skip the rest
+	} else if (unsent) {
+		// nothing was received, as nothing was sent
 	} else if (contentLength == 0 && (status == 204 || status >= 300 || allowEmptyReplies)) {  // 204 = NO_CONTENT
 		// ok, nothing to do, but is here to skip the rest
-	} else if (contentType == RequestBuilderPrivate::ContentTypeCbor) {
-		QCborStreamReader reader{networkReply};
-		data = QCborValue::fromCbor(reader);
-		if (const auto error = reader.lastError(); error.c != QCborError::NoError)
-			parseError = std::make_pair(error.c, error.toString());
-	} else if (contentType == RequestBuilderPrivate::ContentTypeJson) {
-		const auto readData = networkReply->readAll();
-		QJsonParseError error;
-		auto jDoc = QJsonDocument::fromJson(readData, &error);
-		if (error.error != QJsonParseError::NoError) {
-			parseError = std::make_pair(error.error, error.errorString());
-			if (error.error == QJsonParseError::IllegalValue) {
-				// try to read again as array, to get valid non obj/arr data
-				error = QJsonParseError {};  // clear error
-				jDoc = QJsonDocument::fromJson("[" + readData + "]", &error);  // read wrapped as array
-				if (error.error == QJsonParseError::NoError) {
-					parseError.reset();
-					data = jDoc.array().first();
-				}
+	} else if (const auto parser = codecs.parser(contentType); parser) {
+		if (cborDecoder && dynamic_cast<CborContentCodec*>(parser) &&
+			status < 300 && networkReply->error() == QNetworkReply::NoError && !hasDataReceivers()) {
+			// the decoder takes the data directly from the stream, the document is only built if it cannot
+			const auto readData = networkReply->readAll();
+			if (QCborStreamReader decoderReader{readData}; !cborDecoder(decoderReader)) {
+				QCborParserError error;
+				data = QCborValue::fromCbor(readData, &error);
+				if (error.error.c != QCborError::NoError)
+					parseError = std::make_pair(error.error.c, error.errorString());
 			}
-		} else if (jDoc.isObject())
-			data = QJsonValue{jDoc.object()};
-		else if (jDoc.isArray())
-			data = QJsonValue{jDoc.array()};
-		else if (jDoc.isNull())
-			data = QJsonValue{QJsonValue::Null};
-		else
-			Q_UNREACHABLE();
+		} else {
+			auto result = parser->parse(networkReply, contentType);
+			if (const auto error = std::get_if<IReplyParser::ParseError>(&result); error)
+				parseError = std::make_pair(error->code, error->errorString);
+			else
+				data = std::move(std::get<DataType>(result));
+		}
 	} else
 		parseError = std::make_pair(-1, QStringLiteral("Unsupported content type: %1").arg(QString::fromUtf8(contentType)));
 
 	//check "http errors", because they can have data, but only if json is valid
-	if (!parseError && status >= 300 && !std::holds_alternative<std::nullopt_t>(data))  // first: status code error + valid data
+	if (rejected)  // first: requests that were never sent
+		Q_EMIT q->error(networkReply->errorString(), networkReply->error(), Error::CircuitOpen, {});
+	else if (!parseError && status >= 300 && !std::holds_alternative<std::nullopt_t>(data))  // first: status code error + valid data
 		Q_EMIT q->failed(status, data, {});
 	else if (networkReply->error() != QNetworkReply::NoError)  // next: check normal network errors
 		Q_EMIT q->error(networkReply->errorString(), networkReply->error(), Error::Network, {});
@@ -400,26 +798,42 @@ void RestReplyPrivate::run()
 		retryDelay = -1ms;
 	}
 
-	if (retryDelay == 0ms) {
+	// a retry that cannot start before the deadline fails right away
+	if (retryDelay >= 0ms && deadline.remainingTimeAsDuration() <= retryDelay) {
+		reportTimeout();
 		retryDelay = -1ms;
+	}
+
+	if (retryDelay >= 0ms)
+		scheduleRetry(std::exchange(retryDelay, -1ms));
+	else if (autoDelete)
+		QMetaObject::invokeMethod(q, "deleteLater");
+}
+
+void RestReplyPrivate::scheduleRetry(milliseconds delay)
+{
+	Q_Q(RestReply);
+	// retries use up the quota of the server like any other request
+	if (rateLimiter)
+		delay = std::max(delay, rateLimiter->reserve(rateLimiter->bucket(networkReply->request())));
+
+	if (delay == 0ms)
 		QMetaObject::invokeMethod(q, "_q_retryReply");
-	} else if (retryDelay > 0ms) {
+	else {
 		qCDebug(logReply) << "Retrying request in"
-						  << retryDelay.count()
+						  << delay.count()
 						  << "milliseconds";
 		auto sTimer = new QTimer{};
 		sTimer->setSingleShot(true);
 		sTimer->setTimerType(Qt::PreciseTimer);
-		sTimer->setInterval(retryDelay);
+		sTimer->setInterval(delay);
 		sTimer->moveToThread(q->thread());
 		connect(sTimer, &QTimer::timeout,
 				this, &RestReplyPrivate::_q_retryReply);
 		QObject::connect(sTimer, &QTimer::timeout,
 						 sTimer, &QTimer::deleteLater);
-		retryDelay = -1ms;
 		QMetaObject::invokeMethod(sTimer, "start");
-	} else if (autoDelete)
-		QMetaObject::invokeMethod(q, "deleteLater");
+	}
 }
 
 
@@ -12,12 +12,18 @@
 #include <QtCore/QFuture>
 #endif
 
+#include <QtCore/qcborstreamreader.h>
+
 #include <QtNetwork/qnetworkreply.h>
 
 namespace QtRestClient {
 
 class RestReplyPrivate;
 class RestReplyAwaitable;
+class RestClient;
+class RestClassPrivate;
+template <typename DataClassType, typename ErrorClassType>
+class GenericRestReplyBase;
 class QmlGenericRestReply; //needed for QML bindings
 //! A class to handle replies for JSON requests
 class Q_RESTCLIENT_EXPORT RestReply : public QObject
@@ -49,7 +55,9 @@ public:
 		Failure,  //!< Indicates that the server sent a failure for the request
 
 		//extended error types
-		Deserialization  //!< Indicates that deserializing the received data to the target object failed. **Generic replies only!**
+		Deserialization,  //!< Indicates that deserializing the received data to the target object failed. **Generic replies only!**
+		Timeout,  //!< Indicates that the request did not complete before its deadline
+		CircuitOpen  //!< Indicates that the request was not sent, as its circuit in the circuit breaker of the client is open
 	};
 	Q_ENUM(Error)
 
@@ -125,6 +133,8 @@ public:
 
 	//! Returns the network reply associated with the rest reply
 	Q_INVOKABLE QNetworkReply *networkReply() const;
+	//! Returns the headers of the received response, with lower case header names
+	HeaderHash responseHeaders() const;
 
 	//! Returns an awaitable object for this reply
 	RestReplyAwaitable awaitable();
@@ -167,6 +177,8 @@ Q_SIGNALS:
 	void downloadProgress(qint64 bytesReceived, qint64 bytesTotal);
 	//! Forwards QNetworkReply::uploadProgress
 	void uploadProgress(qint64 bytesSent, qint64 bytesTotal);
+	//! Forwards QNetworkReply::metaDataChanged
+	void metaDataChanged();
 
 	//! @notifyAcFn{RestReply::autoDelete}
 	void autoDeleteChanged(bool autoDelete, QPrivateSignal);
@@ -181,10 +193,17 @@ protected:
 	//! @private
 	RestReply(RestReplyPrivate &dd, QObject *parent = nullptr);
 
+	//! Sets a decoder that reads successful CBOR replies directly from the stream, instead of building the data
+	void setCborDecoder(std::function<bool(QCborStreamReader&)> decoder);
+
 private:
 	Q_DECLARE_PRIVATE(RestReply)
+	friend class RestClassPrivate;
+	template <typename DataClassType, typename ErrorClassType>
+	friend class GenericRestReplyBase;
 
 	Qt::ConnectionType callbackType() const;
+	void setupClient(RestClient *client);
 
 	Q_PRIVATE_SLOT(d_func(), void _q_replyFinished())
 	Q_PRIVATE_SLOT(d_func(), void _q_retryReply())
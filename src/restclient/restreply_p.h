@@ -2,9 +2,19 @@
 #define QTRESTCLIENT_RESTREPLY_P_H
 
 #include "restreply.h"
-
+#include "requestbuilder.h"
+#include "contentcodecregistry.h"
+#include "endpointselector_p.h"
+#include "circuitbreaker_p.h"
+#include "replyaccounting_p.h"
+#include "ratelimiter_p.h"
+#include "restclient_p.h"
+
+#include <QtCore/QDeadlineTimer>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QPointer>
 #include <QtCore/QRunnable>
+#include <QtCore/QTimer>
 #ifdef QT_RESTCLIENT_USE_ASYNC
 #include <QtCore/QFutureWatcher>
 #endif
@@ -35,17 +45,33 @@ public:
 	using Error = RestReply::Error;
 
 	static const QByteArray PropertyBuffer;
-
+	static const QByteArray PropertyDevice;
+	// the constructor forwards succeeded to completed
+	static constexpr int ForwardedSignals = 1;
+	static const QNetworkRequest::Attribute DeadlineAttribute;
+	static const QNetworkRequest::Attribute RouteAttribute;
+
+	static QDeadlineTimer requestDeadline(const QNetworkRequest &request);
+	static QString routeKey(const QNetworkRequest &request, bool withRoute);
 	static QNetworkReply *compatSend(QNetworkAccessManager *nam,
 									 const QNetworkRequest &request,
 									 const QByteArray &verb,
-									 const QByteArray &body);
+									 const QByteArray &body,
+									 QIODevice *device = nullptr,
+									 const QSharedPointer<CircuitBreaker> &circuitBreaker = {},
+									 const QSharedPointer<RateLimiter> &rateLimiter = {},
+									 const QString &failure = {});
 #ifdef QT_RESTCLIENT_USE_ASYNC
 	static void compatSendAsync(QFutureInterface<QNetworkReply*> futureIf,
 								QNetworkAccessManager *nam,
 								const QNetworkRequest &request,
 								const QByteArray &verb,
-								const QByteArray &body);
+								const QByteArray &body,
+								QIODevice *device = nullptr,
+								QSharedPointer<CircuitBreaker> circuitBreaker = {},
+								QSharedPointer<RateLimiter> rateLimiter = {},
+								std::chrono::milliseconds delay = std::chrono::milliseconds{0},
+								const QString &failure = {});
 #endif
 
 	QPointer<QNetworkReply> networkReply;
@@ -56,13 +82,52 @@ public:
 	QThreadPool *asyncPool = nullptr;
 #endif
 	std::chrono::milliseconds retryDelay {-1};
+	std::function<bool(QCborStreamReader&)> cborDecoder;
+	ContentCodecRegistry codecs;
+	QSharedPointer<RestClientPrivate::ClientGuard> clientGuard;
+	bool accounted = false;
+	QSharedPointer<RequestBuilder::IExtender> extender;
+	bool intercepted = false;
+	QSharedPointer<EndpointPool> endpoints;
+	int endpoint = -1;
+	QElapsedTimer endpointTimer;
+	std::chrono::milliseconds hedgingDelay {-1};
+	QTimer *hedgeTimer = nullptr;
+	QPointer<QNetworkReply> hedgeReply;
+	int hedgeEndpoint = -1;
+	QElapsedTimer hedgeEndpointTimer;
+	QSharedPointer<CircuitBreaker> circuitBreaker;
+	QString circuit;
+	QElapsedTimer circuitTimer;
+	QString hedgeCircuit;
+	QSharedPointer<RateLimiter> rateLimiter;
+	bool rateLimited = false;
+	int requeues = 0;
+	QDeadlineTimer deadline {QDeadlineTimer::Forever};
+	QTimer *deadlineTimer = nullptr;
+	bool timedOut = false;
 
 	RestReplyPrivate();
 
 	void connectReply();
+	void beginEndpoint();
+	void endEndpoint(EndpointPool::Outcome outcome);
+	void beginCircuit();
+	void endCircuit(CircuitBreaker::Outcome outcome);
+	void beginRateLimit();
+	void startHedging();
+	void cancelHedge();
+	void startDeadline();
+	void reportTimeout();
+	QNetworkReply *resend(bool hedge) const;
+	void scheduleRetry(std::chrono::milliseconds delay);
+	bool hasDataReceivers() const;
 
 	void _q_replyFinished();
 	void _q_retryReply();
+	void _q_sendHedge();
+	void _q_hedgeFinished();
+	void _q_deadlineExpired();
 #ifndef QT_NO_SSL
 	void _q_handleSslErrors(const QList<QSslError> &errors);
 #endif
@@ -25,29 +25,8 @@ RestReplyAwaitable::~RestReplyAwaitable() = default;
 
 void RestReplyAwaitable::prepare(const std::function<void()> &resume)
 {
-	d->reply->onSucceeded(d->reply, [this, resume](RestReply::DataType data){
-		d->errorResult.reset();
-		d->successResult = std::move(data);
-		resume();
-	});
-	d->reply->onFailed(d->reply, [this, resume](int code, const RestReply::DataType &data){
-		d->errorResult.reset(new AwaitedException {
-			code,
-			RestReply::Error::Failure,
-			std::visit(__private::overload {
-						   [](std::nullopt_t) {
-							   return QVariant{};
-						   },
-						   [](auto vData) {
-							   return vData.toVariant();
-						   }
-					   }, data)});
-		resume();
-	});
-	d->reply->onError([this, resume](const QString &errorString, int code, RestReply::Error type) {
-		d->errorResult.reset(new AwaitedException{code, type, errorString});
-		resume();
-	});
+	d->resumeCallback = resume;
+	d->connectReply();
 }
 
 RestReplyAwaitable::type RestReplyAwaitable::result()
@@ -59,6 +38,50 @@ RestReplyAwaitable::type RestReplyAwaitable::result()
 		return d->successResult;
 }
 
+void RestReplyAwaitable::prepareResume(void (*resume)(void *), void *context)
+{
+	d->resumeFn = resume;
+	d->resumeContext = context;
+	d->connectReply();
+}
+
+// ------------- Private Implementation -------------
+
+void RestReplyAwaitablePrivate::connectReply()
+{
+	// only capture this, so none of the handlers needs to allocate
+	reply->onSucceeded(reply, [this](RestReply::DataType data){
+		errorResult.reset();
+		successResult = std::move(data);
+		resume();
+	});
+	reply->onFailed(reply, [this](int code, const RestReply::DataType &data){
+		errorResult.emplace(code,
+							RestReply::Error::Failure,
+							std::visit(__private::overload {
+										   [](std::nullopt_t) {
+											   return QVariant{};
+										   },
+										   [](auto vData) {
+											   return vData.toVariant();
+										   }
+									   }, data));
+		resume();
+	});
+	reply->onError([this](const QString &errorString, int code, RestReply::Error type) {
+		errorResult.emplace(code, type, errorString);
+		resume();
+	});
+}
+
+void RestReplyAwaitablePrivate::resume()
+{
+	if (resumeFn)
+		resumeFn(resumeContext);
+	else
+		resumeCallback();
+}
+
 
 
 AwaitedException::AwaitedException(int code, RestReply::Error type, QVariant data) :
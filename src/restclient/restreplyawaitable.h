@@ -8,6 +8,12 @@
 #include "QtRestClient/genericrestreply.h"
 #endif
 
+#include <optional>
+#include <utility>
+#ifdef QT_RESTCLIENT_USE_COROUTINES
+#include <coroutine>
+#endif
+
 #if defined(DOXYGEN_RUN) || (!defined(QT_NO_EXCEPTIONS) && QT_CONFIG(future))
 #include <QtCore/QException>
 namespace QtRestClient {
@@ -89,10 +95,38 @@ public:
 	//! Extract the result from the awaitable
 	type result();
 
+#ifdef QT_RESTCLIENT_USE_COROUTINES
+	//! Always suspends, as the result is only reported via signals
+	inline bool await_ready() const noexcept {
+		return false;
+	}
+	//! Resumes the coroutine once the reply has finished
+	inline void await_suspend(std::coroutine_handle<> handle) {
+		prepareResume([](void *address) {
+			std::coroutine_handle<>::from_address(address).resume();
+		}, handle.address());
+	}
+	//! @copybrief RestReplyAwaitable::result
+	inline type await_resume() {
+		return result();
+	}
+#endif
+
 private:
 	QScopedPointer<RestReplyAwaitablePrivate> d;
+
+	// independent of the language standard the module was built with
+	void prepareResume(void (*resume)(void*), void *context);
 };
 
+#if defined(DOXYGEN_RUN) || defined(QT_RESTCLIENT_USE_COROUTINES)
+//! Makes a RestReply awaitable in C++20 coroutines
+inline RestReplyAwaitable operator co_await(RestReply &reply)
+{
+	return reply.awaitable();
+}
+#endif
+
 
 
 #ifndef Q_RESTCLIENT_NO_JSON_SERIALIZER
@@ -141,10 +175,28 @@ public:
 	//! Extract the result from the awaitable
 	type result();
 
+#ifdef QT_RESTCLIENT_USE_COROUTINES
+	//! @copybrief RestReplyAwaitable::await_ready
+	inline bool await_ready() const noexcept {
+		return false;
+	}
+	//! @copybrief RestReplyAwaitable::await_suspend
+	inline void await_suspend(std::coroutine_handle<> handle) {
+		connectReply(handle);
+	}
+	//! @copybrief RestReplyAwaitable::result
+	inline type await_resume() {
+		return result();
+	}
+#endif
+
 private:
 	QPointer<GenericRestReply<DataClassType, ErrorClassType>> reply;
 	DataClassType successResult;
-	QScopedPointer<exceptionType> errorResult;
+	std::optional<exceptionType> errorResult;
+
+	template <typename TResume>
+	void connectReply(TResume resume);
 };
 
 //! @copybrief QtRestClient::GenericRestReplyAwaitable
@@ -168,9 +220,27 @@ public:
 	//! @copybrief GenericRestReplyAwaitable::result
 	type result();
 
+#ifdef QT_RESTCLIENT_USE_COROUTINES
+	//! @copybrief RestReplyAwaitable::await_ready
+	inline bool await_ready() const noexcept {
+		return false;
+	}
+	//! @copybrief RestReplyAwaitable::await_suspend
+	inline void await_suspend(std::coroutine_handle<> handle) {
+		connectReply(handle);
+	}
+	//! @copybrief RestReplyAwaitable::result
+	inline type await_resume() {
+		return result();
+	}
+#endif
+
 private:
 	QPointer<GenericRestReply<void, ErrorClassType>> reply;
-	QScopedPointer<exceptionType> errorResult;
+	std::optional<exceptionType> errorResult;
+
+	template <typename TResume>
+	void connectReply(TResume resume);
 };
 #endif
 
@@ -185,38 +255,49 @@ GenericRestReplyAwaitable<DataClassType, ErrorClassType>::GenericRestReplyAwaita
 template<typename DataClassType, typename ErrorClassType>
 GenericRestReplyAwaitable<DataClassType, ErrorClassType>::GenericRestReplyAwaitable(GenericRestReplyAwaitable<DataClassType, ErrorClassType> &&other) noexcept :
 	reply{other.reply},
-	successResult{std::move(other.successResult)}
-{
-	errorResult.swap(other.errorResult);
-}
+	successResult{std::move(other.successResult)},
+	errorResult{std::exchange(other.errorResult, std::nullopt)}
+{}
 
 template<typename DataClassType, typename ErrorClassType>
 GenericRestReplyAwaitable<DataClassType, ErrorClassType> &GenericRestReplyAwaitable<DataClassType, ErrorClassType>::operator=(GenericRestReplyAwaitable<DataClassType, ErrorClassType> &&other) noexcept
 {
 	reply = other.reply;
 	successResult = std::move(other.successResult);
-	errorResult.swap(other.errorResult);
+	// the exceptions are not assignable, so they have to be recreated
+	errorResult.reset();
+	if (other.errorResult)
+		errorResult.emplace(std::move(*other.errorResult));
+	other.errorResult.reset();
 	return *this;
 }
 
 template<typename DataClassType, typename ErrorClassType>
 void GenericRestReplyAwaitable<DataClassType, ErrorClassType>::prepare(const std::function<void ()> &resume)
 {
+	connectReply(resume);
+}
+
+template<typename DataClassType, typename ErrorClassType>
+template<typename TResume>
+void GenericRestReplyAwaitable<DataClassType, ErrorClassType>::connectReply(TResume resume)
+{
+	// a coroutine handle is only a pointer, so none of the handlers needs to allocate
 	reply->onSucceeded([this, resume](int, DataClassType data) {
 		errorResult.reset();
 		successResult = std::move(data);
 		resume();
 	});
 	reply->onFailed([this, resume](int code, ErrorClassType data) {
-		errorResult.reset(new exceptionType{code, std::move(data)});
+		errorResult.emplace(code, std::move(data));
 		resume();
 	});
 	reply->onSerializeException([this, resume](const QtJsonSerializer::Exception &data) {
-		errorResult.reset(new exceptionType{0, RestReply::Error::Deserialization, QString::fromUtf8(data.what())});
+		errorResult.emplace(0, RestReply::Error::Deserialization, QString::fromUtf8(data.what()));
 		resume();
 	});
 	reply->onError([this, resume](const QString &message, int code, RestReply::Error errorType) {
-		errorResult.reset(new exceptionType{code, errorType, message});
+		errorResult.emplace(code, errorType, message);
 		resume();
 	});
 }
@@ -240,36 +321,45 @@ GenericRestReplyAwaitable<void, ErrorClassType>::GenericRestReplyAwaitable(Gener
 
 template<typename ErrorClassType>
 GenericRestReplyAwaitable<void, ErrorClassType>::GenericRestReplyAwaitable(GenericRestReplyAwaitable<void, ErrorClassType> &&other) noexcept :
-	reply{other.reply}
-{
-	errorResult.swap(other.errorResult);
-}
+	reply{other.reply},
+	errorResult{std::exchange(other.errorResult, std::nullopt)}
+{}
 
 template<typename ErrorClassType>
 GenericRestReplyAwaitable<void, ErrorClassType> &GenericRestReplyAwaitable<void, ErrorClassType>::operator=(GenericRestReplyAwaitable<void, ErrorClassType> &&other) noexcept
 {
 	reply = other.reply;
-	errorResult.swap(other.errorResult);
+	errorResult.reset();
+	if (other.errorResult)
+		errorResult.emplace(std::move(*other.errorResult));
+	other.errorResult.reset();
 	return *this;
 }
 
 template<typename ErrorClassType>
 void GenericRestReplyAwaitable<void, ErrorClassType>::prepare(const std::function<void ()> &resume)
+{
+	connectReply(resume);
+}
+
+template<typename ErrorClassType>
+template<typename TResume>
+void GenericRestReplyAwaitable<void, ErrorClassType>::connectReply(TResume resume)
 {
 	reply->onSucceeded([this, resume](int) {
 		errorResult.reset();
 		resume();
 	});
 	reply->onFailed([this, resume](int code, ErrorClassType data) {
-		errorResult.reset(new exceptionType{code, std::move(data)});
+		errorResult.emplace(code, std::move(data));
 		resume();
 	});
 	reply->onSerializeException([this, resume](const QtJsonSerializer::Exception &data) {
-		errorResult.reset(new exceptionType{0, RestReply::Error::Deserialization, QString::fromUtf8(data.what())});
+		errorResult.emplace(0, RestReply::Error::Deserialization, QString::fromUtf8(data.what()));
 		resume();
 	});
 	reply->onError([this, resume](const QString &message, int code, RestReply::Error errorType) {
-		errorResult.reset(new exceptionType{code, errorType, message});
+		errorResult.emplace(code, errorType, message);
 		resume();
 	});
 }
@@ -329,6 +419,14 @@ GenericRestReplyAwaitable<DataClassType, ErrorClassType> GenericRestReplyBase<Da
 {
 	return GenericRestReplyAwaitable<DataClassType, ErrorClassType>{static_cast<TInstance*>(this)};
 }
+
+#ifdef QT_RESTCLIENT_USE_COROUTINES
+template<typename DataClassType, typename ErrorClassType>
+GenericRestReplyAwaitable<DataClassType, ErrorClassType> GenericRestReplyBase<DataClassType, ErrorClassType>::operator co_await()
+{
+	return awaitable();
+}
+#endif
 #endif
 
 }
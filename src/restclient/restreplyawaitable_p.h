@@ -16,7 +16,14 @@ public:
 	QPointer<RestReply> reply{};
 
 	RestReply::DataType successResult = std::nullopt;
-	QScopedPointer<AwaitedException> errorResult{};
+	std::optional<AwaitedException> errorResult;
+
+	std::function<void()> resumeCallback;
+	void (*resumeFn)(void*) = nullptr;
+	void *resumeContext = nullptr;
+
+	void connectReply();
+	void resume();
 };
 
 }
@@ -9,12 +9,15 @@ using namespace QtJsonSerializer;
 
 QVariantMap StandardCborPaging::properties() const
 {
-	return _data.toVariant().toMap();
+	std::call_once(_propertiesFlag, [this]() {
+		_properties = _data.toMap().toVariantMap();
+	});
+	return _properties;
 }
 
 QCborArray StandardCborPaging::cborItems() const
 {
-	return _items;
+	return _data[QStringLiteral("items")].toArray();
 }
 
 QCborValue StandardCborPaging::originalCbor() const
@@ -24,12 +27,15 @@ QCborValue StandardCborPaging::originalCbor() const
 
 QVariantMap StandardJsonPaging::properties() const
 {
-	return _data.toVariant().toMap();
+	std::call_once(_propertiesFlag, [this]() {
+		_properties = _data.toObject().toVariantMap();
+	});
+	return _properties;
 }
 
 QJsonArray StandardJsonPaging::jsonItems() const
 {
-	return _items;
+	return _data[QStringLiteral("items")].toArray();
 }
 
 QJsonValue StandardJsonPaging::originalJson() const
@@ -55,7 +61,8 @@ IPaging *StandardPagingFactory::createPaging(const std::variant<QCborValue, QJso
 								  paging->_next = *url;
 							  if (const auto url = extractUrl(map[QStringLiteral("previous")]); url)
 								  paging->_prev = *url;
-							  paging->_items = map[QStringLiteral("items")].toArray();
+							  paging->_cursor = extractCursor(map[QStringLiteral("cursor")]);
+							  paging->_nextCursor = extractCursor(map[QStringLiteral("nextCursor")]);
 							  paging->_data = value;
 							  return paging;
 						  },
@@ -68,7 +75,8 @@ IPaging *StandardPagingFactory::createPaging(const std::variant<QCborValue, QJso
 								  paging->_next = *url;
 							  if (const auto url = extractUrl(obj[QStringLiteral("previous")]); url)
 								  paging->_prev = *url;
-							  paging->_items = obj[QStringLiteral("items")].toArray();
+							  paging->_cursor = extractCursor(obj[QStringLiteral("cursor")]);
+							  paging->_nextCursor = extractCursor(obj[QStringLiteral("nextCursor")]);
 							  paging->_data = value;
 							  return paging;
 						  }
@@ -96,3 +104,25 @@ std::optional<QUrl> StandardPagingFactory::extractUrl(const std::variant<QCborVa
 						  }
 					  }, value);
 }
+
+QVariant StandardPagingFactory::extractCursor(const std::variant<QCborValue, QJsonValue> &value)
+{
+	return std::visit(__private::overload {
+						  [](const QCborValue &data) -> QVariant {
+							  if (data.isString() && !data.toString().isEmpty())
+								  return data.toString();
+							  else if (data.isInteger())
+								  return data.toInteger();
+							  else
+								  return QVariant{};
+						  },
+						  [](const QJsonValue &data) -> QVariant {
+							  if (data.isString() && !data.toString().isEmpty())
+								  return data.toString();
+							  else if (data.isDouble())
+								  return static_cast<qint64>(data.toDouble());
+							  else
+								  return QVariant{};
+						  }
+					  }, value);
+}
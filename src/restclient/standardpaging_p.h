@@ -6,13 +6,19 @@
 
 #include <optional>
 #include <limits>
+#include <mutex>
+
+#include <QtCore/QCborMap>
+#include <QtCore/QCborValue>
+#include <QtCore/QJsonObject>
+#include <QtCore/QJsonValue>
 
 #include <QtCore/QSharedDataPointer>
 
 namespace QtRestClient {
 
 template <typename TPagingBase>
-class StandardPagingBase : public TPagingBase
+class StandardPagingBase : public TPagingBase, public IPagingCursor
 {
 	static_assert (std::is_base_of_v<IPaging, TPagingBase>, "TPagingBase must inherit or be the IPaging interface");
 	friend class StandardPagingFactory;
@@ -23,12 +29,16 @@ public:
 	QUrl next() const override;
 	bool hasPrevious() const override;
 	QUrl previous() const override;
+	QVariant cursor() const override;
+	QVariant nextCursor() const override;
 
 protected:
 	qint64 _total = std::numeric_limits<qint64>::max();
 	qint64 _offset = -1;
 	QUrl _prev;
 	QUrl _next;
+	QVariant _cursor;
+	QVariant _nextCursor;
 };
 
 class Q_RESTCLIENT_EXPORT StandardCborPaging : public StandardPagingBase<ICborPaging>
@@ -40,8 +50,10 @@ public:
 	QCborValue originalCbor() const override;
 
 private:
-	QCborArray _items;
+	// items are not copied out, but read from the shared original document, which is kept as is
 	QCborValue _data;
+	mutable std::once_flag _propertiesFlag;
+	mutable QVariantMap _properties;
 };
 
 class Q_RESTCLIENT_EXPORT StandardJsonPaging : public StandardPagingBase<IJsonPaging>
@@ -53,8 +65,10 @@ public:
 	QJsonValue originalJson() const override;
 
 private:
-	QJsonArray _items;
+	// items are not copied out, but read from the shared original document, which is kept as is
 	QJsonValue _data;
+	mutable std::once_flag _propertiesFlag;
+	mutable QVariantMap _properties;
 };
 
 class Q_RESTCLIENT_EXPORT StandardPagingFactory : public IPagingFactory
@@ -66,8 +80,8 @@ public:
 	IPaging *createPaging(const std::variant<QCborValue, QJsonValue> &data) const override;
 #endif
 
-private:
 	static std::optional<QUrl> extractUrl(const std::variant<QCborValue, QJsonValue> &value);
+	static QVariant extractCursor(const std::variant<QCborValue, QJsonValue> &value);
 };
 
 // ------------- generic implementation -------------
@@ -87,7 +101,7 @@ qint64 StandardPagingBase<TPagingBase>::offset() const
 template <typename TPagingBase>
 bool StandardPagingBase<TPagingBase>::hasNext() const
 {
-	return _next.isValid();
+	return _next.isValid() || _nextCursor.isValid();
 }
 
 template <typename TPagingBase>
@@ -108,6 +122,18 @@ QUrl StandardPagingBase<TPagingBase>::previous() const
 	return _prev;
 }
 
+template <typename TPagingBase>
+QVariant StandardPagingBase<TPagingBase>::cursor() const
+{
+	return _cursor;
+}
+
+template <typename TPagingBase>
+QVariant StandardPagingBase<TPagingBase>::nextCursor() const
+{
+	return _nextCursor;
+}
+
 }
 
 #endif // QTRESTCLIENT_STANDARDPAGING_P_H
@@ -1,5 +1,9 @@
 #include "authrequestbuilder.h"
 #include <QtCore/QPointer>
+#include <QtCore/QReadWriteLock>
+#include <QtCore/QVector>
+#include <QtNetworkAuth/QOAuth1>
+#include <QtNetworkAuth/QOAuth2AuthorizationCodeFlow>
 using namespace QtRestClient;
 using namespace QtRestClient::Auth;
 
@@ -9,6 +13,13 @@ class AuthExtenderPrivate
 {
 public:
 	QPointer<QAbstractOAuth> oAuth;
+
+	// OAuth2 headers only change with the token, so they are serialized once per token
+	mutable QReadWriteLock lock;
+	QVector<std::pair<QByteArray, QByteArray>> headers;
+	QScopedPointer<QObject> cacheContext;
+
+	void updateHeaders();
 };
 
 Q_LOGGING_CATEGORY(logAuthExtender, "qt.restclientauth.AuthExtender")
@@ -19,22 +30,54 @@ AuthExtender::AuthExtender(QAbstractOAuth *oAuth) :
 	  d{new AuthExtenderPrivate{}}
 {
 	d->oAuth = oAuth;
+	// subclasses may override prepareRequest, so only the plain flow is known to add just these headers
+	if (oAuth && oAuth->metaObject() == &QOAuth2AuthorizationCodeFlow::staticMetaObject) {
+		const auto oAuth2 = static_cast<QAbstractOAuth2*>(oAuth);
+		d->cacheContext.reset(new QObject{});
+		d->updateHeaders();
+		// direct connections, as the extender may be used from any thread
+		QObject::connect(oAuth2, &QAbstractOAuth::tokenChanged,
+						 d->cacheContext.data(), [xd = d.data()]() {
+							 xd->updateHeaders();
+						 }, Qt::DirectConnection);
+		QObject::connect(oAuth2, &QAbstractOAuth2::userAgentChanged,
+						 d->cacheContext.data(), [xd = d.data()]() {
+							 xd->updateHeaders();
+						 }, Qt::DirectConnection);
+	}
 }
 
 AuthExtender::~AuthExtender() = default;
 
 bool AuthExtender::requiresBody() const
 {
-	return true;
+	// only OAuth1 signatures include the body, bearer tokens do not care about it
+	return qobject_cast<QOAuth1*>(d->oAuth.data());
 }
 
 void AuthExtender::extendRequest(QNetworkRequest &request, QByteArray &verb, QByteArray *body) const
 {
-	Q_ASSERT(body);
-	d->oAuth->prepareRequest(&request, verb, *body);
+	if (d->cacheContext) {
+		QReadLocker locker{&d->lock};
+		for (const auto &header : qAsConst(d->headers))
+			request.setRawHeader(header.first, header.second);
+	} else
+		d->oAuth->prepareRequest(&request, verb, body ? *body : QByteArray{});
 	qCDebug(logAuthExtender) << "Added authorization data to request";
 }
 
+void AuthExtenderPrivate::updateHeaders()
+{
+	// same headers as QAbstractOAuth2::prepareRequest creates
+	const auto oAuth2 = static_cast<QAbstractOAuth2*>(oAuth.data());
+	QVector<std::pair<QByteArray, QByteArray>> newHeaders {
+		{QByteArrayLiteral("User-Agent"), oAuth2->userAgent().toUtf8()},
+		{QByteArrayLiteral("Authorization"), QByteArrayLiteral("Bearer ") + oAuth2->token().toUtf8()}
+	};
+	QWriteLocker locker{&lock};
+	headers = std::move(newHeaders);
+}
+
 
 
 AuthRequestBuilder::AuthRequestBuilder(const QUrl &baseUrl, QAbstractOAuth *oAuth, QNetworkAccessManager *nam) :
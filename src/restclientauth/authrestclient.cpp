@@ -1,9 +1,19 @@
 #include "authrestclient.h"
 #include "authrestclient_p.h"
 #include "authrequestbuilder.h"
+#include <algorithm>
+#include <QtRestClient/restclass.h>
 #include <QtRestClient/private/restclient_p.h>
+#include <QtNetworkAuth/QOAuth2AuthorizationCodeFlow>
 using namespace QtRestClient;
 using namespace QtRestClient::Auth;
+using namespace std::chrono_literals;
+
+namespace QtRestClient::Auth {
+
+Q_LOGGING_CATEGORY(logAuthClient, "qt.restclientauth.AuthRestClient")
+
+}
 
 AuthRestClient::AuthRestClient(QAbstractOAuth *oAuth, QObject *parent) :
 	  AuthRestClient{DataMode::Json, oAuth, parent}
@@ -39,8 +49,60 @@ AuthRequestBuilder AuthRestClient::authBuilder() const
 RequestBuilder AuthRestClient::builder() const
 {
 	Q_D(const AuthRestClient);
+	// one extender for all builders, so the authorization header is only created once per token
 	return RestClient::builder()
-		.setExtender(new AuthExtender{d->oAuth});
+		.setExtender(d->extender);
+}
+
+bool AuthRestClient::replayUnauthorized() const
+{
+	Q_D(const AuthRestClient);
+	return d->replayUnauthorized;
+}
+
+std::chrono::seconds AuthRestClient::refreshMargin() const
+{
+	Q_D(const AuthRestClient);
+	return d->refreshMargin;
+}
+
+void AuthRestClient::setRefreshMargin(std::chrono::seconds refreshMargin)
+{
+	Q_D(AuthRestClient);
+	if (d->refreshMargin == refreshMargin)
+		return;
+
+	d->refreshMargin = refreshMargin;
+	d->scheduleRefresh();
+	Q_EMIT refreshMarginChanged(d->refreshMargin, {});
+}
+
+void AuthRestClient::setReplayUnauthorized(bool replayUnauthorized)
+{
+	Q_D(AuthRestClient);
+	if (d->replayUnauthorized.exchange(replayUnauthorized) == replayUnauthorized)
+		return;
+	Q_EMIT replayUnauthorizedChanged(replayUnauthorized, {});
+}
+
+void AuthRestClient::refreshAccessToken()
+{
+	Q_D(AuthRestClient);
+	if (d->refreshing)
+		return;
+
+	const auto flow = qobject_cast<QOAuth2AuthorizationCodeFlow*>(d->oAuth);
+	if (!flow || flow->refreshToken().isEmpty()) {
+		qCWarning(logAuthClient) << "Unable to refresh the access token without a refresh token";
+		d->finishRefresh(false);
+		return;
+	}
+
+	qCDebug(logAuthClient) << "Refreshing access token";
+	d->refreshing = true;
+	// a refresh started by someone else is shared as well
+	if (flow->status() != QAbstractOAuth::Status::RefreshingToken)
+		flow->refreshAccessToken();
 }
 
 AuthRestClient::AuthRestClient(AuthRestClientPrivate &dd, QObject *parent) :
@@ -54,4 +116,114 @@ void AuthRestClient::setupOAuth(QAbstractOAuth *oAuth)
 	d->oAuth->setParent(this);
 	d->nam = oAuth->networkAccessManager();
 	d->nam->setRedirectPolicy(QNetworkRequest::NoLessSafeRedirectPolicy);
+	d->extender.reset(new AuthExtender{oAuth});
+
+	d->refreshTimer = new QTimer{this};
+	d->refreshTimer->setSingleShot(true);
+	QObjectPrivate::connect(d->refreshTimer, &QTimer::timeout,
+							d, &AuthRestClientPrivate::_q_refreshTimeout);
+	QObjectPrivate::connect(oAuth, &QAbstractOAuth::statusChanged,
+							d, &AuthRestClientPrivate::_q_statusChanged);
+	if (const auto oAuth2 = qobject_cast<QAbstractOAuth2*>(oAuth); oAuth2) {
+		connect(oAuth2, &QAbstractOAuth2::expirationAtChanged,
+				this, [d]() {
+					d->scheduleRefresh();
+				});
+		connect(oAuth2, &QAbstractOAuth2::error,
+				this, [d]() {
+					if (d->refreshing)
+						d->finishRefresh(false);
+				});
+	}
+	d->scheduleRefresh();
+}
+
+// ------------- Private Implementation -------------
+
+QSharedPointer<RequestBuilder::IExtender> AuthRestClientPrivate::replyExtender() const
+{
+	return extender;
+}
+
+bool AuthRestClientPrivate::interceptReply(RestReply *reply, QNetworkReply *networkReply)
+{
+	Q_Q(AuthRestClient);
+	// only OAuth2 tokens can be refreshed
+	if (!replayUnauthorized || !qobject_cast<QOAuth2AuthorizationCodeFlow*>(oAuth))
+		return false;
+	if (networkReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 401)
+		return false;
+
+	// replies may be evaluated on a worker thread, but the refresh state belongs to the client thread
+	QMetaObject::invokeMethod(q, [this, xReply = QPointer<RestReply>{reply}, authorization = networkReply->request().rawHeader("Authorization")]() {
+		if (xReply)
+			handleUnauthorized(xReply, authorization);
+	});
+	return true;
+}
+
+void AuthRestClientPrivate::scheduleRefresh()
+{
+	const auto oAuth2 = qobject_cast<QAbstractOAuth2*>(oAuth);
+	if (!oAuth2 || !oAuth2->expirationAt().isValid() || refreshMargin < 0s) {
+		refreshTimer->stop();
+		return;
+	}
+
+	// timers cannot wait longer than ~24 days, so long lived tokens are checked again after a day
+	const std::chrono::milliseconds remaining{QDateTime::currentDateTimeUtc().msecsTo(oAuth2->expirationAt()) - std::chrono::milliseconds{refreshMargin}.count()};
+	refreshTimer->start(std::clamp<std::chrono::milliseconds>(remaining, 0ms, 24h));
+}
+
+void AuthRestClientPrivate::handleUnauthorized(RestReply *reply, const QByteArray &authorization)
+{
+	Q_Q(AuthRestClient);
+	if (!refreshing) {
+		QNetworkRequest request;
+		auto verb = RestClass::GetVerb;
+		extender->extendRequest(request, verb, nullptr);
+		if (request.rawHeader("Authorization") != authorization) {
+			// the token was refreshed after the request was signed, so sending it again is enough
+			qCDebug(logAuthClient) << "Replaying request that was signed with an outdated token";
+			QMetaObject::invokeMethod(reply, "_q_retryReply", Qt::QueuedConnection);
+			return;
+		}
+	}
+
+	pendingReplies.append(reply);
+	q->refreshAccessToken();
+}
+
+void AuthRestClientPrivate::finishRefresh(bool success)
+{
+	Q_Q(AuthRestClient);
+	refreshing = false;
+	qCDebug(logAuthClient) << "Access token refresh finished with success:" << success
+						   << "- replaying" << pendingReplies.size() << "requests";
+
+	// replies are only intercepted once, so without a new token they fail with the original 401
+	const auto replies = std::exchange(pendingReplies, {});
+	for (const auto &reply : replies) {
+		if (reply)
+			QMetaObject::invokeMethod(reply, success ? "_q_retryReply" : "_q_replyFinished", Qt::QueuedConnection);
+	}
+	Q_EMIT q->accessTokenRefreshed(success, {});
+}
+
+void AuthRestClientPrivate::_q_statusChanged(QAbstractOAuth::Status status)
+{
+	if (status == QAbstractOAuth::Status::RefreshingToken)
+		refreshing = true;
+	else if (refreshing)
+		finishRefresh(status == QAbstractOAuth::Status::Granted);
+}
+
+void AuthRestClientPrivate::_q_refreshTimeout()
+{
+	Q_Q(AuthRestClient);
+	const auto oAuth2 = qobject_cast<QAbstractOAuth2*>(oAuth);
+	if (oAuth2 && QDateTime::currentDateTimeUtc().secsTo(oAuth2->expirationAt()) > refreshMargin.count())
+		scheduleRefresh();
+	else
+		q->refreshAccessToken();
 }
@@ -1,6 +1,8 @@
 #ifndef QTRESTCLIENTAUTH_AUTHRESTCLIENT_H
 #define QTRESTCLIENTAUTH_AUTHRESTCLIENT_H
 
+#include <chrono>
+
 #include <QtRestClient/restclient.h>
 
 #include "QtRestClientAuth/qtrestclientauth_global.h"
@@ -14,6 +16,11 @@ class Q_RESTCLIENTAUTH_EXPORT AuthRestClient : public RestClient
 {
 	Q_OBJECT
 
+	//! Specifies, whether requests that failed with 401 are sent again after refreshing the token
+	Q_PROPERTY(bool replayUnauthorized READ replayUnauthorized WRITE setReplayUnauthorized NOTIFY replayUnauthorizedChanged)
+	//! Specifies how long before its expiration the access token is refreshed
+	Q_PROPERTY(std::chrono::seconds refreshMargin READ refreshMargin WRITE setRefreshMargin NOTIFY refreshMarginChanged)
+
 public:
 	//! Constructor with the OAuth instance to use for authenticating requests
 	explicit AuthRestClient(QAbstractOAuth *oAuth, QObject *parent = nullptr);
@@ -31,6 +38,27 @@ public:
 	AuthRequestBuilder authBuilder() const;
 	RequestBuilder builder() const override;
 
+	//! @readAcFn{AuthRestClient::replayUnauthorized}
+	bool replayUnauthorized() const;
+	//! @readAcFn{AuthRestClient::refreshMargin}
+	std::chrono::seconds refreshMargin() const;
+
+public Q_SLOTS:
+	//! @writeAcFn{AuthRestClient::replayUnauthorized}
+	void setReplayUnauthorized(bool replayUnauthorized);
+	//! @writeAcFn{AuthRestClient::refreshMargin}
+	void setRefreshMargin(std::chrono::seconds refreshMargin);
+	//! Refreshes the access token, unless a refresh is already running
+	void refreshAccessToken();
+
+Q_SIGNALS:
+	//! @notifyAcFn{AuthRestClient::replayUnauthorized}
+	void replayUnauthorizedChanged(bool replayUnauthorized, QPrivateSignal);
+	//! @notifyAcFn{AuthRestClient::refreshMargin}
+	void refreshMarginChanged(std::chrono::seconds refreshMargin, QPrivateSignal);
+	//! Is emitted when a refresh of the access token has finished
+	void accessTokenRefreshed(bool success, QPrivateSignal);
+
 protected:
 	//! @private
 	AuthRestClient(AuthRestClientPrivate &dd, QObject *parent);
@@ -3,6 +3,11 @@
 
 #include "authrestclient.h"
 
+#include <atomic>
+
+#include <QtCore/QPointer>
+#include <QtCore/QTimer>
+
 #include <QtRestClient/private/restclient_p.h>
 
 namespace QtRestClient::Auth {
@@ -12,8 +17,29 @@ class AuthRestClientPrivate : public RestClientPrivate
 	Q_DECLARE_PUBLIC(AuthRestClient)
 public:
 	QAbstractOAuth *oAuth = nullptr;
+	QSharedPointer<AuthExtender> extender;
+
+	std::atomic_bool replayUnauthorized = true;
+	std::chrono::seconds refreshMargin {60};
+	QTimer *refreshTimer = nullptr;
+
+	// all replies that failed with 401 while the token is refreshed wait for the same refresh
+	bool refreshing = false;
+	QList<QPointer<RestReply>> pendingReplies;
+
+	QSharedPointer<RequestBuilder::IExtender> replyExtender() const override;
+	bool interceptReply(RestReply *reply, QNetworkReply *networkReply) override;
+
+	void scheduleRefresh();
+	void handleUnauthorized(RestReply *reply, const QByteArray &authorization);
+	void finishRefresh(bool success);
+
+	void _q_statusChanged(QAbstractOAuth::Status status);
+	void _q_refreshTimeout();
 };
 
+Q_DECLARE_LOGGING_CATEGORY(logAuthClient)
+
 }
 
 #endif // QTRESTCLIENTAUTH_AUTHRESTCLIENT_P_H
@@ -4,6 +4,101 @@
 using namespace QtRestClient;
 using namespace QtJsonSerializer;
 
+class RecordingFetcher : public RestClassFetcher
+{
+public:
+	RecordingFetcher(RestClass *restClass, PagingModel *model) :
+		RestClassFetcher{restClass},
+		_model{model}
+	{}
+
+	RestReply *fetch(const QUrl &url) const override {
+		if (rowsOnFirstFetch < 0)
+			rowsOnFirstFetch = _model->rowCount();
+		return RestClassFetcher::fetch(url);
+	}
+
+	mutable int rowsOnFirstFetch = -1;
+
+private:
+	PagingModel *_model;
+};
+
+// a page that announces its headers and finishes only once the test tells it to
+class PendingPageReply : public QNetworkReply
+{
+public:
+	static constexpr int PageSize = 10;
+	static constexpr int PageCount = 4;
+
+	static QUrl pageUrl(int page) {
+		return QUrl{QStringLiteral("http://localhost/pages/%1").arg(page)};
+	}
+
+	PendingPageReply(int page) {
+		setUrl(pageUrl(page));
+		setOperation(QNetworkAccessManager::GetOperation);
+		QJsonArray items;
+		for (auto i = 0; i < PageSize; ++i)
+			items.append(QJsonObject{{QStringLiteral("id"), page * PageSize + i}});
+		const auto hasNext = page + 1 < PageCount;
+		_data = QJsonDocument{QJsonObject{
+			{QStringLiteral("total"), PageSize * PageCount},
+			{QStringLiteral("offset"), page * PageSize},
+			{QStringLiteral("next"), hasNext ? QJsonValue{pageUrl(page + 1).toString()} : QJsonValue{}},
+			{QStringLiteral("items"), items}
+		}}.toJson(QJsonDocument::Compact);
+		setAttribute(QNetworkRequest::HttpStatusCodeAttribute, 200);
+		setHeader(QNetworkRequest::ContentTypeHeader, QByteArray{"application/json"});
+		setHeader(QNetworkRequest::ContentLengthHeader, _data.size());
+		if (hasNext)
+			setRawHeader("Link", "<" + pageUrl(page + 1).toEncoded() + ">; rel=\"next\"");
+		open(QIODevice::ReadOnly);
+	}
+
+	void announce() {
+		Q_EMIT metaDataChanged();
+	}
+
+	void complete() {
+		setFinished(true);
+		Q_EMIT readyRead();
+		Q_EMIT finished();
+	}
+
+	void abort() override {}
+
+	qint64 bytesAvailable() const override {
+		return _data.size() - _pos + QNetworkReply::bytesAvailable();
+	}
+
+protected:
+	qint64 readData(char *data, qint64 maxSize) override {
+		const auto size = std::min<qint64>(maxSize, _data.size() - _pos);
+		memcpy(data, _data.constData() + _pos, static_cast<size_t>(size));
+		_pos += size;
+		return size;
+	}
+
+private:
+	QByteArray _data;
+	qint64 _pos = 0;
+};
+
+class PendingPageFetcher : public RestClassFetcher
+{
+public:
+	using RestClassFetcher::RestClassFetcher;
+
+	RestReply *fetch(const QUrl &url) const override {
+		const auto reply = new PendingPageReply{url.path().section(QLatin1Char('/'), -1).toInt()};
+		replies.append(reply);
+		return new RestReply{reply};
+	}
+
+	mutable QList<PendingPageReply*> replies;
+};
+
 class PagingModelTest : public QObject
 {
 	Q_OBJECT
@@ -15,6 +110,11 @@ private Q_SLOTS:
 	void testInitModel();
 	void testReplyInitModel();
 	void testJsonInitModel();
+	void testHeaderDiscovery();
+	void testBatchedInsertion();
+#ifdef QT_RESTCLIENT_USE_ASYNC
+	void testAsyncInitModel();
+#endif
 
 private:
 	HttpServer *server;
@@ -134,6 +234,85 @@ void PagingModelTest::testJsonInitModel()
 	}
 }
 
+void PagingModelTest::testHeaderDiscovery()
+{
+	model->setHeaderDiscovery(PagingModel::HeaderDiscovery::HeadRequest);
+	QUrl url {QStringLiteral("pages/0")};
+	QVERIFY(url.isValid());
+	const auto headRequests = server->headRequests();
+	auto fetcher = new RecordingFetcher{client->rootClass(), model};
+	model->initialize(url, fetcher, qMetaTypeId<JphPost*>());
+
+	// the first page is only requested after the HEAD request sized the model
+	QTRY_VERIFY(fetcher->rowsOnFirstFetch >= 0);
+	QCOMPARE(server->headRequests(), headRequests + 1);
+	QCOMPARE(fetcher->rowsOnFirstFetch, 100);
+
+	QTRY_COMPARE(model->rowCount(), 100);
+	QTRY_VERIFY(model->object<JphPost*>(model->index(99, 0)));
+	QVERIFY(!model->canFetchMore({}));
+	QCOMPARE(model->rowCount(), 100);
+	for (auto i = 0; i < 100; ++i) {
+		const auto post = model->object<JphPost*>(model->index(i, 0));
+		QVERIFY(post);
+		QCOMPARE(post->id, i);
+	}
+
+	model->setHeaderDiscovery(PagingModel::HeaderDiscovery::Disabled);
+}
+
+void PagingModelTest::testBatchedInsertion()
+{
+	PagingModel pagingModel;
+	pagingModel.setHeaderDiscovery(PagingModel::HeaderDiscovery::ResponseHeaders);
+	auto fetcher = new PendingPageFetcher{client->rootClass()};
+	pagingModel.initialize(PendingPageReply::pageUrl(0), fetcher);
+	QVERIFY(pagingModel.canFetchMore({}));
+	pagingModel.fetchMore({});
+
+	// the link headers chain the requests for all pages before any of them arrived
+	for (auto i = 0; i < PendingPageReply::PageCount; ++i) {
+		QCOMPARE(fetcher->replies.size(), i + 1);
+		fetcher->replies[i]->announce();
+	}
+	QCOMPARE(fetcher->replies.size(), PendingPageReply::PageCount);
+
+	// pages that arrive before the model flushes them are inserted at once
+	QSignalSpy insertSpy{&pagingModel, &QAbstractItemModel::rowsInserted};
+	for (const auto reply : qAsConst(fetcher->replies))
+		reply->complete();
+	QTRY_COMPARE(pagingModel.rowCount(), PendingPageReply::PageSize * PendingPageReply::PageCount);
+	QCOMPARE(insertSpy.size(), 1);
+	QCOMPARE(insertSpy[0][1].toInt(), 0);
+	QCOMPARE(insertSpy[0][2].toInt(), PendingPageReply::PageSize * PendingPageReply::PageCount - 1);
+	QVERIFY(!pagingModel.canFetchMore({}));
+	for (auto i = 0; i < pagingModel.rowCount(); ++i)
+		QCOMPARE(pagingModel.object<QJsonValue>(pagingModel.index(i, 0)).toObject()[QStringLiteral("id")].toInt(), i);
+}
+
+#ifdef QT_RESTCLIENT_USE_ASYNC
+void PagingModelTest::testAsyncInitModel()
+{
+	client->setAsyncPool(QThreadPool::globalInstance());
+	QUrl url {QStringLiteral("pages/0")};
+	QVERIFY(url.isValid());
+	model->initialize<JphPost*>(url, client->rootClass());
+
+	// let the model populate itself from the pool
+	QTRY_COMPARE(model->rowCount(), 100);
+	QVERIFY(!model->canFetchMore({}));
+	for (auto i = 0; i < 100; ++i) {
+		const auto post = model->object<JphPost*>(model->index(i, 0));
+		QVERIFY(post);
+		QCOMPARE(post->thread(), model->thread());
+		QCOMPARE(post->parent(), model);
+		QCOMPARE(post->id, i);
+	}
+
+	client->setAsyncPool(nullptr);
+}
+#endif
+
 QTEST_MAIN(PagingModelTest)
 
 #include "tst_pagingmodel.moc"
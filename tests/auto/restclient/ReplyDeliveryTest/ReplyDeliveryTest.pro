@@ -0,0 +1,14 @@
+TEMPLATE = app
+
+QT += testlib restclient-private
+QT -= gui
+CONFIG += console
+CONFIG -= app_bundle
+
+TARGET = tst_replydelivery
+
+include(../tests.pri)
+
+SOURCES += tst_replydelivery.cpp
+
+DEFINES += SRCDIR=\\\"$$PWD/\\\"
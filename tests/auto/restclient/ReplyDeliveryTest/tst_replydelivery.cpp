@@ -0,0 +1,272 @@
+#include "testlib.h"
+
+#include <jphpost.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+using namespace QtJsonSerializer;
+using namespace QtRestClient;
+
+// this test has its own executable, as it replaces the global allocation functions to count them
+namespace {
+
+std::atomic_bool countAllocations = false;
+std::atomic_int allocationCount = 0;
+
+void *countedAlloc(std::size_t size)
+{
+	if (countAllocations)
+		++allocationCount;
+	return std::malloc(size ? size : 1);
+}
+
+}
+
+void *operator new(std::size_t size)
+{
+	if (const auto ptr = countedAlloc(size); ptr)
+		return ptr;
+	throw std::bad_alloc{};
+}
+
+void *operator new[](std::size_t size)
+{
+	if (const auto ptr = countedAlloc(size); ptr)
+		return ptr;
+	throw std::bad_alloc{};
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+	return countedAlloc(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+	return countedAlloc(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+class ReplyDeliveryTest : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+	void initTestCase();
+	void cleanupTestCase();
+
+	void testCallbackCopies();
+	void benchmarkTypedDispatch();
+	void benchmarkTrivialGet();
+	void benchmarkTrivialGetAllocations();
+	void testBuilderAllocations();
+	void benchmarkBuilder_data();
+	void benchmarkBuilder();
+
+private:
+	HttpServer *server;
+	RestClient *client;
+
+	QNetworkRequest buildRequest(bool cached) const;
+};
+
+void ReplyDeliveryTest::initTestCase()
+{
+	server = new HttpServer(this);
+	QVERIFY(server->setupRoutes());
+	server->setDefaultData();
+	client = Testlib::createClient(this);
+	client->setBaseUrl(server->url());
+}
+
+void ReplyDeliveryTest::cleanupTestCase()
+{
+	client->deleteLater();
+	client = nullptr;
+	server->deleteLater();
+	server = nullptr;
+}
+
+void ReplyDeliveryTest::testCallbackCopies()
+{
+	const QCborArray cborArray {1, 2, 3};
+	const QJsonArray jsonArray {1, 2, 3};
+	const RestReply::DataType cborData = QCborValue{cborArray};
+	const RestReply::DataType jsonData = QJsonValue{jsonArray};
+
+	QCborArray cborResult;
+	QJsonArray jsonResult;
+	auto variantCount = 0;
+	auto tokenValue = 0;
+	auto cborFn = __private::bindCallback([&](int, const QCborArray &value) {
+		cborResult = value;
+	});
+	auto jsonFn = __private::bindCallback([&](const QJsonArray &value) {
+		jsonResult = value;
+	});
+	auto variantFn = __private::bindCallback([&](int, const std::variant<QCborArray, QJsonArray> &value) {
+		if (std::holds_alternative<QCborArray>(value))
+			cborResult = std::get<QCborArray>(value);
+		else
+			jsonResult = std::get<QJsonArray>(value);
+		++variantCount;
+	});
+	auto moveOnlyFn = __private::bindCallback([&, token = std::make_unique<int>(42)](int, QCborValue value) {
+		cborResult = value.toArray();
+		tokenValue = *token;
+	});
+
+	// passing the data through the binders only shares the containers
+	allocationCount = 0;
+	countAllocations = true;
+	cborFn(200, cborData);
+	jsonFn(200, jsonData);
+	variantFn(200, cborData);
+	variantFn(200, jsonData);
+	moveOnlyFn(200, cborData);
+	countAllocations = false;
+
+	QCOMPARE(allocationCount.load(), 0);
+	QCOMPARE(cborResult, cborArray);
+	QCOMPARE(jsonResult, jsonArray);
+	QCOMPARE(variantCount, 2);
+	QCOMPARE(tokenValue, 42);
+}
+
+void ReplyDeliveryTest::benchmarkTypedDispatch()
+{
+	// the part of the delivery path between the reply signal and a typed handler
+	const RestReply::DataType data = QCborValue{QCborArray{1, 2, 3}};
+	auto count = 0;
+	auto handler = __private::bindCallback([&](int, const QCborArray &value) {
+		count += value.size();
+	});
+	QBENCHMARK {
+		handler(200, data);
+	}
+	QVERIFY(count > 0);
+}
+
+void ReplyDeliveryTest::benchmarkTrivialGet()
+{
+	auto rootClass = client->rootClass();
+	QBENCHMARK {
+		auto called = false;
+		rootClass->get<JphPost*>(QStringLiteral("posts/1"))->onSucceeded([&](int, JphPost *post) {
+			called = true;
+			post->deleteLater();
+		});
+		QVERIFY(QTest::qWaitFor([&]() {
+			return called;
+		}));
+	}
+}
+
+void ReplyDeliveryTest::benchmarkTrivialGetAllocations()
+{
+	// reported per reply, from sending the request until the typed handler was called. The numbers
+	// include the in process test server, so they are only meaningful compared between revisions
+	auto rootClass = client->rootClass();
+	constexpr auto Replies = 100;
+	auto allocations = 0;
+	for (auto i = 0; i < Replies; ++i) {
+		auto called = false;
+		allocationCount = 0;
+		countAllocations = true;
+		rootClass->get<JphPost*>(QStringLiteral("posts/1"))->onSucceeded([&](int, JphPost *post) {
+			countAllocations = false;
+			called = true;
+			post->deleteLater();
+		});
+		QVERIFY(QTest::qWaitFor([&]() {
+			return called;
+		}));
+		allocations += allocationCount;
+	}
+	countAllocations = false;
+	QTest::setBenchmarkResult(static_cast<qreal>(allocations) / Replies, QTest::Events);
+}
+
+void ReplyDeliveryTest::testBuilderAllocations()
+{
+	const auto headers = client->globalHeaders();
+	const auto parameters = client->globalParameters();
+	const auto attributes = client->requestAttributes();
+	client->addGlobalHeader("X-Client", "test");
+	client->addGlobalParameter(QStringLiteral("key"), QStringLiteral("value"));
+	client->addRequestAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+	buildRequest(true);  // creates the cached builder
+
+	constexpr auto Requests = 100;
+	int allocations[2] = {0, 0};
+	for (const auto cached : {false, true}) {
+		allocationCount = 0;
+		countAllocations = true;
+		for (auto i = 0; i < Requests; ++i)
+			buildRequest(cached);
+		countAllocations = false;
+		allocations[cached] = allocationCount;
+	}
+	QVERIFY(allocations[true] < allocations[false]);
+	// reported per request with the cached builder, the fresh one is only the baseline
+	QTest::setBenchmarkResult(static_cast<qreal>(allocations[true]) / Requests, QTest::Events);
+
+	client->setGlobalHeaders(headers);
+	client->setGlobalParameters(parameters);
+	client->setRequestAttributes(attributes);
+}
+
+void ReplyDeliveryTest::benchmarkBuilder_data()
+{
+	QTest::addColumn<bool>("cached");
+	QTest::newRow("fresh") << false;
+	QTest::newRow("cached") << true;
+}
+
+void ReplyDeliveryTest::benchmarkBuilder()
+{
+	QFETCH(bool, cached);
+	QBENCHMARK {
+		buildRequest(cached);
+	}
+}
+
+QNetworkRequest ReplyDeliveryTest::buildRequest(bool cached) const
+{
+	// fresh builders are created the way RestClient::builder did before it cached them
+	auto builder = cached ?
+					   client->builder() :
+					   RequestBuilder{client->baseUrl(), client->manager()}
+						   .setVersion(client->apiVersion())
+						   .setAttributes(client->requestAttributes())
+						   .addHeaders(client->globalHeaders())
+						   .addParameters(client->globalParameters())
+						   .setAccept("application/json");
+	return builder.addPath(QStringLiteral("posts"))
+		.addParameter(QStringLiteral("id"), QStringLiteral("1"))
+		.build();
+}
+
+QTEST_MAIN(ReplyDeliveryTest)
+
+#include "tst_replydelivery.moc"
@@ -18,6 +18,8 @@ private Q_SLOTS:
 	void testSending_data();
 	void testSending();
 	void setPostParamsSending();
+	void testDeviceSending_data();
+	void testDeviceSending();
 	void testAsyncSending();
 
 private:
@@ -476,6 +478,83 @@ void RequestBuilderTest::setPostParamsSending()
 	reply->deleteLater();
 }
 
+class BodyExtender : public RequestBuilder::IExtender
+{
+public:
+	BodyExtender(bool needsBody) :
+		needsBody{needsBody}
+	{}
+
+	bool needsBody;
+	mutable std::optional<QByteArray> body;
+
+	bool requiresBody() const override {
+		return needsBody;
+	}
+	void extendRequest(QNetworkRequest &request, QByteArray &verb, QByteArray *body) const override {
+		Q_UNUSED(request)
+		Q_UNUSED(verb)
+		if (body)
+			this->body = *body;
+		else
+			this->body = std::nullopt;
+	}
+};
+
+void RequestBuilderTest::testDeviceSending_data()
+{
+	QTest::addColumn<bool>("requiresBody");
+
+	QTest::newRow("streamed") << false;
+	QTest::newRow("peeked") << true;
+}
+
+void RequestBuilderTest::testDeviceSending()
+{
+	QFETCH(bool, requiresBody);
+
+	QJsonObject object {
+		{QStringLiteral("id"), 1},
+		{QStringLiteral("userId"), 1},
+		{QStringLiteral("title"), QStringLiteral("baum")},
+		{QStringLiteral("body"), 42}
+	};
+	const auto data = QJsonDocument{object}.toJson(QJsonDocument::Compact);
+	QBuffer buffer;
+	buffer.setData(data);
+	QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+	auto extender = new BodyExtender{requiresBody};
+	RequestBuilder builder(server->url("/posts/1"), nam);
+#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
+	builder.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, false);
+#else
+	builder.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
+#endif
+	builder.setExtender(extender);
+	builder.setVerb("PUT");
+	builder.setBody(&buffer, "application/json");
+
+	auto reply = builder.send();
+	// the body is only read for the extender if needed, without moving the device
+	if (requiresBody)
+		QCOMPARE(extender->body, std::optional<QByteArray>{data});
+	else
+		QVERIFY(!extender->body);
+
+	QSignalSpy replySpy(reply, &QNetworkReply::finished);
+	QVERIFY(replySpy.wait());
+	QCOMPARE(reply->error(), QNetworkReply::NoError);
+	QCOMPARE(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt(), 200);
+
+	QJsonParseError e;
+	auto repData = QJsonDocument::fromJson(reply->readAll(), &e).object();
+	QCOMPARE(e.error, QJsonParseError::NoError);
+	QCOMPARE(repData, object);
+
+	reply->deleteLater();
+}
+
 class TestThread : public QThread
 {
 public:
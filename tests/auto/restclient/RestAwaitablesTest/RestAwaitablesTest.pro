@@ -4,6 +4,8 @@ QT += testlib
 QT -= gui
 CONFIG += console
 CONFIG -= app_bundle
+# the library is built as C++17, the native coroutine support is only used by consumers
+CONFIG += c++2a
 
 TARGET = tst_restawaitables
 
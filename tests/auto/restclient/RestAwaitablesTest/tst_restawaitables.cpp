@@ -6,6 +6,64 @@
 using namespace QtRestClient;
 using namespace QtCoroutine;
 
+#ifdef QT_RESTCLIENT_USE_COROUTINES
+namespace {
+
+struct DetachedTask {
+	struct promise_type {
+		DetachedTask get_return_object() { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+	};
+};
+
+struct NativeResult {
+	bool finished = false;
+	RestReply::DataType data = std::nullopt;
+	JphPost *post = nullptr;
+	int errorCode = 0;
+	RestReply::Error errorType = RestReply::Error::Network;
+};
+
+DetachedTask awaitNative(HttpServer *server, RestClient *client, QObject *parent, NativeResult *result)
+{
+	QNetworkRequest request{server->url("/posts/1")};
+	Testlib::setAccept(request, client);
+	result->data = co_await *new RestReply{client->manager()->get(request), parent};
+
+	QNetworkRequest genericRequest{server->url("/posts/1")};
+	Testlib::setAccept(genericRequest, client);
+	result->post = co_await *new GenericRestReply<JphPost*, QString>{client->manager()->get(genericRequest), client, parent};
+
+	try {
+		QNetworkRequest failedRequest{server->url("/posts/34234")};
+		Testlib::setAccept(failedRequest, client);
+		co_await *new GenericRestReply<void, QString>{client->manager()->get(failedRequest), client, parent};
+	} catch (GenericAwaitedException<QString> &e) {
+		result->errorCode = e.errorCode();
+		result->errorType = e.errorType();
+	}
+
+	result->finished = true;
+}
+
+DetachedTask awaitStream(HttpServer *server, RestClient *client, QList<int> *ids, bool *finished)
+{
+	QNetworkRequest request{server->url("/pages/0")};
+	Testlib::setAccept(request, client);
+	PagingStream<JphPost*, QString> stream{new GenericRestReply<Paging<JphPost*>, QString>{client->manager()->get(request), client}, 1};
+	while (const auto post = co_await stream.next()) {
+		ids->append((*post)->id);
+		(*post)->deleteLater();
+	}
+	*finished = true;
+}
+
+}
+#endif
+
 class RestAwaitablesTest : public QObject
 {
 	Q_OBJECT
@@ -22,6 +80,9 @@ private Q_SLOTS:
 	void testGenericVoidRestReplyAwait_data();
 	void testGenericVoidRestReplyAwait();
 
+	void testNativeAwait();
+	void testPagingStreamAwait();
+
 private:
 	HttpServer *server = nullptr;
 	RestClient *client = nullptr;
@@ -275,6 +336,43 @@ void RestAwaitablesTest::testGenericVoidRestReplyAwait()
 	}
 }
 
+void RestAwaitablesTest::testNativeAwait()
+{
+#ifdef QT_RESTCLIENT_USE_COROUTINES
+	client->setDataMode(RestClient::DataMode::Json);
+	NativeResult result;
+	awaitNative(server, client, this, &result);
+	QVERIFY(!result.finished);
+	QTRY_VERIFY(result.finished);
+
+	QVERIFY(std::holds_alternative<QJsonValue>(result.data));
+	QCOMPARE(std::get<QJsonValue>(result.data)[QStringLiteral("id")].toInt(), 1);
+	QVERIFY(JphPost::equals(result.post, JphPost::createDefault(this)));
+	QCOMPARE(result.errorCode, 404);
+	QCOMPARE(result.errorType, RestReply::Error::Failure);
+#else
+	QSKIP("The compiler does not support C++20 coroutines");
+#endif
+}
+
+void RestAwaitablesTest::testPagingStreamAwait()
+{
+#ifdef QT_RESTCLIENT_USE_COROUTINES
+	client->setDataMode(RestClient::DataMode::Json);
+	QList<int> ids;
+	auto finished = false;
+	awaitStream(server, client, &ids, &finished);
+	QVERIFY(!finished);
+	QTRY_VERIFY(finished);
+
+	QCOMPARE(ids.size(), 100);
+	for (auto i = 0; i < ids.size(); ++i)
+		QCOMPARE(ids[i], i);
+#else
+	QSKIP("The compiler does not support C++20 coroutines");
+#endif
+}
+
 QTEST_MAIN(RestAwaitablesTest)
 
 #include "tst_restawaitables.moc"
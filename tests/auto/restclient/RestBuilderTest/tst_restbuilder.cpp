@@ -4,6 +4,8 @@
 #include <api_posts.h>
 #include <test_api.h>
 #include <simplepost.h>
+#include <QtJsonSerializer/JsonSerializer>
+#include <QtJsonSerializer/CborSerializer>
 using namespace TestSpace;
 
 namespace {
@@ -23,6 +25,8 @@ private Q_SLOTS:
 	void cleanupTestCase();
 	void testCustomCompiledObject();
 	void testCustomCompiledGadget();
+	void testGeneratedCodecs();
+	void testGeneratedStreamCodecs();
 	void testCustomCompiledApi();
 	void testCustomCompiledApiPosts();
 
@@ -98,6 +102,104 @@ void RestBuilderTest::testCustomCompiledGadget()
 	QCOMPARE(post2, post);
 }
 
+void RestBuilderTest::testGeneratedCodecs()
+{
+	static_assert(QtRestClient::GeneratedCodec::HasCodec<Post>::value);
+	static_assert(QtRestClient::GeneratedCodec::HasCodec<User*>::value);
+	static_assert(!QtRestClient::GeneratedCodec::HasCodec<QString>::value);
+
+	QtJsonSerializer::JsonSerializer jsonSerializer;
+	const QJsonObject json {
+		{QStringLiteral("id"), 42},
+		{QStringLiteral("title"), QStringLiteral("baum")},
+		{QStringLiteral("body"), QStringLiteral("baum == 42")},
+		{QStringLiteral("user"), QJsonObject {
+			 {QStringLiteral("id"), 7},
+			 {QStringLiteral("name"), QStringLiteral("Tree")}
+		 }}
+	};
+	auto post = Post::fromJson(json, &jsonSerializer);
+	QCOMPARE(post.id(), 42);
+	QCOMPARE(post.title(), QStringLiteral("baum"));
+	QCOMPARE(post.body(), QStringLiteral("baum == 42"));
+	QVERIFY(post.user());
+	QCOMPARE(post.user()->id(), 7);
+	QCOMPARE(post.user()->name(), QStringLiteral("Tree"));
+	QScopedPointer<User> user{post.user()};
+
+	const auto written = post.toJson(&jsonSerializer).toObject();
+	QCOMPARE(written[QStringLiteral("id")].toInt(), 42);
+	QCOMPARE(written[QStringLiteral("title")].toString(), QStringLiteral("baum"));
+	QCOMPARE(written[QStringLiteral("user")].toObject()[QStringLiteral("name")].toString(), QStringLiteral("Tree"));
+	QVERIFY(!written.contains(QStringLiteral("version")));  // not stored
+
+	// must match the reflective serializer
+	const auto generic = jsonSerializer.deserialize<Post>(written);
+	QScopedPointer<User> genericUser{generic.user()};
+	QCOMPARE(generic.id(), post.id());
+	QCOMPARE(generic.title(), post.title());
+	QCOMPARE(generic.body(), post.body());
+	QVERIFY(generic.user()->equals(post.user()));
+
+	QtJsonSerializer::CborSerializer cborSerializer;
+	const auto cborPost = Post::fromCbor(post.toCbor(&cborSerializer), &cborSerializer);
+	QScopedPointer<User> cborUser{cborPost.user()};
+	QCOMPARE(cborPost.id(), post.id());
+	QCOMPARE(cborPost.title(), post.title());
+	QCOMPARE(cborPost.body(), post.body());
+	QVERIFY(cborPost.user()->equals(post.user()));
+}
+
+void RestBuilderTest::testGeneratedStreamCodecs()
+{
+	static_assert(QtRestClient::GeneratedCodec::HasStreamCodec<Post>::value);
+	static_assert(QtRestClient::GeneratedCodec::HasStreamCodec<User*>::value);
+	static_assert(QtRestClient::GeneratedCodec::HasStreamCodec<QList<Post>>::value);
+	static_assert(!QtRestClient::GeneratedCodec::HasStreamCodec<QList<QString>>::value);
+
+	QtJsonSerializer::CborSerializer cborSerializer;
+	const QCborMap cbor {
+		{QStringLiteral("id"), 42},
+		{QStringLiteral("title"), QStringLiteral("baum")},
+		{QStringLiteral("extra"), QCborArray{1, 2, 3}},
+		{QStringLiteral("body"), QStringLiteral("baum == 42")},
+		{QStringLiteral("user"), QCborMap {
+			 {QStringLiteral("id"), 7},
+			 {QStringLiteral("name"), QStringLiteral("Tree")}
+		 }}
+	};
+
+	QCborStreamReader reader{QCborValue{cbor}.toCbor()};
+	auto post = QtRestClient::GeneratedCodec::readStream<Post>(reader, &cborSerializer);
+	QVERIFY(post);
+	QVERIFY(reader.lastError() == QCborError::NoError);
+	QVERIFY(!reader.hasNext());
+	QScopedPointer<User> user{post->user()};
+	const auto domPost = Post::fromCbor(cbor, &cborSerializer);
+	QScopedPointer<User> domUser{domPost.user()};
+	QCOMPARE(post->id(), domPost.id());
+	QCOMPARE(post->title(), domPost.title());
+	QCOMPARE(post->body(), domPost.body());
+	QVERIFY(user);
+	QVERIFY(user->equals(domUser.data()));
+
+	// lists of generated types are streamed as well
+	QCborStreamReader listReader{QCborValue{QCborArray{cbor, cbor}}.toCbor()};
+	auto posts = QtRestClient::GeneratedCodec::readStream<QList<Post>>(listReader, &cborSerializer);
+	QVERIFY(posts);
+	QCOMPARE(posts->size(), 2);
+	QCOMPARE(posts->at(1).title(), domPost.title());
+	for (const auto &lPost : qAsConst(*posts))
+		delete lPost.user();
+
+	// polymorphic objects can only be read by the serializer
+	QCborStreamReader polyReader{QCborValue{QCborMap {
+		{QStringLiteral("@class"), QStringLiteral("User")},
+		{QStringLiteral("id"), 7}
+	}}.toCbor()};
+	QVERIFY(!QtRestClient::GeneratedCodec::readStream<User*>(polyReader, &cborSerializer));
+}
+
 void RestBuilderTest::testCustomCompiledApi()
 {
 	// test eveything is there
@@ -149,6 +251,28 @@ void RestBuilderTest::testCustomCompiledApiPosts()
 	});
 	QTRY_VERIFY(called);
 
+	// plain connections to the signal still receive the document while a typed handler streams the data
+	called = false;
+	QtRestClient::RestReply::DataType plainData = std::nullopt;
+	auto reply4 = api->posts()->post(42);
+	reply4->onSucceeded([&](int code, const Post &post){
+		called = true;
+		QCOMPARE(code, 200);
+		QCOMPARE(post.id(), 42);
+		post.user()->deleteLater();
+	});
+	connect(reply4, &QtRestClient::RestReply::succeeded,
+			this, [&](int, const QtRestClient::RestReply::DataType &data) {
+				plainData = data;
+			});
+	reply4->onAllErrors([&](const QString &error, int, QtRestClient::RestReply::Error){
+		called = true;
+		QFAIL(qUtf8Printable(error));
+	});
+	QTRY_VERIFY(called);
+	QTRY_VERIFY(std::holds_alternative<QCborValue>(plainData));
+	QCOMPARE(std::get<QCborValue>(plainData)[QStringLiteral("id")].toInteger(), 42);
+
 	QCoreApplication::processEvents();
 	called = false;
 	QSignalSpy errorSpy(api->posts(), &PostClass::apiError);
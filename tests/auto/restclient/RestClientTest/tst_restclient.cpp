@@ -1,4 +1,68 @@
 #include "testlib.h"
+#include <QtRestClient/private/restclient_p.h>
+
+#include <QtCore/QBuffer>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTemporaryDir>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+using namespace std::chrono_literals;
+
+Q_DECLARE_METATYPE(QtRestClient::RateLimiterSettings::ResetFormat)
+
+// a finished reply that carries a TLS session ticket
+class TicketReply : public QNetworkReply
+{
+public:
+	TicketReply(const QUrl &url, QByteArray ticket) :
+		_ticket{std::move(ticket)}
+	{
+		setUrl(url);
+		setFinished(true);
+	}
+
+	void abort() override {}
+
+protected:
+	qint64 readData(char *, qint64) override {
+		return -1;
+	}
+
+	void sslConfigurationImplementation(QSslConfiguration &config) const override {
+		config.setSessionTicket(_ticket);
+	}
+
+private:
+	QByteArray _ticket;
+};
+
+// a finished reply with the given status code and headers
+class HeaderReply : public QNetworkReply
+{
+public:
+	HeaderReply(int status, const QList<std::pair<QByteArray, QByteArray>> &headers) {
+		setAttribute(QNetworkRequest::HttpStatusCodeAttribute, status);
+		for (const auto &header : headers)
+			setRawHeader(header.first, header.second);
+		setFinished(true);
+	}
+
+	void abort() override {}
+
+protected:
+	qint64 readData(char *, qint64) override {
+		return -1;
+	}
+};
+
+// always prefers the first of the candidates
+class FirstSelector : public QtRestClient::IEndpointSelector
+{
+public:
+	int select(const QVector<QtRestClient::EndpointInfo> &, const QUrl &) override {
+		return 0;
+	}
+};
 
 class RestClientTest : public QObject
 {
@@ -7,6 +71,34 @@ class RestClientTest : public QObject
 private Q_SLOTS:
 	void testBaseUrl_data();
 	void testBaseUrl();
+	void testBuilderInvalidation();
+	void testContentCodecs_data();
+	void testContentCodecs();
+	void testAcceptNegotiation();
+	void testWarmUp();
+	void testSessionTickets();
+	void testSessionTicketFile();
+	void testEndpoints();
+	void testEndpointSelectors();
+	void testHedging();
+	void testAdaptiveHedging();
+	void testTimeout();
+	void testCircuitBreaker();
+	void testRateLimiter();
+	void testRateLimiterHeaders_data();
+	void testRateLimiterHeaders();
+
+private:
+	struct Result {
+		int status = 0;
+		QUrl url;
+		std::optional<QtRestClient::RestReply::Error> error;
+	};
+
+	// sends a GET request and waits for it to complete or fail. Check QTest::currentTestFailed afterwards
+	Result get(QtRestClient::RestClass *restClass, const QString &path);
+	// accepts connections, but never replies. Check QTest::currentTestFailed afterwards
+	QUrl listenStuck(QTcpServer &stuckServer);
 };
 
 void RestClientTest::testBaseUrl_data()
@@ -64,6 +156,822 @@ void RestClientTest::testBaseUrl()
 	QCOMPARE(request.sslConfiguration(), sslConfig);
 }
 
+void RestClientTest::testBuilderInvalidation()
+{
+	QtRestClient::RestClient client;
+	client.setBaseUrl(QUrl{QStringLiteral("https://api.example.com/basic")});
+	QCOMPARE(client.builder().build().url(), QUrl{QStringLiteral("https://api.example.com/basic")});
+
+	// modifying a copy must not change the cached builder
+	client.builder().addPath(QStringLiteral("sub")).addHeader("X-Test", "tree");
+	auto request = client.builder().build();
+	QCOMPARE(request.url(), QUrl{QStringLiteral("https://api.example.com/basic")});
+	QVERIFY(!request.hasRawHeader("X-Test"));
+
+	// every setter must reset the cached builder
+	client.setBaseUrl(QUrl{QStringLiteral("https://api.example.org/")});
+	client.setApiVersion(QVersionNumber{2});
+	client.addGlobalParameter(QStringLiteral("p"), QStringLiteral("1"));
+	client.addGlobalHeader("X-Global", "baum");
+	client.addRequestAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+	request = client.builder().build();
+	QCOMPARE(request.url(), QUrl{QStringLiteral("https://api.example.org/v2?p=1")});
+	QCOMPARE(request.rawHeader("X-Global"), QByteArray{"baum"});
+	QCOMPARE(request.attribute(QNetworkRequest::CacheLoadControlAttribute), QVariant{QNetworkRequest::AlwaysNetwork});
+	QCOMPARE(request.rawHeader("Accept"), QByteArray{"application/json"});
+
+	client.removeGlobalHeader("X-Global");
+	client.removeGlobalParameter(QStringLiteral("p"));
+	client.setDataMode(QtRestClient::RestClient::DataMode::Cbor);
+	request = client.builder().build();
+	QCOMPARE(request.url(), QUrl{QStringLiteral("https://api.example.org/v2")});
+	QVERIFY(!request.hasRawHeader("X-Global"));
+	QCOMPARE(request.rawHeader("Accept"), QByteArray{"application/cbor"});
+}
+
+void RestClientTest::testContentCodecs_data()
+{
+	QTest::addColumn<QByteArray>("contentType");
+	QTest::addColumn<QCborValue>("value");
+	QTest::addColumn<QByteArray>("encoded");
+
+	const QCborValue mixed{QCborMap{
+		{QStringLiteral("id"), 300},
+		{QStringLiteral("neg"), -200},
+		{QStringLiteral("big"), Q_INT64_C(5000000000)},
+		{QStringLiteral("pi"), 3.5},
+		{QStringLiteral("ok"), true},
+		{QStringLiteral("none"), QCborValue{QCborValue::Null}},
+		{QStringLiteral("list"), QCborArray{1, QStringLiteral("two"), QByteArray{"\x03"}}},
+		{QStringLiteral("time"), QCborValue{QDateTime::fromMSecsSinceEpoch(Q_INT64_C(1600000000123), Qt::UTC)}}
+	}};
+
+	QTest::newRow("json") << QByteArray{"application/json"}
+						  << QCborValue{QCborMap{{QStringLiteral("id"), 42}}}
+						  << QByteArray{"{\"id\":42}"};
+	QTest::newRow("cbor") << QByteArray{"application/cbor"}
+						  << mixed
+						  << mixed.toCbor();
+	QTest::newRow("msgpack.int") << QByteArray{"application/msgpack"}
+								 << QCborValue{-33}
+								 << QByteArray{"\xd0\xdf"};
+	QTest::newRow("msgpack.map") << QByteArray{"application/x-msgpack"}
+								 << QCborValue{QCborMap{{QStringLiteral("a"), 1}}}
+								 << QByteArray{"\x81\xa1" "a" "\x01"};
+	QTest::newRow("msgpack.mixed") << QByteArray{"application/vnd.msgpack"}
+								   << mixed
+								   << QByteArray{};
+	QTest::newRow("delimited") << QByteArray{"application/x-protobuf-delimited"}
+							   << QCborValue{QCborArray{QByteArray{"\x08\x01"}, QByteArray(200, 'x')}}
+							   << QByteArray{"\x02\x08\x01\xc8\x01"} + QByteArray(200, 'x');
+}
+
+void RestClientTest::testContentCodecs()
+{
+	QFETCH(QByteArray, contentType);
+	QFETCH(QCborValue, value);
+	QFETCH(QByteArray, encoded);
+
+	QtRestClient::RestClient client;
+	const auto registry = client.codecRegistry();
+	QVERIFY(registry.contentTypes().contains(contentType));
+	const auto codec = registry.codec(contentType);
+	QVERIFY(codec);
+	QCOMPARE(client.replyParser(contentType), static_cast<QtRestClient::IReplyParser*>(codec));
+
+	const auto data = registry.encode(value, contentType);
+	QVERIFY(data);
+	if (!encoded.isEmpty())
+		QCOMPARE(*data, encoded);
+
+	auto buffer = *data;
+	QBuffer device{&buffer};
+	QVERIFY(device.open(QIODevice::ReadOnly));
+	auto result = codec->parse(&device, contentType);
+	const auto parsed = std::get_if<QtRestClient::IReplyParser::DataType>(&result);
+	QVERIFY(parsed);
+	if (const auto cValue = std::get_if<QCborValue>(parsed); cValue)
+		QCOMPARE(*cValue, value);
+	else
+		QCOMPARE(std::get<QJsonValue>(*parsed), value.toJsonValue());
+}
+
+void RestClientTest::testAcceptNegotiation()
+{
+	using QtRestClient::ContentCodecRegistry;
+
+	QtRestClient::RestClient client;
+	QCOMPARE(client.builder().build().rawHeader("Accept"), QByteArray{"application/json"});
+
+	client.setCodecRegistry(client.codecRegistry()
+								.setQuality("application/msgpack", 0.9)
+								.setQuality("application/x-protobuf-delimited", 0.25)
+								.setQuality("application/cbor", 0.5)
+								.setQuality("application/unknown", 1.0));
+	const QByteArray accept{"application/json, application/msgpack;q=0.9, application/cbor;q=0.5, application/x-protobuf-delimited;q=0.25"};
+	QCOMPARE(client.builder().build().rawHeader("Accept"), accept);
+	QCOMPARE(ContentCodecRegistry::parseAcceptHeader(accept), (QByteArrayList{
+		"application/json",
+		"application/msgpack",
+		"application/cbor",
+		"application/x-protobuf-delimited"
+	}));
+	QCOMPARE(ContentCodecRegistry::parseAcceptHeader("text/plain;q=0, application/cbor;q=0.2, */*;q=0.1, application/json"), (QByteArrayList{
+		"application/json",
+		"application/cbor",
+		"*/*"
+	}));
+
+	// the data mode type is always preferred
+	client.setDataMode(QtRestClient::RestClient::DataMode::Cbor);
+	QCOMPARE(client.builder().build().rawHeader("Accept"),
+			 QByteArray{"application/cbor, application/msgpack;q=0.9, application/x-protobuf-delimited;q=0.25"});
+
+	// default registries are not affected
+	QCOMPARE(ContentCodecRegistry{}.acceptHeader("application/json"), QByteArray{"application/json"});
+
+	// invalid data is reported as parser error
+	const auto codec = ContentCodecRegistry{}.codec("application/msgpack");
+	QVERIFY(codec);
+	for (const auto &invalid : {QByteArray{"\xc1"}, QByteArray{"\x92\x01"}, QByteArray{"\xd4\x05\x01"}, QByteArray{"\x01\x02"}}) {
+		auto buffer = invalid;
+		QBuffer device{&buffer};
+		QVERIFY(device.open(QIODevice::ReadOnly));
+		const auto result = codec->parse(&device, "application/msgpack");
+		QVERIFY(std::holds_alternative<QtRestClient::IReplyParser::ParseError>(result));
+	}
+	QVERIFY(!ContentCodecRegistry{}.encode(QCborValue{QStringLiteral("text")}, "application/x-protobuf-delimited"));
+}
+
+void RestClientTest::testWarmUp()
+{
+	QTcpServer server;
+	QVERIFY(server.listen(QHostAddress::LocalHost));
+	auto connections = 0;
+	connect(&server, &QTcpServer::newConnection, &server, [&]() {
+		while (server.hasPendingConnections()) {
+			server.nextPendingConnection()->setParent(&server);
+			++connections;
+		}
+	});
+
+	QtRestClient::RestClient client;
+	QSignalSpy warmUpSpy{&client, &QtRestClient::RestClient::autoWarmUpChanged};
+	client.setAutoWarmUp(1);
+	QCOMPARE(client.autoWarmUp(), 1);
+	QCOMPARE(warmUpSpy.size(), 1);
+
+	// changing the base URL connects without sending a request
+	QUrl url;
+	url.setScheme(QStringLiteral("http"));
+	url.setHost(QStringLiteral("127.0.0.1"));
+	url.setPort(server.serverPort());
+	client.setBaseUrl(url);
+	QTRY_VERIFY(connections > 0);
+
+	// without auto warm up, changing the base URL does not connect
+	client.setAutoWarmUp(0);
+	client.setBaseUrl(QUrl{});
+	const auto previous = connections;
+	client.setBaseUrl(url);
+	QTest::qWait(100);
+	QCOMPARE(connections, previous);
+}
+
+void RestClientTest::testSessionTickets()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const auto ticketFile = dir.filePath(QStringLiteral("tickets.cbor"));
+	{
+		const auto now = QDateTime::currentDateTimeUtc();
+		QFile file{ticketFile};
+		QVERIFY(file.open(QIODevice::WriteOnly));
+		file.write(QCborMap {
+			{QStringLiteral("api.example.com:443"), QCborMap {
+				{QStringLiteral("ticket"), QByteArray{"ticket"}},
+				{QStringLiteral("expiresAt"), QCborValue{now.addSecs(3600)}}
+			}},
+			{QStringLiteral("api.example.org:443"), QCborMap {
+				{QStringLiteral("ticket"), QByteArray{"expired"}},
+				{QStringLiteral("expiresAt"), QCborValue{now.addSecs(-60)}}
+			}}
+		}.toCborValue().toCbor());
+	}
+
+	QtRestClient::RestClient client;
+	client.setBaseUrl(QUrl{QStringLiteral("https://api.example.com/")});
+	client.setSessionTicketFile(ticketFile);
+	auto config = client.builder().build().sslConfiguration();
+	QVERIFY(config.sessionTicket().isEmpty());
+	QVERIFY(config.testSslOption(QSsl::SslOptionDisableSessionPersistence));
+
+	// loaded tickets are only used with session resumption
+	client.setSessionResumption(true);
+	config = client.builder().build().sslConfiguration();
+	QCOMPARE(config.sessionTicket(), QByteArray{"ticket"});
+	QVERIFY(!config.testSslOption(QSsl::SslOptionDisableSessionPersistence));
+	QVERIFY(client.sslConfiguration().testSslOption(QSsl::SslOptionDisableSessionPersistence));
+
+	// new tickets only replace the one of the builder if it has none
+	const auto d = static_cast<QtRestClient::RestClientPrivate*>(QObjectPrivate::get(&client));
+	TicketReply renewedReply{QUrl{QStringLiteral("https://api.example.com/posts")}, "renewed"};
+	d->storeSessionTicket(&renewedReply);
+	QCOMPARE(client.builder().build().sslConfiguration().sessionTicket(), QByteArray{"ticket"});
+
+	// expired tickets are dropped when loading
+	client.setBaseUrl(QUrl{QStringLiteral("https://api.example.org/")});
+	QVERIFY(client.builder().build().sslConfiguration().sessionTicket().isEmpty());
+	TicketReply newReply{QUrl{QStringLiteral("https://api.example.org/posts")}, "new"};
+	d->storeSessionTicket(&newReply);
+	QCOMPARE(client.builder().build().sslConfiguration().sessionTicket(), QByteArray{"new"});
+}
+
+void RestClientTest::testSessionTicketFile()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const auto ticketFile = dir.filePath(QStringLiteral("tickets.cbor"));
+	const auto readTickets = [&]() {
+		QFile file{ticketFile};
+		if (!file.open(QIODevice::ReadOnly))
+			return QCborMap{};
+		return QCborValue::fromCbor(file.readAll()).toMap();
+	};
+
+	{
+		QtRestClient::RestClient client;
+		client.setSessionResumption(true);
+		client.setSessionTicketFile(ticketFile);
+		const auto d = static_cast<QtRestClient::RestClientPrivate*>(QObjectPrivate::get(&client));
+
+		// tickets are captured from replies, but written later on the client's thread
+		TicketReply reply1{QUrl{QStringLiteral("https://api.example.com/posts")}, "ticket1"};
+		TicketReply reply2{QUrl{QStringLiteral("https://api.example.org:4433/posts")}, "ticket2"};
+		d->storeSessionTicket(&reply1);
+		d->storeSessionTicket(&reply2);
+		QVERIFY(!QFile::exists(ticketFile));
+
+		QTRY_VERIFY_WITH_TIMEOUT(QFile::exists(ticketFile), 5000);
+		const auto tickets = readTickets();
+		QCOMPARE(tickets.size(), 2);
+		QCOMPARE(tickets[QStringLiteral("api.example.com:443")].toMap()[QStringLiteral("ticket")].toByteArray(),
+				 QByteArray{"ticket1"});
+		QCOMPARE(tickets[QStringLiteral("api.example.org:4433")].toMap()[QStringLiteral("ticket")].toByteArray(),
+				 QByteArray{"ticket2"});
+		QVERIFY(tickets[QStringLiteral("api.example.com:443")].toMap()[QStringLiteral("expiresAt")].toDateTime() >
+				QDateTime::currentDateTimeUtc());
+		const auto permissions = QFile::permissions(ticketFile);
+		QVERIFY(permissions.testFlag(QFileDevice::ReadOwner));
+		QVERIFY(permissions.testFlag(QFileDevice::WriteOwner));
+		QVERIFY(!(permissions & (QFileDevice::ReadGroup | QFileDevice::ReadOther)));
+
+		// a pending write is flushed when the client is destroyed
+		TicketReply reply3{QUrl{QStringLiteral("https://api.example.com/posts")}, "ticket3"};
+		d->storeSessionTicket(&reply3);
+		QCoreApplication::processEvents();
+	}
+	const auto tickets = readTickets();
+	QCOMPARE(tickets[QStringLiteral("api.example.com:443")].toMap()[QStringLiteral("ticket")].toByteArray(),
+			 QByteArray{"ticket3"});
+}
+
+void RestClientTest::testEndpoints()
+{
+	HttpServer server1;
+	QVERIFY(server1.setupRoutes());
+	server1.setDefaultData();
+	HttpServer server2;
+	QVERIFY(server2.setupRoutes());
+	server2.setDefaultData();
+	quint16 deadPort;
+	{
+		QTcpServer deadServer;
+		QVERIFY(deadServer.listen(QHostAddress::LocalHost));
+		deadPort = deadServer.serverPort();
+	}
+	auto deadUrl = server1.url();
+	deadUrl.setPort(deadPort);
+
+	QtRestClient::RestClient client;
+	client.setEndpoints({server1.url(), server2.url(), deadUrl});
+	QCOMPARE(client.baseUrl(), server1.url());
+	// building does not choose an endpoint, only sending does
+	QCOMPARE(client.builder().addPath(QStringLiteral("posts")).build().url(), server1.url(QStringLiteral("/posts")));
+
+	const auto path = QStringLiteral("posts/1");
+
+	// round robin, until the dead endpoint is ejected after three failed replies
+	const QList<int> expected {server1.port(), server2.port(), deadPort};
+	for (auto i = 0; i < 9; ++i) {
+		const auto result = get(client.rootClass(), path);
+		if (QTest::currentTestFailed())
+			return;
+		QCOMPARE(result.url.port(), expected[i % 3]);
+	}
+	QList<int> healthy;
+	for (auto i = 0; i < 4; ++i) {
+		const auto result = get(client.rootClass(), path);
+		if (QTest::currentTestFailed())
+			return;
+		QCOMPARE(result.status, 200);
+		healthy.append(result.url.port());
+	}
+	QCOMPARE(healthy.count(server1.port()), 2);
+	QCOMPARE(healthy.count(server2.port()), 2);
+
+	// consistent hashing sends a path to the same endpoint every time
+	client.setEndpointSelector(QtRestClient::IEndpointSelector::create(QtRestClient::IEndpointSelector::Strategy::ConsistentHash));
+	client.setEndpoints({server1.url(), server2.url()});
+	const auto first = get(client.rootClass(), path);
+	if (QTest::currentTestFailed())
+		return;
+	for (auto i = 0; i < 3; ++i) {
+		const auto result = get(client.rootClass(), path);
+		if (QTest::currentTestFailed())
+			return;
+		QCOMPARE(result.url.port(), first.url.port());
+	}
+}
+
+void RestClientTest::testEndpointSelectors()
+{
+	using QtRestClient::EndpointInfo;
+	using QtRestClient::IEndpointSelector;
+	const auto endpoint = [](int port, int outstanding, std::optional<std::chrono::milliseconds> latency = std::nullopt) {
+		EndpointInfo info;
+		info.url = QUrl{QStringLiteral("http://localhost:%1/").arg(port)};
+		info.outstanding = outstanding;
+		info.latency = latency;
+		return info;
+	};
+	const QUrl url{QStringLiteral("http://localhost:1/posts")};
+
+	// the endpoint with the fewest pending replies, ties are used in turn
+	QScopedPointer<IEndpointSelector> selector{IEndpointSelector::create(IEndpointSelector::Strategy::LeastOutstanding)};
+	QCOMPARE(selector->select({endpoint(1, 3), endpoint(2, 1), endpoint(3, 2)}, url), 1);
+	QCOMPARE(selector->select({endpoint(1, 0), endpoint(2, 5)}, url), 0);
+	QSet<int> ties;
+	for (auto i = 0; i < 4; ++i)
+		ties.insert(selector->select({endpoint(1, 1), endpoint(2, 1), endpoint(3, 4)}, url));
+	QCOMPARE(ties, (QSet<int>{0, 1}));
+
+	// the lowest latency, weighted by the pending replies
+	selector.reset(IEndpointSelector::create(IEndpointSelector::Strategy::LowestLatency));
+	QCOMPARE(selector->select({endpoint(1, 0, 50ms), endpoint(2, 0, 20ms), endpoint(3, 0, 30ms)}, url), 1);
+	QCOMPARE(selector->select({endpoint(1, 0, 50ms), endpoint(2, 4, 20ms)}, url), 0);
+	// endpoints without a measurement are tried first, an instant one is a measurement too
+	QCOMPARE(selector->select({endpoint(1, 0, 10ms), endpoint(2, 0)}, url), 1);
+	QCOMPARE(selector->select({endpoint(1, 0, 0ms), endpoint(2, 0, 10ms)}, url), 0);
+	QCOMPARE(selector->select({endpoint(1, 5, 0ms), endpoint(2, 0, 1ms)}, url), 1);
+}
+
+void RestClientTest::testHedging()
+{
+	QTcpServer stuckServer;
+	const auto stuckUrl = listenStuck(stuckServer);
+	if (QTest::currentTestFailed())
+		return;
+	HttpServer server;
+	QVERIFY(server.setupRoutes());
+	server.setDefaultData();
+
+	QtRestClient::RestClient client;
+	client.setEndpoints({stuckUrl, server.url()});
+	QSignalSpy delaySpy{&client, &QtRestClient::RestClient::hedgingDelayChanged};
+	client.setHedgingDelay(100ms);
+	QCOMPARE(client.hedgingDelay(), 100ms);
+	QCOMPARE(delaySpy.size(), 1);
+
+	auto succeeded = 0;
+	auto failed = false;
+	auto reply = client.rootClass()->callRaw(QtRestClient::RestClass::GetVerb, QStringLiteral("posts/1"));
+	reply->setAutoDelete(false);
+	connect(reply, &QtRestClient::RestReply::succeeded, this, [&](int code) {
+		++succeeded;
+		QCOMPARE(code, 200);
+	});
+	connect(reply, &QtRestClient::RestReply::error, this, [&]() {
+		failed = true;
+	});
+	QTRY_COMPARE(succeeded, 1);
+	QCOMPARE(reply->networkReply()->url().port(), static_cast<int>(server.port()));
+	QTest::qWait(100);
+	QCOMPARE(succeeded, 1);
+	QVERIFY(!failed);
+	reply->deleteLater();
+}
+
+void RestClientTest::testAdaptiveHedging()
+{
+	QTcpServer stuckServer;
+	const auto stuckUrl = listenStuck(stuckServer);
+	if (QTest::currentTestFailed())
+		return;
+	HttpServer server;
+	QVERIFY(server.setupRoutes());
+	server.setDefaultData();
+
+	// the first request always goes to the stuck endpoint, the hedge to the other one
+	QtRestClient::RestClient client;
+	client.setEndpointSelector(new FirstSelector{});
+	client.setEndpoints({stuckUrl, server.url()});
+	client.setHedgingDelay(0ms);
+
+	// without latency measurements, there is no percentile and no hedge
+	auto reply = client.rootClass()->callRaw(QtRestClient::RestClass::GetVerb, QStringLiteral("posts/1"));
+	QSignalSpy unmeasuredSpy{reply, &QtRestClient::RestReply::succeeded};
+	QTest::qWait(300);
+	QCOMPARE(unmeasuredSpy.size(), 0);
+	reply->abort();
+
+	// seed the stuck endpoint with latencies, so the 95th percentile is 300ms
+	const auto d = static_cast<QtRestClient::RestClientPrivate*>(QObjectPrivate::get(&client));
+	for (auto i = 0; i < QtRestClient::EndpointPool::LatencySamples; ++i) {
+		d->endpointPool->begin(0);
+		d->endpointPool->end(0, QtRestClient::EndpointPool::Outcome::Success, i < 90 ? 100ms : 300ms);
+	}
+	QCOMPARE(d->endpointPool->latencyPercentile(0, 0.95), std::optional{300ms});
+
+	// the hedge is only sent once the percentile has passed
+	QElapsedTimer timer;
+	timer.start();
+	reply = client.rootClass()->callRaw(QtRestClient::RestClass::GetVerb, QStringLiteral("posts/1"));
+	reply->setAutoDelete(false);
+	QSignalSpy succeededSpy{reply, &QtRestClient::RestReply::succeeded};
+	QTest::qWait(150);
+	QCOMPARE(succeededSpy.size(), 0);
+	QTRY_COMPARE(succeededSpy.size(), 1);
+	// coarse timers may fire up to 5% early
+	QVERIFY2(timer.elapsed() >= 280, qUtf8Printable(QString::number(timer.elapsed())));
+	QCOMPARE(reply->networkReply()->url().port(), static_cast<int>(server.port()));
+	reply->deleteLater();
+}
+
+void RestClientTest::testTimeout()
+{
+	QTcpServer stuckServer;
+	const auto stuckUrl = listenStuck(stuckServer);
+	if (QTest::currentTestFailed())
+		return;
+	HttpServer server;
+	QVERIFY(server.setupRoutes());
+	server.setDefaultData();
+
+	QtRestClient::RestClient client;
+	client.setBaseUrl(stuckUrl);
+	QSignalSpy timeoutSpy{&client, &QtRestClient::RestClient::defaultTimeoutChanged};
+	client.setDefaultTimeout(200ms);
+	QCOMPARE(client.defaultTimeout(), 200ms);
+	QCOMPARE(timeoutSpy.size(), 1);
+
+	// stuck requests are aborted
+	QElapsedTimer timer;
+	timer.start();
+	auto called = false;
+	auto reply = client.rootClass()->callRaw(QtRestClient::RestClass::GetVerb, QStringLiteral("posts/1"));
+	reply->onSucceeded([&](int) {
+		called = true;
+		QFAIL("Expected request to time out");
+	});
+	reply->onError([&](const QString &, int code, QtRestClient::RestReply::Error type) {
+		called = true;
+		QCOMPARE(type, QtRestClient::RestReply::Error::Timeout);
+		QCOMPARE(code, static_cast<int>(QNetworkReply::TimeoutError));
+	});
+	QTRY_VERIFY(called);
+	QVERIFY(timer.elapsed() >= 200);
+
+	// so are handles and raw replies, which never see a RestReply
+	timer.restart();
+	std::optional<QtRestClient::ReplyHandle::Result> handleResult;
+	const auto handle = client.rootClass()->send(QtRestClient::RestClass::GetVerb, QStringLiteral("posts/1"), [&](const QtRestClient::ReplyHandle::Result &result) {
+		handleResult = result;
+	});
+	QTRY_VERIFY(handleResult);
+	QVERIFY(timer.elapsed() >= 200);
+	QCOMPARE(handleResult->error, QtRestClient::RestReply::Error::Timeout);
+	QCOMPARE(handleResult->networkError, QNetworkReply::TimeoutError);
+	const auto rawReply = client.builder().addPath(QStringLiteral("posts/1")).send();
+	QSignalSpy rawSpy{rawReply, &QNetworkReply::finished};
+	QVERIFY(rawSpy.wait());
+	QCOMPARE(rawReply->error(), QNetworkReply::OperationCanceledError);
+	rawReply->deleteLater();
+
+	// retries stop with the deadline, which replaces the shorter default timeout
+	client.setBaseUrl(server.url());
+	client.setDefaultTimeout(100ms);
+	timer.restart();
+	auto attempts = 0;
+	auto timedOut = false;
+	reply = new QtRestClient::RestReply{
+		client.builder()
+			.addPath(QStringLiteral("nothing"))
+			.setDeadline(QDeadlineTimer{300ms})
+			.send(),
+		this
+	};
+	reply->onFailed([&](int code) {
+		++attempts;
+		QCOMPARE(code, 404);
+		reply->retryAfter(50ms);
+	});
+	reply->onError([&](const QString &, int, QtRestClient::RestReply::Error type) {
+		timedOut = true;
+		QCOMPARE(type, QtRestClient::RestReply::Error::Timeout);
+	});
+	QTRY_VERIFY(timedOut);
+	QVERIFY(timer.elapsed() >= 250);
+	QVERIFY(attempts > 1);
+	const auto finalAttempts = attempts;
+	QTest::qWait(200);
+	QCOMPARE(attempts, finalAttempts);
+}
+
+void RestClientTest::testCircuitBreaker()
+{
+	HttpServer server;
+	QVERIFY(server.setupRoutes());
+	server.setDefaultData();
+	// plain values cannot be sent as JSON, so the server fails with 500
+	server.setSubData(QStringLiteral("broken"), QCborMap{{1, 42}});
+
+	QtRestClient::RestClient client;
+	client.setBaseUrl(server.url());
+	QtRestClient::CircuitBreakerSettings settings;
+	settings.scope = QtRestClient::CircuitBreakerSettings::Scope::Route;
+	settings.minimumReplies = 3;
+	settings.openDuration = 200ms;
+	QSignalSpy breakerSpy{&client, &QtRestClient::RestClient::circuitBreakerChanged};
+	client.setCircuitBreaker(settings);
+	QVERIFY(client.circuitBreaker());
+	QCOMPARE(breakerSpy.size(), 1);
+	const auto brokenClass = client.createClass(QStringLiteral("broken"), this);
+	const auto postsClass = client.createClass(QStringLiteral("posts"), this);
+
+	// each step sends one request and expects its status code, or -1 if rejected by the circuit breaker
+	const auto expect = [&](QtRestClient::RestClass *restClass, int status) {
+		const auto result = get(restClass, QStringLiteral("1"));
+		if (QTest::currentTestFailed())
+			return false;
+		const auto actual = result.error == QtRestClient::RestReply::Error::CircuitOpen ? -1 : result.status;
+		return QTest::qCompare(actual, status, "actual", "status", __FILE__, __LINE__);
+	};
+	const auto expectHandle = [&](QtRestClient::RestClass *restClass, int status) {
+		std::optional<QtRestClient::ReplyHandle::Result> result;
+		const auto handle = restClass->send(QtRestClient::RestClass::GetVerb, QStringLiteral("1"), [&](const QtRestClient::ReplyHandle::Result &handleResult) {
+			result = handleResult;
+		});
+		if (!QTest::qWaitFor([&]() { return result.has_value(); })) {
+			QTest::qFail("The handle did not complete", __FILE__, __LINE__);
+			return false;
+		}
+		const auto actual = result->error == QtRestClient::RestReply::Error::CircuitOpen ? -1 : result->status;
+		return QTest::qCompare(actual, status, "actual", "status", __FILE__, __LINE__);
+	};
+
+	// the circuit opens after repeated server errors, other routes are not affected
+	for (auto i = 0; i < 3; ++i)
+		QVERIFY(expect(brokenClass, 500));
+	QVERIFY(expect(brokenClass, -1));
+	QVERIFY(expect(postsClass, 200));
+
+	// raw replies of rejected requests report asynchronously, like any other network reply
+	auto rawReply = brokenClass->builder().addPath(QStringLiteral("1")).send();
+	QSignalSpy finishedSpy{rawReply, &QNetworkReply::finished};
+#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
+	QSignalSpy errorSpy{rawReply, QOverload<QNetworkReply::NetworkError>::of(&QNetworkReply::error)};
+#else
+	QSignalSpy errorSpy{rawReply, &QNetworkReply::errorOccurred};
+#endif
+	QCOMPARE(finishedSpy.size(), 0);
+	QVERIFY(finishedSpy.wait());
+	QCOMPARE(errorSpy.size(), 1);
+	QCOMPARE(errorSpy[0][0].value<QNetworkReply::NetworkError>(), QNetworkReply::ServiceUnavailableError);
+	QCOMPARE(rawReply->error(), QNetworkReply::ServiceUnavailableError);
+	rawReply->deleteLater();
+
+	// a failed trial opens the circuit again
+	QTest::qWait(250);
+	QVERIFY(expect(brokenClass, 500));
+	QVERIFY(expect(brokenClass, -1));
+
+	// a successful trial closes it
+	server.setSubData(QStringLiteral("broken"), QCborMap{{1, QCborMap{{QStringLiteral("id"), 1}}}});
+	QTest::qWait(250);
+	QVERIFY(expect(brokenClass, 200));
+	QVERIFY(expect(brokenClass, 200));
+
+	// handles are rejected by open circuits, and their replies count like any other
+	server.setSubData(QStringLiteral("broken"), QCborMap{{1, 42}});
+	for (auto i = 0; i < 3; ++i)
+		QVERIFY(expectHandle(brokenClass, 500));
+	QVERIFY(expectHandle(brokenClass, -1));
+	QVERIFY(expect(brokenClass, -1));
+	// their trials give the half open circuit free again
+	QTest::qWait(250);
+	QVERIFY(expectHandle(brokenClass, 500));
+	QVERIFY(expectHandle(brokenClass, -1));
+	server.setSubData(QStringLiteral("broken"), QCborMap{{1, QCborMap{{QStringLiteral("id"), 1}}}});
+	QTest::qWait(250);
+	QVERIFY(expectHandle(brokenClass, 200));
+	QVERIFY(expect(brokenClass, 200));
+	QVERIFY(expectHandle(brokenClass, 200));
+
+	client.setCircuitBreaker(std::nullopt);
+	QVERIFY(!client.circuitBreaker());
+	QCOMPARE(breakerSpy.size(), 2);
+}
+
+void RestClientTest::testRateLimiter()
+{
+	HttpServer server;
+	QVERIFY(server.setupRoutes());
+	server.setDefaultData();
+
+	QtRestClient::RestClient client;
+	client.setBaseUrl(server.url());
+	QtRestClient::RateLimiterSettings settings;
+	settings.rate = 10.0;
+	settings.burst = 2;
+	QSignalSpy limiterSpy{&client, &QtRestClient::RestClient::rateLimiterChanged};
+	client.setRateLimiter(settings);
+	QVERIFY(client.rateLimiter());
+	QCOMPARE(limiterSpy.size(), 1);
+
+	// requests beyond the burst are delayed, not failed
+	QElapsedTimer timer;
+	timer.start();
+	constexpr auto RequestCount = 5;
+	auto succeeded = 0;
+	for (auto i = 0; i < RequestCount; ++i) {
+		auto reply = client.rootClass()->callRaw(QtRestClient::RestClass::GetVerb, QStringLiteral("posts/1"));
+		reply->onSucceeded([&](int code) {
+			++succeeded;
+			QCOMPARE(code, 200);
+		});
+		reply->onAllErrors([&](const QString &error, int, QtRestClient::RestReply::Error) {
+			QFAIL(qUtf8Printable(error));
+		});
+	}
+	QTRY_COMPARE(succeeded, RequestCount);
+	QVERIFY(timer.elapsed() >= 250);
+
+	// answers the first request with 429, all others with an empty object
+	QTcpServer quotaServer;
+	QVERIFY(quotaServer.listen(QHostAddress::LocalHost));
+	auto requests = 0;
+	connect(&quotaServer, &QTcpServer::newConnection, this, [&]() {
+		while (auto socket = quotaServer.nextPendingConnection()) {
+			connect(socket, &QTcpSocket::readyRead, socket, [&requests, socket]() {
+				auto data = socket->property("buffer").toByteArray() + socket->readAll();
+				for (auto end = data.indexOf("\r\n\r\n"); end != -1; end = data.indexOf("\r\n\r\n")) {
+					data.remove(0, end + 4);
+					socket->write(++requests == 1 ?
+									  "HTTP/1.1 429 Too Many Requests\r\nRetry-After: 1\r\nContent-Length: 0\r\n\r\n" :
+									  "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: 2\r\n\r\n{}");
+				}
+				socket->setProperty("buffer", data);
+			});
+		}
+	});
+	auto quotaUrl = server.url();
+	quotaUrl.setPort(quotaServer.serverPort());
+	client.setBaseUrl(quotaUrl);
+
+	// rejected requests are queued again once the server accepts them
+	timer.restart();
+	auto called = false;
+	auto reply = client.rootClass()->callRaw(QtRestClient::RestClass::GetVerb, QStringLiteral("posts/1"));
+	reply->onSucceeded([&](int code) {
+		called = true;
+		QCOMPARE(code, 200);
+	});
+	reply->onAllErrors([&](const QString &error, int, QtRestClient::RestReply::Error) {
+		called = true;
+		QFAIL(qUtf8Printable(error));
+	});
+	QTRY_VERIFY_WITH_TIMEOUT(called, 10000);
+	QCOMPARE(requests, 2);
+	QVERIFY(timer.elapsed() >= 900);
+
+	// handles are never queued again, but their replies pause the bucket as well
+	requests = 0;
+	std::optional<QtRestClient::ReplyHandle::Result> handleResult;
+	const auto handle = client.rootClass()->send(QtRestClient::RestClass::GetVerb, QStringLiteral("posts/1"), [&](const QtRestClient::ReplyHandle::Result &result) {
+		handleResult = result;
+	});
+	QTRY_VERIFY(handleResult);
+	QCOMPARE(handleResult->status, 429);
+	timer.restart();
+	called = false;
+	reply = client.rootClass()->callRaw(QtRestClient::RestClass::GetVerb, QStringLiteral("posts/1"));
+	reply->onSucceeded([&](int code) {
+		called = true;
+		QCOMPARE(code, 200);
+	});
+	reply->onAllErrors([&](const QString &error, int, QtRestClient::RestReply::Error) {
+		called = true;
+		QFAIL(qUtf8Printable(error));
+	});
+	QTRY_VERIFY_WITH_TIMEOUT(called, 10000);
+	QCOMPARE(requests, 2);
+	QVERIFY(timer.elapsed() >= 900);
+
+	client.setRateLimiter(std::nullopt);
+	QVERIFY(!client.rateLimiter());
+	QCOMPARE(limiterSpy.size(), 2);
+}
+
+void RestClientTest::testRateLimiterHeaders_data()
+{
+	QTest::addColumn<QtRestClient::RateLimiterSettings::ResetFormat>("resetFormat");
+	QTest::addColumn<int>("status");
+	QTest::addColumn<QByteArray>("header");
+	QTest::addColumn<QByteArray>("value");
+	QTest::addColumn<qint64>("pause");
+
+	using ResetFormat = QtRestClient::RateLimiterSettings::ResetFormat;
+	const auto now = QDateTime::currentDateTimeUtc();
+	QTest::newRow("retryAfter.seconds") << ResetFormat::DeltaSeconds << 429
+										<< QByteArray{"Retry-After"} << QByteArray{"3"} << 3000ll;
+	QTest::newRow("retryAfter.date") << ResetFormat::DeltaSeconds << 429
+									 << QByteArray{"Retry-After"}
+									 << now.addSecs(3).toString(Qt::RFC2822Date).toLatin1()
+									 << 3000ll;
+	QTest::newRow("retryAfter.invalid") << ResetFormat::DeltaSeconds << 429
+										<< QByteArray{"Retry-After"} << QByteArray{"soon"} << 1000ll;
+	QTest::newRow("reset.standard") << ResetFormat::UnixTime << 200
+									<< QByteArray{"RateLimit-Reset"} << QByteArray{"3"} << 3000ll;
+	QTest::newRow("reset.seconds") << ResetFormat::DeltaSeconds << 200
+								   << QByteArray{"X-RateLimit-Reset"} << QByteArray{"3"} << 3000ll;
+	// large relative resets are not mistaken for timestamps
+	QTest::newRow("reset.longSeconds") << ResetFormat::DeltaSeconds << 200
+									   << QByteArray{"X-RateLimit-Reset"} << QByteArray{"86400"} << 86400000ll;
+	QTest::newRow("reset.unixTime") << ResetFormat::UnixTime << 200
+									<< QByteArray{"X-RateLimit-Reset"}
+									<< QByteArray::number(now.toSecsSinceEpoch() + 3)
+									<< 3000ll;
+}
+
+void RestClientTest::testRateLimiterHeaders()
+{
+	QFETCH(QtRestClient::RateLimiterSettings::ResetFormat, resetFormat);
+	QFETCH(int, status);
+	QFETCH(QByteArray, header);
+	QFETCH(QByteArray, value);
+	QFETCH(qint64, pause);
+
+	QtRestClient::RateLimiterSettings settings;
+	settings.resetFormat = resetFormat;
+	QtRestClient::RateLimiter limiter{settings};
+	const auto bucket = QStringLiteral("api.example.com:443");
+	QCOMPARE(limiter.reserve(bucket), 0ms);
+
+	// the quota is used up, so the bucket waits for the reset or for the server to accept requests again
+	HeaderReply reply{status, {{"X-RateLimit-Remaining", "0"}, {header, value}}};
+	limiter.update(bucket, &reply);
+	const auto wait = limiter.reserve(bucket).count();
+	// the limiter and the header only count whole seconds, so the bounds are generous
+	QVERIFY2(wait > pause - 1500 && wait <= pause + 500, qUtf8Printable(QString::number(wait)));
+}
+
+RestClientTest::Result RestClientTest::get(QtRestClient::RestClass *restClass, const QString &path)
+{
+	std::optional<Result> result;
+	auto reply = restClass->callRaw(QtRestClient::RestClass::GetVerb, path);
+	connect(reply, &QtRestClient::RestReply::completed, this, [&result, reply](int code) {
+		result = Result{code, reply->networkReply()->url(), std::nullopt};
+	});
+	connect(reply, &QtRestClient::RestReply::error, this, [&result, reply](const QString &, int, QtRestClient::RestReply::Error type) {
+		result = Result{
+			reply->networkReply()->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt(),
+			reply->networkReply()->url(),
+			type
+		};
+	});
+	if (!QTest::qWaitFor([&]() { return result.has_value(); }, 10000)) {
+		// the reply still references the result
+		reply->disconnect(this);
+		QTest::qFail("The reply did not finish in time", __FILE__, __LINE__);
+		return {};
+	}
+	return *result;
+}
+
+QUrl RestClientTest::listenStuck(QTcpServer &stuckServer)
+{
+	if (!stuckServer.listen(QHostAddress::LocalHost)) {
+		QTest::qFail(qUtf8Printable(stuckServer.errorString()), __FILE__, __LINE__);
+		return {};
+	}
+	QUrl url;
+	url.setScheme(QStringLiteral("http"));
+	url.setHost(QStringLiteral("localhost"));
+	url.setPort(stuckServer.serverPort());
+	return url;
+}
+
 QTEST_MAIN(RestClientTest)
 
 #include "tst_restclient.moc"
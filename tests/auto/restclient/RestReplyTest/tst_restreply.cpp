@@ -3,10 +3,32 @@
 #include <jphpost.h>
 
 #include <QtRestClient/private/restreply_p.h>
+#include <QtRestClient/ireplyparser.h>
+
+#include <atomic>
 using namespace QtJsonSerializer;
 using namespace QtRestClient;
 using namespace std::chrono_literals;
 
+class TestReplyParser : public IReplyParser
+{
+public:
+	std::atomic_bool fail = false;
+	QByteArrayList types {"application/json"};
+
+	QByteArrayList contentTypes() const override {
+		return types;
+	}
+
+	Result parse(QIODevice *device, const QByteArray &contentType) const override {
+		if (fail)
+			return ParseError{42, QStringLiteral("failed")};
+		auto object = QJsonDocument::fromJson(device->readAll()).object();
+		object[QStringLiteral("contentType")] = QString::fromUtf8(contentType);
+		return DataType{QJsonValue{object}};
+	}
+};
+
 class RestReplyTest : public QObject
 {
 	Q_OBJECT
@@ -20,6 +42,8 @@ private Q_SLOTS:
 	void testReplyRetry();
 
 	void testCallbackOverloads();
+	void testReplyHandle();
+	void testReplyParser();
 
 	void testGenericReplyWrapping_data();
 	void testGenericReplyWrapping();
@@ -35,6 +59,10 @@ private Q_SLOTS:
 	void testPagingNext();
 	void testPagingPrevious();
 	void testPagingIterate();
+	void testPagingCursorIterate();
+	void testPagingShardIterate();
+	void testPagingStream();
+	void testConfigurablePaging();
 
 	void testSimpleExtension();
 	void testSimplePagingIterate();
@@ -310,11 +338,174 @@ void RestReplyTest::testCallbackOverloads()
 			QCOMPARE(value, QCborArray{});
 		});
 		QTRY_VERIFY(called);
+
+		// move only handlers are stored without a std::function
+		reply = new QtRestClient::RestReply{nam->get(request)};
+		called = false;
+		reply->onSucceeded([&, token = std::make_unique<int>(42)](int code){
+			called = true;
+			QCOMPARE(code, 200);
+			QCOMPARE(*token, 42);
+		});
+		QTRY_VERIFY(called);
+
+		auto gReply = new QtRestClient::GenericRestReply<JphPost*>{nam->get(request), client};
+		called = false;
+		gReply->onSucceeded([&, token = std::make_unique<int>(42)](int code, JphPost *data){
+			called = true;
+			QCOMPARE(code, 200);
+			QCOMPARE(*token, 42);
+			QVERIFY(data);
+			QCOMPARE(data->id, 0);
+			data->deleteLater();
+		});
+		QTRY_VERIFY(called);
 	} catch (std::exception &e) {
 		QFAIL(e.what());
 	}
 }
 
+void RestReplyTest::testReplyHandle()
+{
+	for (const auto threaded : {false, true}) {
+		client->setThreaded(threaded);
+		auto rootClass = client->rootClass();
+
+		// success with a move-only handler
+		auto called = false;
+		auto token = std::make_unique<int>(42);
+		auto handle = rootClass->send(RestClass::GetVerb, QStringLiteral("posts/1"),
+									  [&, xToken = std::move(token)](const ReplyHandle::Result &result) {
+										  called = true;
+										  QVERIFY(xToken);
+										  QVERIFY(result.succeeded());
+										  QCOMPARE(result.status, 200);
+										  QCOMPARE(result.networkError, QNetworkReply::NoError);
+									  });
+		QVERIFY(!handle.isFinished());
+		QTRY_VERIFY(called);
+		QTRY_VERIFY(handle.isFinished());
+		QVERIFY(!handle.networkReply());
+
+		// failure, even without reading the body
+		called = false;
+		auto movedHandle = std::move(handle);
+		QVERIFY(movedHandle.isFinished());
+		movedHandle = rootClass->send(RestClass::GetVerb, QStringLiteral("invalid"),
+									  [&](const ReplyHandle::Result &result) {
+										  called = true;
+										  QVERIFY(!result.succeeded());
+										  QCOMPARE(result.status, 404);
+										  QVERIFY(result.error == RestReply::Error::Failure);
+									  });
+		QVERIFY(!handle.networkReply());
+		QTRY_VERIFY(called);
+
+		// aborted requests still report once
+		auto count = 0;
+		auto abortHandle = rootClass->send(RestClass::PostVerb, QStringLiteral("posts"), QJsonValue{QJsonObject{{QStringLiteral("id"), 42}}},
+										   [&](const ReplyHandle::Result &result) {
+											   ++count;
+											   QVERIFY(result.error == RestReply::Error::Network);
+											   QCOMPARE(result.networkError, QNetworkReply::OperationCanceledError);
+										   });
+		abortHandle.abort();
+		QTRY_COMPARE(count, 1);
+		QTRY_VERIFY(abortHandle.isFinished());
+	}
+	client->setThreaded(false);
+
+	// replies that finished before the handle was created still report, but never synchronously
+	auto count = 0;
+	auto finishedReply = nam->get(client->builder().addPath(QStringLiteral("posts/1")).build());
+	finishedReply->abort();
+	QVERIFY(finishedReply->isFinished());
+	auto finishedHandle = ReplyHandle::create(finishedReply, [&](const ReplyHandle::Result &result) {
+		++count;
+		QCOMPARE(result.networkError, QNetworkReply::OperationCanceledError);
+	});
+	QCOMPARE(count, 0);
+	QTRY_COMPARE(count, 1);
+	QVERIFY(finishedHandle.isFinished());
+	QVERIFY(!finishedHandle.networkReply());
+}
+
+void RestReplyTest::testReplyParser()
+{
+	auto parserClient = Testlib::createClient(this);
+	parserClient->setBaseUrl(server->url());
+	parserClient->setDataMode(RestClient::DataMode::Json);
+	auto parser = new TestReplyParser{};
+	parserClient->addReplyParser(parser);
+	QCOMPARE(parserClient->replyParser("application/json"), static_cast<IReplyParser*>(parser));
+	QVERIFY(parserClient->replyParser("application/cbor") != static_cast<IReplyParser*>(parser));
+
+	// raw replies
+	auto called = false;
+	auto reply = parserClient->rootClass()->callRaw(RestClass::GetVerb, QStringLiteral("posts/0"));
+	reply->onSucceeded([&](int code, const QJsonObject &value) {
+		called = true;
+		QCOMPARE(code, 200);
+		QCOMPARE(value[QStringLiteral("id")].toInt(), 0);
+		QCOMPARE(value[QStringLiteral("contentType")].toString(), QStringLiteral("application/json"));
+	});
+	reply->onAllErrors([&](const QString &error, int, RestReply::Error) {
+		called = true;
+		QFAIL(qUtf8Printable(error));
+	});
+	QTRY_VERIFY(called);
+
+	// generic replies
+	called = false;
+	auto gReply = parserClient->rootClass()->get<JphPost*>(QStringLiteral("posts/1"));
+	gReply->onSucceeded([&](int code, JphPost *data) {
+		called = true;
+		QCOMPARE(code, 200);
+		QVERIFY(data);
+		QCOMPARE(data->id, 1);
+		data->deleteLater();
+	});
+	gReply->onAllErrors([&](const QString &error, int, RestReply::Error) {
+		called = true;
+		QFAIL(qUtf8Printable(error));
+	});
+	QTRY_VERIFY(called);
+
+	// parser errors
+	parser->fail = true;
+	called = false;
+	reply = parserClient->rootClass()->callRaw(RestClass::GetVerb, QStringLiteral("posts/0"));
+	reply->onSucceeded([&](int) {
+		called = true;
+		QFAIL("Expected parser error");
+	});
+	reply->onError([&](const QString &error, int code, RestReply::Error type) {
+		called = true;
+		QCOMPARE(error, QStringLiteral("failed"));
+		QCOMPARE(code, 42);
+		QCOMPARE(type, RestReply::Error::Parser);
+	});
+	QTRY_VERIFY(called);
+
+	// removed parsers are no longer used or advertised
+	parserClient->removeReplyParser("application/json");
+	QVERIFY(!parserClient->replyParser("application/json"));
+	QVERIFY(!parserClient->codecRegistry().contentTypes().contains("application/json"));
+	QVERIFY(!parserClient->builder().build().rawHeader("Accept").contains("application/json"));
+
+	// added parsers replace the advertised quality for builders created afterwards
+	auto weightedParser = new TestReplyParser{};
+	weightedParser->types = {"application/x-test"};
+	parserClient->setCodecRegistry(parserClient->codecRegistry().addParser(weightedParser, 0.5));
+	QVERIFY(parserClient->builder().build().rawHeader("Accept").contains("application/x-test;q=0.5"));
+	auto unweightedParser = new TestReplyParser{};
+	unweightedParser->types = {"application/x-test"};
+	parserClient->addReplyParser(unweightedParser);
+	QVERIFY(!parserClient->builder().build().rawHeader("Accept").contains("application/x-test"));
+
+	parserClient->deleteLater();
+}
+
 void RestReplyTest::testGenericReplyWrapping_data()
 {
 	QTest::addColumn<QUrl>("url");
@@ -745,6 +936,193 @@ void RestReplyTest::testPagingIterate()
 	}
 }
 
+void RestReplyTest::testPagingCursorIterate()
+{
+	try {
+		for (auto mode : {RestClient::DataMode::Cbor, RestClient::DataMode::Json}) {
+			client->setDataMode(mode);
+			QNetworkRequest request(server->url("/cursors"));
+			Testlib::setAccept(request, client);
+			auto url = request.url();
+			url.setQuery(QStringLiteral("cursor=0"));
+			request.setUrl(url);
+
+			auto count = 0;
+			auto reply = new QtRestClient::GenericRestReply<QtRestClient::Paging<JphPost*>, QString>(nam->get(request), client);
+			reply->onSucceeded([&](int, const QtRestClient::Paging<JphPost*> &paging) {
+				QVERIFY(paging.isValid());
+				QCOMPARE(paging.cursor().toString(), QStringLiteral("0"));
+				QCOMPARE(paging.nextCursor().toString(), QStringLiteral("1"));
+				QVERIFY(paging.hasNext());
+				QCOMPARE(QUrlQuery{paging.nextUrl()}.queryItemValue(QStringLiteral("cursor")), QStringLiteral("1"));
+				QCOMPARE(paging.nextUrl().path(), QStringLiteral("/cursors"));
+				paging.iterate([&](JphPost *data, qint64 index){
+					auto ok = false;
+					[&](){
+						QVERIFY(data);
+						QCOMPARE(index, -1);
+						QCOMPARE(data->id, count++);
+						ok = true;
+					}();
+					if (!ok)
+						count = 101;
+					data->deleteLater();
+					return ok;
+				});
+			});
+			reply->onAllErrors([&](const QString &error, int, QtRestClient::RestReply::Error){
+				count = 101;
+				QFAIL(qUtf8Printable(error));
+			});
+			QTRY_COMPARE(count, 100);
+		}
+	} catch (std::exception &e) {
+		QFAIL(e.what());
+	}
+}
+
+void RestReplyTest::testPagingShardIterate()
+{
+	try {
+		for (auto mode : {RestClient::DataMode::Cbor, RestClient::DataMode::Json}) {
+			client->setDataMode(mode);
+
+			QSet<int> ids;
+			QSet<qint64> indexes;
+			auto failed = false;
+			QtRestClient::Paging<JphPost*>::iterateShards<QString>(client->rootClass(), QUrl{QStringLiteral("shards")}, 4, [&](JphPost *data, qint64 index){
+				ids.insert(data->id);
+				indexes.insert(index);
+				data->deleteLater();
+				return true;
+			}, [&](const QString &error, int, QtRestClient::RestReply::Error){
+				failed = true;
+				QFAIL(qUtf8Printable(error));
+			});
+			QTRY_COMPARE(ids.size(), 100);
+			QVERIFY(!failed);
+			QCOMPARE(indexes.size(), 100);
+			QCOMPARE(*std::max_element(indexes.constBegin(), indexes.constEnd()), 99);
+		}
+	} catch (std::exception &e) {
+		QFAIL(e.what());
+	}
+}
+
+void RestReplyTest::testPagingStream()
+{
+	try {
+		client->setDataMode(RestClient::DataMode::Json);
+		QNetworkRequest request(server->url("/pages/0"));
+		Testlib::setAccept(request, client);
+
+		PagingStream<JphPost*, QString> stream{new GenericRestReply<Paging<JphPost*>, QString>(nam->get(request), client), 1};
+		stream.onAllErrors([&](const QString &error, int, RestReply::Error){
+			QFAIL(qUtf8Printable(error));
+		});
+
+		// only the first page and one page of read-ahead are requested
+		QTRY_COMPARE(stream.bufferedItems(), 20);
+		QTest::qWait(500);
+		QCOMPARE(stream.bufferedItems(), 20);
+
+		auto count = 0;
+		auto depth = 0;
+		auto finished = false;
+		PagingStream<JphPost*, QString>::ItemHandler handler = [&](std::optional<JphPost*> item) {
+			if (!item) {
+				finished = true;
+				return;
+			}
+			[&](){
+				QVERIFY(*item);
+				QCOMPARE((*item)->id, count++);
+			}();
+			(*item)->deleteLater();
+			QVERIFY(stream.bufferedItems() <= 20);
+			// buffered items are delivered after the handler returned, not recursively
+			++depth;
+			stream.next(handler);
+			QCOMPARE(depth, 1);
+			--depth;
+		};
+		stream.next(handler);
+		QTRY_VERIFY(finished);
+		QCOMPARE(count, 100);
+		QVERIFY(stream.atEnd());
+		QVERIFY(!stream.error());
+
+		// errors end the stream
+		QNetworkRequest errorRequest(server->url("/invalid"));
+		Testlib::setAccept(errorRequest, client);
+		PagingStream<JphPost*, QString> errorStream{new GenericRestReply<Paging<JphPost*>, QString>(nam->get(errorRequest), client)};
+		auto errorCalled = false;
+		errorStream.onAllErrors([&](const QString &, int, RestReply::Error type){
+			errorCalled = true;
+			QCOMPARE(type, RestReply::Error::Network);
+		});
+		finished = false;
+		errorStream.next([&](std::optional<JphPost*> item) {
+			finished = true;
+			QVERIFY(!item);
+		});
+		QTRY_VERIFY(finished);
+		QVERIFY(errorCalled);
+		QVERIFY(errorStream.atEnd());
+		QVERIFY(errorStream.error());
+	} catch (std::exception &e) {
+		QFAIL(e.what());
+	}
+}
+
+void RestReplyTest::testConfigurablePaging()
+{
+	ConfigurablePagingFactory factory;
+	factory.setPath(ConfigurablePagingFactory::Field::Items, QStringLiteral("data.results"))
+		.setPath(ConfigurablePagingFactory::Field::Total, QStringLiteral("/meta/pagination/total"))
+		.setPath(ConfigurablePagingFactory::Field::Offset, QStringLiteral("/meta/pagination/offset"))
+		.setPath(ConfigurablePagingFactory::Field::Next, QString{})
+		.setPath(ConfigurablePagingFactory::Field::Previous, QString{});
+	QCOMPARE(factory.path(ConfigurablePagingFactory::Field::Items), QStringLiteral("data.results"));
+
+	const QJsonObject envelope {
+		{QStringLiteral("data"), QJsonObject {
+			 {QStringLiteral("results"), QJsonArray{1, 2, 3}}
+		 }},
+		{QStringLiteral("meta"), QJsonObject {
+			 {QStringLiteral("pagination"), QJsonObject {
+				  {QStringLiteral("total"), 30},
+				  {QStringLiteral("offset"), 10}
+			  }}
+		 }}
+	};
+	const HeaderHash headers {
+		{"link", "</items?page=3>; rel=\"next\", <https://api.example.org/items?page=1>; rel=\"prev first\""}
+	};
+	const QUrl requestUrl {QStringLiteral("https://api.example.org/v1/items?page=2")};
+
+	try {
+		QScopedPointer<IPaging> paging{factory.createPagingFromReply(client->serializer(), QJsonValue{envelope}, headers, requestUrl)};
+		QVERIFY(paging);
+		QCOMPARE(paging->total(), Q_INT64_C(30));
+		QCOMPARE(paging->offset(), Q_INT64_C(10));
+		QCOMPARE(std::get<QJsonArray>(paging->items()), (QJsonArray{1, 2, 3}));
+		QVERIFY(paging->hasNext());
+		QCOMPARE(paging->next(), QUrl{QStringLiteral("https://api.example.org/items?page=3")});
+		QVERIFY(paging->hasPrevious());
+		QCOMPARE(paging->previous(), QUrl{QStringLiteral("https://api.example.org/items?page=1")});
+	} catch (std::exception &e) {
+		QFAIL(e.what());
+	}
+
+	const auto links = ConfigurablePagingFactory::parseLinkHeader(headers.value("link"));
+	QCOMPARE(links.size(), 3);
+	QCOMPARE(links.value(QStringLiteral("next")), QUrl{QStringLiteral("/items?page=3")});
+	QCOMPARE(links.value(QStringLiteral("first")), QUrl{QStringLiteral("https://api.example.org/items?page=1")});
+
+	QVERIFY_EXCEPTION_THROWN(QScopedPointer<IPaging>{factory.createPaging(client->serializer(), QJsonValue{QJsonObject{}})}, DeserializationException);
+}
+
 void RestReplyTest::testSimpleExtension()
 {
 	try {
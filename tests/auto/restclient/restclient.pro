@@ -9,6 +9,7 @@ SUBDIRS += \
 	RequestBuilderTest \
 	RestClientTest \
 	RestReplyTest \
+	ReplyDeliveryTest \
 	RestBuilderTest \
 	IntegrationTest
 
@@ -17,6 +18,7 @@ SUBDIRS += \
 RequestBuilderTest.depends += testlib
 RestClientTest.depends += testlib
 RestReplyTest.depends += testlib
+ReplyDeliveryTest.depends += testlib
 IntegrationTest.depends += testlib
 RestBuilderTest.depends += testlib
 RestAwaitablesTest.depends += testlib
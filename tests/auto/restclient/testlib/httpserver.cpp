@@ -150,6 +150,17 @@ bool HttpServer::setupRoutes()
 				switch (request.method()) {
 				case QHttpServerRequest::Method::Get: {
 					const auto query = request.query();
+					// cursor and shard requests select a single element
+					for (const auto &key : {QStringLiteral("cursor"), QStringLiteral("shard")}) {
+						if (query.hasQueryItem(key)) {
+							const auto tMap = _data[type].toMap();
+							const auto index = query.queryItemValue(key).toInt();
+							if (!tMap.contains(index))
+								throw HttpError{QHttpServerResponse::StatusCode::NotFound};
+							return reply(asJson, tMap[index]);
+						}
+					}
+
 					const auto offset = query.hasQueryItem(QStringLiteral("offset")) ?
 																					 request.query().queryItemValue(QStringLiteral("offset")).toInt() :
 																					 0;
@@ -194,10 +205,16 @@ bool HttpServer::setupRoutes()
 				auto tMap = _data[type].toMap();
 
 				switch (request.method()) {
-				case QHttpServerRequest::Method::Get:
+				case QHttpServerRequest::Method::Head:
+					++_headRequests;
+					Q_FALLTHROUGH();
+				case QHttpServerRequest::Method::Get: {
 					if (!tMap.contains(index))
 						throw HttpError{QHttpServerResponse::StatusCode::NotFound};
-					return reply(asJson, tMap[index]);
+					auto response = reply(asJson, tMap[index]);
+					addPagingHeaders(response, tMap[index]);
+					return response;
+				}
 				case QHttpServerRequest::Method::Put: {
 					auto data = extract(request, false);
 					data[QStringLiteral("id")] = index;
@@ -224,6 +241,43 @@ bool HttpServer::setupRoutes()
 	return ok;
 }
 
+bool HttpServer::setupTokenRoute(const QString &refreshToken)
+{
+	auto ok = false;
+	[&]() {
+		QVERIFY(_port > 0);
+		QVERIFY(_server->route(QStringLiteral("/oauth/token"), [this, refreshToken](const QHttpServerRequest &request) -> QHttpServerResponse {
+			const QUrlQuery query{QString::fromUtf8(request.body())};
+			if (request.method() != QHttpServerRequest::Method::Post ||
+				query.queryItemValue(QStringLiteral("grant_type")) != QStringLiteral("refresh_token") ||
+				query.queryItemValue(QStringLiteral("refresh_token")) != refreshToken)
+				return QHttpServerResponse::StatusCode::BadRequest;
+
+			++_tokenRefreshes;
+			return QHttpServerResponse {
+				QJsonObject {
+					{QStringLiteral("access_token"), generateToken()},
+					{QStringLiteral("token_type"), QStringLiteral("bearer")},
+					{QStringLiteral("expires_in"), 3600},
+					{QStringLiteral("refresh_token"), refreshToken}
+				}
+			};
+		}));
+		ok = true;
+	}();
+	return ok;
+}
+
+int HttpServer::tokenRefreshes() const
+{
+	return _tokenRefreshes;
+}
+
+int HttpServer::headRequests() const
+{
+	return _headRequests;
+}
+
 QCborMap HttpServer::data() const
 {
 	return _data;
@@ -323,6 +377,35 @@ void HttpServer::setAdvancedData()
 	root[QStringLiteral("pages")] = pages;
 	root[QStringLiteral("pagelets")] = pagelets;
 
+	QCborMap cursors;
+	for(auto i = 0; i < 10; i++) {
+		QCborMap cursor {
+			{QStringLiteral("cursor"), QString::number(i)},
+			{QStringLiteral("nextCursor"), i < 9 ?
+				QCborValue{QString::number(i + 1)} :
+				QCborValue{QCborValue::Null}
+			},
+		};
+
+		QCborArray cursorItems;
+		for (auto j = 0; j < 10; j++)
+			cursorItems.append(posts[(i*10) + j]);
+		cursor[QStringLiteral("items")] = cursorItems;
+		cursors[i] = cursor;
+	}
+	root[QStringLiteral("cursors")] = cursors;
+
+	QCborMap shards;
+	for(auto i = 0; i < 4; i++) {
+		QCborArray shardItems;
+		for (auto j = i; j < 100; j += 4)
+			shardItems.append(posts[j]);
+		shards[i] = QCborMap {
+			{QStringLiteral("items"), shardItems}
+		};
+	}
+	root[QStringLiteral("shards")] = shards;
+
 	setData(root);
 }
 
@@ -372,6 +455,15 @@ QCborMap HttpServer::extract(const QHttpServerRequest &request, bool allowPost)
 		throw HttpError{cType, QHttpServerResponse::StatusCode::UnsupportedMediaType};
 }
 
+void HttpServer::addPagingHeaders(QHttpServerResponse &response, const QCborValue &value) const
+{
+	const auto map = value.toMap();
+	if (map.contains(QStringLiteral("total")))
+		response.addHeader("X-Total-Count", QByteArray::number(map[QStringLiteral("total")].toInteger()));
+	if (const auto next = map[QStringLiteral("next")]; next.isUrl())
+		response.addHeader("Link", "<" + url(next.toUrl().path()).toEncoded() + ">; rel=\"next\"");
+}
+
 QHttpServerResponse HttpServer::reply(bool asJson, const QCborValue &value)
 {
 	if (asJson) {
@@ -21,6 +21,9 @@ public:
 	QString generateToken();
 
 	bool setupRoutes();
+	bool setupTokenRoute(const QString &refreshToken);
+	int tokenRefreshes() const;
+	int headRequests() const;
 
 	QCborMap data() const;
 	void setData(QCborMap data);
@@ -32,11 +35,14 @@ private:
 	QHttpServer *_server;
 	int _port = -1;
 	QByteArray _token;
+	int _tokenRefreshes = 0;
+	int _headRequests = 0;
 	QCborMap _data;
 
 	bool checkAccept(const QHttpServerRequest &request);
 	QCborMap extract(const QHttpServerRequest &request, bool allowPost);
 	QHttpServerResponse reply(bool asJson, const QCborValue &value);
+	void addPagingHeaders(QHttpServerResponse &response, const QCborValue &value) const;
 };
 
 #endif // HTTPSERVER_H
@@ -1,8 +1,32 @@
 #include "testlib.h"
 #include <QtRestClientAuth/QtRestClientAuth>
+#include <QtNetworkAuth/QOAuth1>
 using namespace QtRestClient;
 using namespace QtRestClient::Auth;
 
+class SequentialBuffer : public QBuffer
+{
+public:
+	using QBuffer::QBuffer;
+
+	bool isSequential() const override {
+		return true;
+	}
+};
+
+class CustomFlow : public QOAuth2AuthorizationCodeFlow
+{
+	Q_OBJECT
+
+public:
+	using QOAuth2AuthorizationCodeFlow::QOAuth2AuthorizationCodeFlow;
+
+	void prepareRequest(QNetworkRequest *request, const QByteArray &verb, const QByteArray &body) override {
+		QOAuth2AuthorizationCodeFlow::prepareRequest(request, verb, body);
+		request->setRawHeader("X-Custom", verb);
+	}
+};
+
 class AuthRequestBuilderTest : public QObject
 {
 	Q_OBJECT
@@ -13,6 +37,8 @@ private Q_SLOTS:
 
 	void testSending_data();
 	void testSending();
+	void testBodySigning();
+	void testCustomPrepare();
 
 private:
 	HttpServer *server;
@@ -135,6 +161,48 @@ void AuthRequestBuilderTest::testSending()
 	reply->deleteLater();
 }
 
+void AuthRequestBuilderTest::testBodySigning()
+{
+	// bearer tokens do not sign the body
+	QVERIFY(!AuthExtender{oAuth}.requiresBody());
+
+	QOAuth1 oAuth1{new QNetworkAccessManager{this}};
+	oAuth1.setClientCredentials(QStringLiteral("key"), QStringLiteral("secret"));
+	oAuth1.setTokenCredentials(QStringLiteral("token"), QStringLiteral("tokenSecret"));
+	QVERIFY(AuthExtender{&oAuth1}.requiresBody());
+
+	// sequential bodies cannot be read for the signature without consuming them
+	SequentialBuffer device;
+	device.setData("data");
+	QVERIFY(device.open(QIODevice::ReadOnly));
+	AuthRequestBuilder builder{server->url("/posts"), &oAuth1};
+	builder.setVerb(RestClass::PostVerb)
+		.setBody(&device, "text/plain");
+	auto reply = builder.send();
+	QVERIFY(reply->isFinished());
+	QCOMPARE(reply->error(), QNetworkReply::ProtocolInvalidOperationError);
+	QCOMPARE(device.pos(), 0);
+	reply->deleteLater();
+}
+
+void AuthRequestBuilderTest::testCustomPrepare()
+{
+	// overridden prepareRequest implementations are not bypassed by the header cache
+	CustomFlow flow{new QNetworkAccessManager{this}};
+	flow.setToken(QStringLiteral("custom"));
+	AuthExtender extender{&flow};
+	QNetworkRequest request;
+	auto verb = RestClass::PutVerb;
+	extender.extendRequest(request, verb, nullptr);
+	QCOMPARE(request.rawHeader("Authorization"), QByteArray{"Bearer custom"});
+	QCOMPARE(request.rawHeader("X-Custom"), RestClass::PutVerb);
+
+	flow.setToken(QStringLiteral("changed"));
+	request = QNetworkRequest{};
+	extender.extendRequest(request, verb, nullptr);
+	QCOMPARE(request.rawHeader("Authorization"), QByteArray{"Bearer changed"});
+}
+
 QTEST_MAIN(AuthRequestBuilderTest)
 
 #include "tst_authrequestbuilder.moc"
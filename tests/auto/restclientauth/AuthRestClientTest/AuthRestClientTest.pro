@@ -0,0 +1,16 @@
+TEMPLATE = app
+
+QT += testlib restclientauth
+QT -= gui
+CONFIG += console
+CONFIG -= app_bundle
+
+TARGET = tst_authrestclient
+
+LIB_PWD = $$OUT_PWD/../../restclient/testlib
+include(../../restclient/tests.pri)
+
+SOURCES += \
+	tst_authrestclient.cpp
+
+DEFINES += SRCDIR=\\\"$$PWD/\\\"
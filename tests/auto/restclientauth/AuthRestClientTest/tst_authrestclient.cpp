@@ -0,0 +1,140 @@
+#include "testlib.h"
+#include <QtRestClientAuth/QtRestClientAuth>
+using namespace QtRestClient;
+using namespace QtRestClient::Auth;
+using namespace std::chrono_literals;
+
+class AuthRestClientTest : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+	void initTestCase();
+	void cleanupTestCase();
+
+	void testCachedAuthorization();
+	void testReplayUnauthorized();
+	void testProactiveRefresh();
+
+private:
+	HttpServer *server;
+	QOAuth2AuthorizationCodeFlow *oAuth;
+	AuthRestClient *client;
+};
+
+void AuthRestClientTest::initTestCase()
+{
+	server = new HttpServer(this);
+	QVERIFY(server->setupTokenRoute(QStringLiteral("refresh")));
+	QVERIFY(server->setupRoutes());
+	server->setDefaultData();
+	oAuth = new QOAuth2AuthorizationCodeFlow{new QNetworkAccessManager{this}, this};
+	oAuth->setAccessTokenUrl(server->url(QStringLiteral("/oauth/token")));
+	oAuth->setRefreshToken(QStringLiteral("refresh"));
+	client = new AuthRestClient{RestClient::DataMode::Json, oAuth, this};
+	client->setBaseUrl(server->url());
+}
+
+void AuthRestClientTest::cleanupTestCase()
+{
+	server->deleteLater();
+	server = nullptr;
+	client->deleteLater();
+	client = nullptr;
+	oAuth = nullptr;
+}
+
+void AuthRestClientTest::testCachedAuthorization()
+{
+	oAuth->setToken(QStringLiteral("first"));
+	auto request = client->builder().build();
+	QCOMPARE(request.rawHeader("Authorization"), QByteArray{"Bearer first"});
+	QCOMPARE(request.rawHeader("User-Agent"), oAuth->userAgent().toUtf8());
+
+	// the cached header follows the token
+	oAuth->setToken(QStringLiteral("second"));
+	request = client->builder().build();
+	QCOMPARE(request.rawHeader("Authorization"), QByteArray{"Bearer second"});
+
+	// same headers as created by the OAuth instance itself
+	QNetworkRequest oAuthRequest;
+	oAuth->prepareRequest(&oAuthRequest, RestClass::GetVerb);
+	QCOMPARE(request.rawHeader("Authorization"), oAuthRequest.rawHeader("Authorization"));
+	QCOMPARE(request.rawHeader("User-Agent"), oAuthRequest.rawHeader("User-Agent"));
+}
+
+void AuthRestClientTest::testReplayUnauthorized()
+{
+	server->generateToken();
+	oAuth->setToken(QStringLiteral("outdated"));
+
+	// without replaying, the 401 is passed on
+	client->setReplayUnauthorized(false);
+	auto called = false;
+	auto reply = client->rootClass()->callRaw(RestClass::GetVerb, QStringLiteral("posts/1"));
+	reply->onSucceeded([&](int) {
+		called = true;
+		QFAIL("Expected request to fail");
+	});
+	reply->onAllErrors([&](const QString &, int, RestReply::Error) {
+		called = true;
+	});
+	QTRY_VERIFY(called);
+	QCOMPARE(server->tokenRefreshes(), 0);
+	client->setReplayUnauthorized(true);
+
+	// all requests that fail at the same time share one refresh
+	QSignalSpy refreshSpy{client, &AuthRestClient::accessTokenRefreshed};
+	constexpr auto RequestCount = 5;
+	auto succeeded = 0;
+	for (auto i = 0; i < RequestCount; ++i) {
+		reply = client->rootClass()->callRaw(RestClass::GetVerb, QStringLiteral("posts/%1").arg(i + 1));
+		reply->onSucceeded([&, i](int code, const QJsonObject &data) {
+			++succeeded;
+			QCOMPARE(code, 200);
+			QCOMPARE(data[QStringLiteral("id")].toInt(), i + 1);
+		});
+		reply->onAllErrors([&](const QString &error, int, RestReply::Error) {
+			QFAIL(qUtf8Printable(error));
+		});
+	}
+	QTRY_COMPARE(succeeded, RequestCount);
+	QCOMPARE(server->tokenRefreshes(), 1);
+	QCOMPARE(refreshSpy.size(), 1);
+	QVERIFY(refreshSpy[0][0].toBool());
+}
+
+void AuthRestClientTest::testProactiveRefresh()
+{
+	QSignalSpy refreshSpy{client, &AuthRestClient::accessTokenRefreshed};
+	QSignalSpy marginSpy{client, &AuthRestClient::refreshMarginChanged};
+	const auto refreshes = server->tokenRefreshes();
+
+	// tokens of the server expire after an hour
+	QVERIFY(oAuth->expirationAt().isValid());
+	client->setRefreshMargin(3599s);
+	QCOMPARE(marginSpy.size(), 1);
+	QCOMPARE(client->property("refreshMargin").value<std::chrono::seconds>(), 3599s);
+	QVERIFY(refreshSpy.wait());
+	QVERIFY(refreshSpy[0][0].toBool());
+	QCOMPARE(server->tokenRefreshes(), refreshes + 1);
+	client->setRefreshMargin(-1s);
+
+	// requests use the new token right away
+	auto called = false;
+	auto reply = client->rootClass()->callRaw(RestClass::GetVerb, QStringLiteral("posts/1"));
+	reply->onSucceeded([&](int code) {
+		called = true;
+		QCOMPARE(code, 200);
+	});
+	reply->onAllErrors([&](const QString &error, int, RestReply::Error) {
+		called = true;
+		QFAIL(qUtf8Printable(error));
+	});
+	QTRY_VERIFY(called);
+	QCOMPARE(server->tokenRefreshes(), refreshes + 1);
+}
+
+QTEST_MAIN(AuthRestClientTest)
+
+#include "tst_authrestclient.moc"
@@ -1,7 +1,8 @@
 TEMPLATE = subdirs
 
 SUBDIRS += \
-	AuthRequestBuilderTest
+	AuthRequestBuilderTest \
+	AuthRestClientTest
 
 prepareRecursiveTarget(run-tests)
 QMAKE_EXTRA_TARGETS += run-tests
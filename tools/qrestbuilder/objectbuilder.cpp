@@ -24,6 +24,12 @@ void ObjectBuilder::build()
 	} + data.includes;
 	if(isObject && !data.base)
 		data.base = QStringLiteral("QObject");
+	if(data.generateCodecs) {
+		data.includes.append({false, QStringLiteral("optional")});
+		data.includes.append({false, QStringLiteral("QtCore/QCborValue")});
+		data.includes.append({false, QStringLiteral("QtCore/QCborStreamReader")});
+		data.includes.append({false, QStringLiteral("QtCore/QJsonValue")});
+	}
 
 	// cpp code generation
 	if(isObject)
@@ -36,6 +42,8 @@ void ObjectBuilder::generateApiObject()
 {
 	//write header
 	writeIncludes(data.includes);
+	if(data.generateCodecs)
+		header << "namespace QtJsonSerializer {\nclass SerializerBase;\n}\n\n";
 	if(data.nspace)
 		header << "namespace " << data.nspace.value() << " {\n\n";
 	header << "class " << data.name << "Private;\n"
@@ -52,6 +60,8 @@ void ObjectBuilder::generateApiObject()
 	writeReadDeclarations();
 	if(data.generateEquals.value_or(false))
 		writeEqualsDeclaration();
+	if(data.generateCodecs)
+		writeCodecDeclarations();
 	header << "\npublic Q_SLOTS:\n";
 	writeWriteDeclarations();
 	writeResetDeclarations();
@@ -94,6 +104,8 @@ void ObjectBuilder::generateApiObject()
 		writeEqualsDefinition();
 		writeQHashDefinition();
 	}
+	if(data.generateCodecs)
+		writeCodecDefinitions();
 	writeSetupHooks();
 }
 
@@ -101,6 +113,8 @@ void ObjectBuilder::generateApiGadget()
 {
 	//write header
 	writeIncludes(data.includes);
+	if(data.generateCodecs)
+		header << "namespace QtJsonSerializer {\nclass SerializerBase;\n}\n\n";
 	if(data.nspace)
 		header << "namespace " << data.nspace.value() << " {\n\n";
 	header << "class " << data.name << "Data;\n";
@@ -127,6 +141,8 @@ void ObjectBuilder::generateApiGadget()
 	writeResetDeclarations();
 	if(data.generateEquals.value_or(true))
 		writeEqualsDeclaration();
+	if(data.generateCodecs)
+		writeCodecDeclarations();
 	header << "\nprivate:\n";
 	if (data.generateEquals.value_or(true))
 		writeQHashDeclaration(true);
@@ -160,6 +176,8 @@ void ObjectBuilder::generateApiGadget()
 		writeEqualsDefinition();
 		writeQHashDefinition();
 	}
+	if(data.generateCodecs)
+		writeCodecDefinitions();
 	writeSetupHooks();
 }
 
@@ -413,11 +431,26 @@ void ObjectBuilder::writeQHashDeclaration(bool asFriend)
 	}
 }
 
+void ObjectBuilder::writeCodecDeclarations()
+{
+	const auto resType = isObject ? data.name + QStringLiteral(" *") : data.name + QLatin1Char(' ');
+	header << "\n\tstatic " << resType << "fromCbor(const QCborValue &value, QtJsonSerializer::SerializerBase *serializer, QObject *parent = nullptr);\n"
+		   << "\tstatic " << resType << "fromJson(const QJsonValue &value, QtJsonSerializer::SerializerBase *serializer, QObject *parent = nullptr);\n"
+		   << "\tstatic std::optional<" << resType.trimmed() << "> fromCborStream(QCborStreamReader &reader, QtJsonSerializer::SerializerBase *serializer, QObject *parent = nullptr);\n"
+		   << "\tQCborValue toCbor(QtJsonSerializer::SerializerBase *serializer) const;\n"
+		   << "\tQJsonValue toJson(QtJsonSerializer::SerializerBase *serializer) const;\n";
+}
+
 void ObjectBuilder::writeSourceIncludes()
 {
 	source << "#include \"" << fileName << ".h\"\n\n"
 		   << "#include <limits>\n"
 		   << "#include <QtCore/QVariant>\n";
+	if(data.generateCodecs) {
+		source << "#include <QtCore/QCborMap>\n"
+			   << "#include <QtCore/QJsonObject>\n"
+			   << "#include <QtRestClient/generatedcodec.h>\n";
+	}
 	if(data.registerConverters) {
 		source << "#include <QtCore/QCoreApplication>\n"
 			   << "#include <QtCore/QHash>\n"
@@ -619,6 +652,176 @@ void ObjectBuilder::writeQHashDefinition()
 	}
 }
 
+void ObjectBuilder::writeCodecDefinitions()
+{
+	writeCodecReader(QStringLiteral("Cbor"));
+	writeCodecReader(QStringLiteral("Json"));
+	writeCodecStreamReader();
+	writeCodecWriter(QStringLiteral("Cbor"));
+	writeCodecWriter(QStringLiteral("Json"));
+}
+
+void ObjectBuilder::writeCodecReader(const QString &format)
+{
+	const auto isCbor = format == QStringLiteral("Cbor");
+	const auto access = isObject ? QStringLiteral("result->") : QStringLiteral("result.");
+	const auto parent = isObject ? QStringLiteral("result.data()") : QStringLiteral("parent");
+
+	source << "\n" << data.name << (isObject ? " *" : " ") << data.name << "::from" << format
+		   << "(const " << (isCbor ? "QCborValue" : "QJsonValue") << " &value, QtJsonSerializer::SerializerBase *serializer, QObject *parent)\n"
+		   << "{\n"
+		   << "\tconst auto map = value." << (isCbor ? "toMap" : "toObject") << "();\n"
+		   << "\tif(!value." << (isCbor ? "isMap" : "isObject") << "() ||\n";
+	// polymorphic or validated data can only be handled by the serializer
+	if(isObject) {
+		source << "\t   !QtRestClient::GeneratedCodec::canReadObject(serializer) ||\n"
+			   << "\t   map.contains(QStringLiteral(\"@class\")))\n";
+	} else
+		source << "\t   !QtRestClient::GeneratedCodec::canRead(serializer))\n";
+	source << "\t\treturn QtRestClient::GeneratedCodec::readGeneric<" << data.name << (isObject ? "*" : "") << ">(value, serializer, parent);\n\n";
+
+	if(isObject)
+		source << "\tQScopedPointer<" << data.name << "> result{new " << data.name << "{parent}};\n";
+	else
+		source << "\t" << data.name << " result;\n";
+
+	for(const auto &propVar : qAsConst(data.properties)) {
+		const auto &attribs = propertyAttribs(propVar);
+		if(attribs.stored && !attribs.stored.value())
+			continue;
+
+		QString type;
+		QString assignment;
+		if (nonstd::holds_alternative<RestBuilderXmlReader::Property>(propVar)) {
+			const auto &prop = nonstd::get<RestBuilderXmlReader::Property>(propVar);
+			type = prop.type;
+			assignment = access + QStringLiteral("d->") + prop.key + QStringLiteral(" = %1;");
+		} else {
+			const auto &prop = nonstd::get<RestBuilderXmlReader::UserProperty>(propVar);
+			if(!prop.write)  // read only properties are skipped by the serializer as well
+				continue;
+			type = prop.metaType.value_or(prop.type);
+			assignment = access + prop.write->name + QStringLiteral("(%1);");
+		}
+
+		const auto &key = propertyBasics(propVar).key;
+		source << "\tif(const auto " << key << "Value = map.value(QStringLiteral(\"" << key << "\")); !" << key << "Value.isUndefined())\n"
+			   << "\t\t" << assignment.arg(QStringLiteral("QtRestClient::GeneratedCodec::read<") + type + QStringLiteral(">(") +
+											 key + QStringLiteral("Value, serializer, ") + parent + QLatin1Char(')'))
+			   << "\n";
+	}
+
+	source << "\treturn " << (isObject ? "result.take()" : "result") << ";\n"
+		   << "}\n";
+}
+
+void ObjectBuilder::writeCodecStreamReader()
+{
+	const auto access = isObject ? QStringLiteral("result->") : QStringLiteral("result.");
+	const auto parent = isObject ? QStringLiteral("result.data()") : QStringLiteral("parent");
+
+	source << "\nstd::optional<" << data.name << (isObject ? "*" : "") << "> " << data.name
+		   << "::fromCborStream(QCborStreamReader &reader, QtJsonSerializer::SerializerBase *serializer, QObject *parent)\n"
+		   << "{\n"
+		   << "\tif(!reader.isMap() ||\n"
+		   << "\t   !QtRestClient::GeneratedCodec::" << (isObject ? "canReadObject" : "canRead") << "(serializer))\n"
+		   << "\t\treturn fromCbor(QCborValue::fromCbor(reader), serializer, parent);\n\n";
+
+	if(isObject)
+		source << "\tQScopedPointer<" << data.name << "> result{new " << data.name << "{parent}};\n";
+	else
+		source << "\t" << data.name << " result;\n";
+	source << "\treader.enterContainer();\n"
+		   << "\twhile(reader.lastError() == QCborError::NoError && reader.hasNext()) {\n"
+		   << "\t\tconst auto key = QtRestClient::GeneratedCodec::readStreamKey(reader);\n"
+		   << "\t\t";
+
+	auto first = true;
+	for(const auto &propVar : qAsConst(data.properties)) {
+		const auto &attribs = propertyAttribs(propVar);
+		if(attribs.stored && !attribs.stored.value())
+			continue;
+
+		QString type;
+		QString assignment;
+		if (nonstd::holds_alternative<RestBuilderXmlReader::Property>(propVar)) {
+			const auto &prop = nonstd::get<RestBuilderXmlReader::Property>(propVar);
+			type = prop.type;
+			assignment = access + QStringLiteral("d->") + prop.key + QStringLiteral(" = %1;");
+		} else {
+			const auto &prop = nonstd::get<RestBuilderXmlReader::UserProperty>(propVar);
+			if(!prop.write)  // read only properties are skipped by the serializer as well
+				continue;
+			type = prop.metaType.value_or(prop.type);
+			assignment = access + prop.write->name + QStringLiteral("(%1);");
+		}
+
+		const auto &key = propertyBasics(propVar).key;
+		source << (first ? "" : " else ") << "if(key == QStringLiteral(\"" << key << "\")) {\n"
+			   << "\t\t\tauto " << key << "Value = QtRestClient::GeneratedCodec::readStream<" << type << ">(reader, serializer, " << parent << ");\n"
+			   << "\t\t\tif(!" << key << "Value)\n"
+			   << "\t\t\t\treturn std::nullopt;\n"
+			   << "\t\t\t" << assignment.arg(QStringLiteral("std::move(*") + key + QStringLiteral("Value)")) << "\n"
+			   << "\t\t}";
+		first = false;
+	}
+	// polymorphic data can only be handled by the serializer, but the stream cannot be rewound
+	if(isObject) {
+		source << (first ? "" : " else ") << "if(key == QStringLiteral(\"@class\"))\n"
+			   << "\t\t\treturn std::nullopt;\n"
+			   << "\t\telse\n"
+			   << "\t\t\treader.next();\n";
+	} else if(first)
+		source << "reader.next();\n";
+	else {
+		source << " else\n"
+			   << "\t\t\treader.next();\n";
+	}
+	source << "\t}\n"
+		   << "\tif(reader.lastError() == QCborError::NoError)\n"
+		   << "\t\treader.leaveContainer();\n"
+		   << "\treturn " << (isObject ? "result.take()" : "result") << ";\n"
+		   << "}\n";
+}
+
+void ObjectBuilder::writeCodecWriter(const QString &format)
+{
+	const auto isCbor = format == QStringLiteral("Cbor");
+	source << "\n" << (isCbor ? "QCborValue " : "QJsonValue ") << data.name << "::to" << format
+		   << "(QtJsonSerializer::SerializerBase *serializer) const\n"
+		   << "{\n";
+	if(isObject) {
+		source << "\tif(!QtRestClient::GeneratedCodec::canWriteObject(serializer))\n"
+			   << "\t\treturn QtRestClient::GeneratedCodec::writeGeneric" << format
+			   << "(const_cast<" << data.name << "*>(this), serializer);\n\n";
+	}
+	source << "\t" << (isCbor ? "QCborMap" : "QJsonObject") << " map;\n";
+
+	for(const auto &propVar : qAsConst(data.properties)) {
+		const auto &attribs = propertyAttribs(propVar);
+		if(attribs.stored && !attribs.stored.value())
+			continue;
+
+		QString type;
+		QString getter;
+		if (nonstd::holds_alternative<RestBuilderXmlReader::Property>(propVar)) {
+			const auto &prop = nonstd::get<RestBuilderXmlReader::Property>(propVar);
+			type = prop.type;
+			getter = QStringLiteral("d->") + prop.key;
+		} else {
+			const auto &prop = nonstd::get<RestBuilderXmlReader::UserProperty>(propVar);
+			type = prop.metaType.value_or(prop.type);
+			getter = prop.read.name + QStringLiteral("()");
+		}
+
+		source << "\tmap.insert(QStringLiteral(\"" << propertyBasics(propVar).key << "\"), "
+			   << "QtRestClient::GeneratedCodec::write" << format << "<" << type << ">(" << getter << ", serializer));\n";
+	}
+
+	source << "\treturn map;\n"
+		   << "}\n";
+}
+
 void ObjectBuilder::writePrivateClass()
 {
 	QString name = data.name + QStringLiteral("Private");
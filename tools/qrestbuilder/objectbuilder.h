@@ -37,6 +37,7 @@ private:
 	void writeResetDeclarations();
 	void writeEqualsDeclaration();
 	void writeQHashDeclaration(bool asFriend);
+	void writeCodecDeclarations();
 	void writeSourceIncludes();
 	void writeAggregateConstructorDefinition();
 	void writeReadDefinitions();
@@ -44,6 +45,10 @@ private:
 	void writeResetDefinitions();
 	void writeEqualsDefinition();
 	void writeQHashDefinition();
+	void writeCodecDefinitions();
+	void writeCodecReader(const QString &format);
+	void writeCodecStreamReader();
+	void writeCodecWriter(const QString &format);
 	void writePrivateClass();
 	void writeDataClass();
 	void writeMemberDefinitions();